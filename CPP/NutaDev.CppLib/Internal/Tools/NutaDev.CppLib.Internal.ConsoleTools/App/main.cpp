@@ -21,8 +21,11 @@
 // SOFTWARE.
 
 #include <iostream>
+#include <string>
 #include <windows.h>
 
+#include "../Benchmarks/Benchmarks.hpp"
+
 namespace NutaDev
 {
     namespace CppLib
@@ -33,14 +36,113 @@ namespace NutaDev
             {
                 namespace App
                 {
+                    /// <summary>
+                    /// Prints available commands.
+                    /// </summary>
+                    void usage()
+                    {
+                        std::cout << "Usage: NutaDev.CppLib.Internal.ConsoleTools <command> [arguments]" << std::endl;
+                        std::cout << "Commands:" << std::endl;
+                        std::cout << "  heap-engines [count]    Compares heap engines of PriorityQueue." << std::endl;
+                        std::cout << "  multi-queue [count] [threads]" << std::endl;
+                        std::cout << "                          Compares PriorityQueue and MultiQueue under contention." << std::endl;
+                        std::cout << "  external-queue [MiB] [ratio] [directory]" << std::endl;
+                        std::cout << "                          Measures ExternalPriorityQueue spilling to disk." << std::endl;
+                        std::cout << "  copies [count] [bytes]  Counts payload copies per enqueue/dequeue round trip." << std::endl;
+                        std::cout << "  heap-statistics [count] [batch] [rounds]" << std::endl;
+                        std::cout << "                          Correlates pop latency with root list length after bulk inserts." << std::endl;
+                        std::cout << "  shortest-paths [millions of edges] [queries]" << std::endl;
+                        std::cout << "                          Compares Dijkstra engines, lazy deletion and A* on a road-like network." << std::endl;
+                        std::cout << "  bounded-queue [count] [pairs] [capacity]" << std::endl;
+                        std::cout << "                          Compares Queue and lock-free BoundedQueue between producers and consumers." << std::endl;
+                        std::cout << "  spsc-pipeline [count] [stages] [capacity]" << std::endl;
+                        std::cout << "                          Measures hop latency and throughput of tasks connected by Queue and SpscQueue." << std::endl;
+                        std::cout << "  lock-free-queue [count] [threads]" << std::endl;
+                        std::cout << "                          Compares Queue and LockFreeQueue from 1 to 64 threads." << std::endl;
+                        std::cout << "  lock-free-queue-stress [seconds] [producers] [consumers]" << std::endl;
+                        std::cout << "                          Verifies LockFreeQueue loses, duplicates and reorders no message." << std::endl;
+                        std::cout << "  chunked-queue [count]" << std::endl;
+                        std::cout << "                          Compares Queue and ChunkedQueue fill, drain and pipeline throughput." << std::endl;
+                        std::cout << "  allocators [count] [threads]" << std::endl;
+                        std::cout << "                          Compares list nodes from global new, PoolAllocator and an arena per request." << std::endl;
+                    }
+
                     /// <summary>
                     /// Entry point for application.
                     /// </summary>
-                    int main(int argc, int * argv[])
+                    int main(int argc, char * argv[])
                     {
-                        std::cout << "Hello World!\n";
+                        if (argc < 2)
+                        {
+                            usage();
+                            return 0;
+                        }
+
+                        std::string command = argv[1];
+
+                        if (command == "heap-engines")
+                        {
+                            return Benchmarks::HeapEngines(argc - 2, argv + 2);
+                        }
+
+                        if (command == "multi-queue")
+                        {
+                            return Benchmarks::MultiQueue(argc - 2, argv + 2);
+                        }
+
+                        if (command == "external-queue")
+                        {
+                            return Benchmarks::ExternalQueue(argc - 2, argv + 2);
+                        }
+
+                        if (command == "copies")
+                        {
+                            return Benchmarks::CopyCount(argc - 2, argv + 2);
+                        }
+
+                        if (command == "heap-statistics")
+                        {
+                            return Benchmarks::HeapStatistics(argc - 2, argv + 2);
+                        }
+
+                        if (command == "shortest-paths")
+                        {
+                            return Benchmarks::ShortestPaths(argc - 2, argv + 2);
+                        }
+
+                        if (command == "bounded-queue")
+                        {
+                            return Benchmarks::BoundedQueue(argc - 2, argv + 2);
+                        }
+
+                        if (command == "spsc-pipeline")
+                        {
+                            return Benchmarks::SpscPipeline(argc - 2, argv + 2);
+                        }
+
+                        if (command == "lock-free-queue")
+                        {
+                            return Benchmarks::LockFreeQueue(argc - 2, argv + 2);
+                        }
+
+                        if (command == "lock-free-queue-stress")
+                        {
+                            return Benchmarks::LockFreeQueueStress(argc - 2, argv + 2);
+                        }
+
+                        if (command == "chunked-queue")
+                        {
+                            return Benchmarks::ChunkedQueue(argc - 2, argv + 2);
+                        }
+
+                        if (command == "allocators")
+                        {
+                            return Benchmarks::Allocators(argc - 2, argv + 2);
+                        }
+
+                        usage();
 
-                        return 0;
+                        return 1;
                     }
                 }
             }
@@ -51,7 +153,7 @@ namespace NutaDev
 /// <summary>
 /// Image entry point.
 /// </summary>
-int main(int argc, int * argv[])
+int main(int argc, char * argv[])
 {
     return NutaDev::CppLib::Internal::ConsoleTools::App::main(argc, argv);
 }
@@ -0,0 +1,154 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "NutaDev.CppLib.Collections/Lists/DoubleLinkedList/DoubleLinkedList.hpp"
+#include "NutaDev.CppLib.Collections/Memory/ArenaAllocator.hpp"
+#include "NutaDev.CppLib.Collections/Memory/PoolAllocator.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Number of nodes built by one request.
+                        /// </summary>
+                        const unsigned NodesPerRequest = 256;
+
+                        /// <summary>
+                        /// Builds and drops a list per request on every thread.
+                        /// </summary>
+                        /// <param name="threads">Number of worker threads.</param>
+                        /// <param name="requests">Number of requests per thread.</param>
+                        /// <param name="request">Handles one request.</param>
+                        /// <returns>Millions of nodes per second.</returns>
+                        template<class TRequest>
+                        double Throughput(unsigned threads, std::size_t requests, TRequest request)
+                        {
+                            std::vector<std::thread> workers;
+                            Stopwatch stopwatch;
+
+                            for (unsigned t = 0; t < threads; ++t)
+                            {
+                                workers.emplace_back([requests, request]()
+                                {
+                                    for (std::size_t i = 0; i < requests; ++i)
+                                    {
+                                        request();
+                                    }
+                                });
+                            }
+
+                            for (std::thread & worker : workers)
+                            {
+                                worker.join();
+                            }
+
+                            return static_cast<double>(threads) * requests * NodesPerRequest / stopwatch.ElapsedMilliseconds() / 1000.0;
+                        }
+
+                        /// <summary>
+                        /// Fills a list and drops it.
+                        /// </summary>
+                        /// <param name="list">Empty list.</param>
+                        template<class TList>
+                        void Fill(TList & list)
+                        {
+                            for (unsigned i = 0; i < NodesPerRequest; ++i)
+                            {
+                                list.Add(static_cast<std::uint64_t>(i));
+                            }
+                        }
+                    }
+
+                    /// <summary>
+                    /// Compares DoubleLinkedList with global new, PoolAllocator and a MonotonicArena per request.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of requests per thread and maximum number of threads.</param>
+                    /// <returns>Exit code.</returns>
+                    int Allocators(int argc, char * argv[])
+                    {
+                        std::size_t requests = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 10000;
+                        unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : std::thread::hardware_concurrency();
+
+                        std::cout << "Requests building lists of " << NodesPerRequest << " nodes, " << requests << " requests per thread, Mnodes/s" << std::endl;
+                        std::cout << std::left << std::setw(10) << "threads"
+                            << std::right << std::setw(16) << "new"
+                            << std::setw(16) << "PoolAllocator"
+                            << std::setw(16) << "ArenaAllocator"
+                            << std::endl;
+
+                        for (unsigned threads = 1; threads <= (maxThreads > 0 ? maxThreads : 1); threads *= 2)
+                        {
+                            double global = Throughput(threads, requests, []()
+                            {
+                                Collections::Lists::DoubleLinkedList::DoubleLinkedList<std::uint64_t> list;
+                                Fill(list);
+                            });
+
+                            double pooled = Throughput(threads, requests, []()
+                            {
+                                Collections::Lists::DoubleLinkedList::DoubleLinkedList<std::uint64_t, Collections::Memory::PoolAllocator<std::uint64_t>> list;
+                                Fill(list);
+                            });
+
+                            double arena = Throughput(threads, requests, []()
+                            {
+                                Collections::Memory::MonotonicArena memory(NodesPerRequest * 64);
+                                Collections::Lists::DoubleLinkedList::DoubleLinkedList<std::uint64_t, Collections::Memory::ArenaAllocator<std::uint64_t>> list{Collections::Memory::ArenaAllocator<std::uint64_t>(memory)};
+                                Fill(list);
+                            });
+
+                            std::cout << std::left << std::setw(10) << threads
+                                << std::right << std::fixed << std::setprecision(2)
+                                << std::setw(16) << global
+                                << std::setw(16) << pooled
+                                << std::setw(16) << arena
+                                << std::endl;
+                        }
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,140 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_INTERNAL_CONSOLETOOLS_BENCHMARKS_BENCHMARKS_HPP
+#define NUTADEV_CPPLIB_INTERNAL_CONSOLETOOLS_BENCHMARKS_BENCHMARKS_HPP
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    /// <summary>
+                    /// Compares heap engines on push/pop, decrease-key, merge and load heavy traces.
+                    /// Fails when FibonacciHeap allocates in EraseMinimum, Pop or Erase.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of elements.</param>
+                    /// <returns>Exit code.</returns>
+                    int HeapEngines(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Compares throughput of PriorityQueue and MultiQueue for growing number of threads.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of operations per thread and maximum number of threads.</param>
+                    /// <returns>Exit code.</returns>
+                    int MultiQueue(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Measures sustained throughput of ExternalPriorityQueue holding several times its memory limit.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional memory limit in MiB, ratio of data to the limit and spill directory.</param>
+                    /// <returns>Exit code.</returns>
+                    int ExternalQueue(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Counts copies and moves of the payload per enqueue/dequeue round trip.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of round trips and payload size in bytes.</param>
+                    /// <returns>Exit code.</returns>
+                    int CopyCount(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Bulk inserts into a populated PriorityQueue and correlates pop latency with root list length.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of resident elements, bulk insert size and number of rounds.</param>
+                    /// <returns>Exit code.</returns>
+                    int HeapStatistics(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Compares Dijkstra with decrease-key on each heap engine, lazy deletion Dijkstra and A*
+                    /// on a road-like network.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of edges in millions and number of queries.</param>
+                    /// <returns>Exit code.</returns>
+                    int ShortestPaths(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Compares message throughput of Queue and BoundedQueue for growing number of producer and consumer pairs.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of messages per producer, maximum number of pairs and capacity.</param>
+                    /// <returns>Exit code.</returns>
+                    int BoundedQueue(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Measures hop latency and throughput of a pipeline of tasks connected by Queue and SpscQueue.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of items, number of stages and capacity of queues.</param>
+                    /// <returns>Exit code.</returns>
+                    int SpscPipeline(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Compares throughput of Queue and LockFreeQueue from 1 to 64 threads.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of operations per thread and maximum number of threads.</param>
+                    /// <returns>Exit code.</returns>
+                    int LockFreeQueue(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Runs producers and consumers on LockFreeQueue and verifies that no message is lost,
+                    /// duplicated or reordered within its producer.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional duration in seconds, number of producers and number of consumers.</param>
+                    /// <returns>Exit code, 0 if the queue passed.</returns>
+                    int LockFreeQueueStress(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Compares Queue backed by DoubleLinkedList with ChunkedQueue backed by UnrolledList.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of messages.</param>
+                    /// <returns>Exit code.</returns>
+                    int ChunkedQueue(int argc, char * argv[]);
+
+                    /// <summary>
+                    /// Compares DoubleLinkedList with global new, PoolAllocator and a MonotonicArena per request.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of requests per thread and maximum number of threads.</param>
+                    /// <returns>Exit code.</returns>
+                    int Allocators(int argc, char * argv[]);
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,136 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "NutaDev.CppLib.Collections/Queues/BoundedQueue.hpp"
+#include "NutaDev.CppLib.Collections/Queues/Queue.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Moves messages from producers to consumers, failed calls are retried.
+                        /// </summary>
+                        /// <param name="pairs">Number of producers and number of consumers.</param>
+                        /// <param name="messages">Number of messages sent by each producer.</param>
+                        /// <param name="queue">Queue with TryEnqueue and TryDequeue.</param>
+                        /// <returns>Millions of messages per second.</returns>
+                        template<class TQueue>
+                        double Throughput(unsigned pairs, std::size_t messages, TQueue & queue)
+                        {
+                            std::vector<std::thread> workers;
+                            Stopwatch stopwatch;
+
+                            for (unsigned t = 0; t < pairs; ++t)
+                            {
+                                workers.emplace_back([&queue, messages]()
+                                {
+                                    for (std::size_t i = 0; i < messages; ++i)
+                                    {
+                                        while (!queue.TryEnqueue(static_cast<std::uint64_t>(i)))
+                                        {
+                                            std::this_thread::yield();
+                                        }
+                                    }
+                                });
+
+                                workers.emplace_back([&queue, messages]()
+                                {
+                                    std::uint64_t value = 0;
+
+                                    for (std::size_t i = 0; i < messages; ++i)
+                                    {
+                                        while (!queue.TryDequeue(value))
+                                        {
+                                            std::this_thread::yield();
+                                        }
+                                    }
+                                });
+                            }
+
+                            for (std::thread & worker : workers)
+                            {
+                                worker.join();
+                            }
+
+                            return static_cast<double>(pairs) * messages / stopwatch.ElapsedMilliseconds() / 1000.0;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Compares message throughput of Queue and BoundedQueue for growing number of producer and consumer pairs.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of messages per producer, maximum number of pairs and capacity.</param>
+                    /// <returns>Exit code.</returns>
+                    int BoundedQueue(int argc, char * argv[])
+                    {
+                        std::size_t messages = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 1000000;
+                        unsigned maxPairs = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : std::thread::hardware_concurrency() / 2;
+                        unsigned capacity = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 1024;
+
+                        std::cout << "Producer/consumer queues, " << messages << " messages per producer, Mmsg/s" << std::endl;
+                        std::cout << std::left << std::setw(10) << "pairs"
+                            << std::right << std::setw(16) << "Queue"
+                            << std::setw(16) << "BoundedQueue"
+                            << std::endl;
+
+                        for (unsigned pairs = 1; pairs <= (maxPairs > 0 ? maxPairs : 1); pairs *= 2)
+                        {
+                            Collections::Queues::Queue<std::uint64_t> locked;
+                            Collections::Queues::BoundedQueue<std::uint64_t> bounded(capacity);
+
+                            double lockedThroughput = Throughput(pairs, messages, locked);
+                            double boundedThroughput = Throughput(pairs, messages, bounded);
+
+                            std::cout << std::left << std::setw(10) << pairs
+                                << std::right << std::fixed << std::setprecision(2)
+                                << std::setw(16) << lockedThroughput
+                                << std::setw(16) << boundedThroughput
+                                << std::endl;
+                        }
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,147 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "NutaDev.CppLib.Collections/Queues/Queue.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Throughput of one queue, millions of operations per second.
+                        /// </summary>
+                        struct Result
+                        {
+                            double Fill;
+
+                            double Drain;
+
+                            double Pipeline;
+                        };
+
+                        /// <summary>
+                        /// Fills the queue and drains it on one thread, then passes messages from a producer to a consumer.
+                        /// </summary>
+                        /// <param name="count">Number of messages.</param>
+                        /// <returns>The result.</returns>
+                        template<class TQueue>
+                        Result Measure(std::size_t count)
+                        {
+                            Result result;
+                            TQueue queue;
+                            std::uint64_t value = 0;
+
+                            Stopwatch fill;
+                            for (std::size_t i = 0; i < count; ++i)
+                            {
+                                queue.Emplace(static_cast<std::uint64_t>(i));
+                            }
+                            result.Fill = count / fill.ElapsedMilliseconds() / 1000.0;
+
+                            Stopwatch drain;
+                            for (std::size_t i = 0; i < count; ++i)
+                            {
+                                queue.Poll(value);
+                            }
+                            result.Drain = count / drain.ElapsedMilliseconds() / 1000.0;
+
+                            Stopwatch pipeline;
+                            std::thread producer([&queue, count]()
+                            {
+                                for (std::size_t i = 0; i < count; ++i)
+                                {
+                                    queue.Emplace(static_cast<std::uint64_t>(i));
+                                }
+
+                                queue.Close();
+                            });
+
+                            while (queue.Dequeue(value) == Collections::Queues::Dequeued)
+                            {
+                            }
+
+                            producer.join();
+                            result.Pipeline = count / pipeline.ElapsedMilliseconds() / 1000.0;
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Prints a row of the table.
+                        /// </summary>
+                        /// <param name="name">Name of the queue.</param>
+                        /// <param name="result">Measured throughput.</param>
+                        void Print(const char * name, const Result & result)
+                        {
+                            std::cout << std::left << std::setw(16) << name
+                                << std::right << std::fixed << std::setprecision(2)
+                                << std::setw(12) << result.Fill
+                                << std::setw(12) << result.Drain
+                                << std::setw(12) << result.Pipeline
+                                << std::endl;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Compares Queue backed by DoubleLinkedList with ChunkedQueue backed by UnrolledList.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of messages.</param>
+                    /// <returns>Exit code.</returns>
+                    int ChunkedQueue(int argc, char * argv[])
+                    {
+                        std::size_t count = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 10000000;
+
+                        std::cout << "Queue backends, " << count << " messages, Mops/s" << std::endl;
+                        std::cout << std::left << std::setw(16) << "queue"
+                            << std::right << std::setw(12) << "fill"
+                            << std::setw(12) << "drain"
+                            << std::setw(12) << "pipeline"
+                            << std::endl;
+
+                        Print("Queue", Measure<Collections::Queues::Queue<std::uint64_t>>(count));
+                        Print("ChunkedQueue", Measure<Collections::Queues::ChunkedQueue<std::uint64_t>>(count));
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,245 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "NutaDev.CppLib.Collections/Heaps/HeapEngines.hpp"
+#include "NutaDev.CppLib.Collections/Queues/PriorityQueue/PriorityQueue.hpp"
+#include "NutaDev.CppLib.Collections/Queues/Queue.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Payload owning a buffer that counts how often it is copied and moved.
+                        /// </summary>
+                        class Payload
+                        {
+                        public:
+                            static std::size_t Copies;
+                            static std::size_t Moves;
+
+                            explicit Payload(std::size_t size = 0)
+                                : _data(size)
+                            {
+                            }
+
+                            Payload(const Payload & other)
+                                : _data(other._data)
+                            {
+                                ++Copies;
+                            }
+
+                            Payload(Payload && other) noexcept
+                                : _data(std::move(other._data))
+                            {
+                                ++Moves;
+                            }
+
+                            Payload & operator=(const Payload & other)
+                            {
+                                _data = other._data;
+                                ++Copies;
+                                return *this;
+                            }
+
+                            Payload & operator=(Payload && other) noexcept
+                            {
+                                _data = std::move(other._data);
+                                ++Moves;
+                                return *this;
+                            }
+
+                            static void Reset()
+                            {
+                                Copies = 0;
+                                Moves = 0;
+                            }
+
+                        private:
+                            std::vector<char> _data;
+                        };
+
+                        std::size_t Payload::Copies = 0;
+                        std::size_t Payload::Moves = 0;
+
+                        /// <summary>
+                        /// How the payload is handed to the queue.
+                        /// </summary>
+                        enum class Mode
+                        {
+                            Copy,
+                            Move,
+                            Emplace
+                        };
+
+                        /// <summary>
+                        /// Enqueues one payload into the priority queue.
+                        /// </summary>
+                        template<class TEngine>
+                        void Put(Collections::Queues::PriorityQueue::PriorityQueue<Payload, TEngine> & queue, Mode mode, std::size_t size, unsigned int priority)
+                        {
+                            if (mode == Mode::Emplace)
+                            {
+                                queue.Emplace(priority, size);
+                                return;
+                            }
+
+                            Payload payload(size);
+
+                            if (mode == Mode::Move)
+                            {
+                                queue.TryEnqueue(std::move(payload), priority);
+                            }
+                            else
+                            {
+                                queue.TryEnqueue(payload, priority);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Enqueues one payload into the queue.
+                        /// </summary>
+                        void Put(Collections::Queues::Queue<Payload> & queue, Mode mode, std::size_t size, unsigned int)
+                        {
+                            if (mode == Mode::Emplace)
+                            {
+                                queue.Emplace(size);
+                                return;
+                            }
+
+                            Payload payload(size);
+
+                            if (mode == Mode::Move)
+                            {
+                                queue.TryEnqueue(std::move(payload));
+                            }
+                            else
+                            {
+                                queue.TryEnqueue(payload);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Fills the queue, drains it and prints copies and moves per round trip.
+                        /// </summary>
+                        /// <param name="name">Row name.</param>
+                        /// <param name="mode">How the payload is handed to the queue.</param>
+                        /// <param name="count">Number of round trips.</param>
+                        /// <param name="size">Payload size in bytes.</param>
+                        template<class TQueue>
+                        void Run(const char * name, Mode mode, std::size_t count, std::size_t size)
+                        {
+                            static const char * modes[] = { "copy", "move", "emplace" };
+
+                            TQueue queue;
+                            Payload payload;
+
+                            Payload::Reset();
+
+                            Stopwatch stopwatch;
+
+                            for (std::size_t i = 0; i < count; ++i)
+                            {
+                                Put(queue, mode, size, static_cast<unsigned int>(i * 2654435761u % 1024));
+                            }
+
+                            while (queue.TryDequeue(payload))
+                            {
+                            }
+
+                            double elapsed = stopwatch.ElapsedMilliseconds();
+
+                            std::cout << std::left << std::setw(16) << name
+                                << std::setw(10) << modes[static_cast<int>(mode)]
+                                << std::right << std::fixed << std::setprecision(2)
+                                << std::setw(10) << static_cast<double>(Payload::Copies) / count
+                                << std::setw(10) << static_cast<double>(Payload::Moves) / count
+                                << std::setprecision(1)
+                                << std::setw(12) << elapsed
+                                << std::endl;
+                        }
+
+                        /// <summary>
+                        /// Runs all modes for the queue.
+                        /// </summary>
+                        template<class TQueue>
+                        void RunModes(const char * name, std::size_t count, std::size_t size)
+                        {
+                            Run<TQueue>(name, Mode::Copy, count, size);
+                            Run<TQueue>(name, Mode::Move, count, size);
+                            Run<TQueue>(name, Mode::Emplace, count, size);
+                        }
+                    }
+
+                    /// <summary>
+                    /// Counts copies and moves of the payload per enqueue/dequeue round trip.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of round trips and payload size in bytes.</param>
+                    /// <returns>Exit code.</returns>
+                    int CopyCount(int argc, char * argv[])
+                    {
+                        std::size_t count = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : (1u << 16);
+                        std::size_t size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+
+                        if (count == 0)
+                        {
+                            count = 1;
+                        }
+
+                        std::cout << "Copies per round trip, " << count << " payloads of " << size << " bytes" << std::endl;
+                        std::cout << std::left << std::setw(16) << "queue"
+                            << std::setw(10) << "mode"
+                            << std::right << std::setw(10) << "copies"
+                            << std::setw(10) << "moves"
+                            << std::setw(12) << "ms"
+                            << std::endl;
+
+                        RunModes<Collections::Queues::PriorityQueue::PriorityQueue<Payload, Collections::Heaps::FibonacciHeapEngine>>("fibonacci", count, size);
+                        RunModes<Collections::Queues::PriorityQueue::PriorityQueue<Payload, Collections::Heaps::PairingHeapEngine>>("pairing", count, size);
+                        RunModes<Collections::Queues::PriorityQueue::PriorityQueue<Payload, Collections::Heaps::QuaternaryHeapEngine>>("4-ary", count, size);
+                        RunModes<Collections::Queues::Queue<Payload>>("queue", count, size);
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,140 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "NutaDev.CppLib.Collections/Queues/PriorityQueue/ExternalPriorityQueue.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Queued item of a typical size.
+                        /// </summary>
+                        struct Job
+                        {
+                            /// <summary>
+                            /// Identifier of the job.
+                            /// </summary>
+                            std::uint64_t Id;
+
+                            /// <summary>
+                            /// Payload of the job.
+                            /// </summary>
+                            char Payload[56];
+                        };
+
+                        /// <summary>
+                        /// Prints throughput of a phase.
+                        /// </summary>
+                        /// <param name="phase">Name of the phase.</param>
+                        /// <param name="items">Number of processed items.</param>
+                        /// <param name="milliseconds">Duration of the phase.</param>
+                        void Report(const char * phase, std::size_t items, double milliseconds)
+                        {
+                            std::cout << std::left << std::setw(12) << phase
+                                << std::right << std::fixed << std::setprecision(2)
+                                << std::setw(14) << items / milliseconds / 1000.0
+                                << std::setw(14) << items * sizeof(Job) / milliseconds / 1000.0
+                                << std::endl;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Measures sustained throughput of ExternalPriorityQueue holding several times its memory limit.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional memory limit in MiB, ratio of data to the limit and spill directory.</param>
+                    /// <returns>Exit code.</returns>
+                    int ExternalQueue(int argc, char * argv[])
+                    {
+                        std::size_t memoryLimit = (argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 64) * 1024 * 1024;
+                        std::size_t ratio = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10;
+                        std::string directory = argc > 2 ? argv[2] : std::string();
+
+                        std::size_t count = memoryLimit * ratio / sizeof(Job);
+                        std::mt19937 random(7);
+                        Job job = Job();
+
+                        Collections::Queues::PriorityQueue::ExternalPriorityQueue<Job> queue(directory, memoryLimit);
+
+                        std::cout << "External priority queue, " << count << " jobs of " << sizeof(Job) << " bytes, "
+                            << ratio << "x the memory limit of " << memoryLimit / (1024 * 1024) << " MiB" << std::endl;
+                        std::cout << std::left << std::setw(12) << "phase"
+                            << std::right << std::setw(14) << "Mitems/s"
+                            << std::setw(14) << "MB/s"
+                            << std::endl;
+
+                        Stopwatch stopwatch;
+
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            job.Id = i;
+                            queue.TryEnqueue(job, static_cast<unsigned>(random()));
+                        }
+
+                        Report("fill", count, stopwatch.ElapsedMilliseconds());
+                        stopwatch.Restart();
+
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            queue.TryDequeue(job);
+
+                            job.Id = count + i;
+                            queue.TryEnqueue(job, static_cast<unsigned>(random()));
+                        }
+
+                        Report("sustained", 2 * count, stopwatch.ElapsedMilliseconds());
+                        stopwatch.Restart();
+
+                        while (queue.TryDequeue(job))
+                        {
+                        }
+
+                        Report("drain", count, stopwatch.ElapsedMilliseconds());
+
+                        std::cout << "Items written to spill files: " << queue.SpilledCount() << std::endl;
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
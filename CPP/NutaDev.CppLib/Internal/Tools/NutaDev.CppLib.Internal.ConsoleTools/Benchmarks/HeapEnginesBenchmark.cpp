@@ -0,0 +1,285 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "NutaDev.CppLib.Collections/Heaps/HeapEngines.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Fills the heap, then alternates pops with pushes and drains it.
+                        /// </summary>
+                        /// <param name="count">Number of elements.</param>
+                        /// <returns>Elapsed milliseconds.</returns>
+                        template<class THeap>
+                        double PushPopTrace(std::size_t count)
+                        {
+                            std::mt19937 random(1);
+                            Stopwatch stopwatch;
+                            THeap heap;
+
+                            for (std::size_t i = 0; i < count; ++i)
+                            {
+                                heap.Push(random());
+                            }
+
+                            for (std::size_t i = 0; i < count * 4; ++i)
+                            {
+                                std::uint32_t top = heap.EraseMinimum();
+                                heap.Push(top + random() % 1024);
+                            }
+
+                            while (!heap.Empty())
+                            {
+                                heap.EraseMinimum();
+                            }
+
+                            return stopwatch.ElapsedMilliseconds();
+                        }
+
+                        /// <summary>
+                        /// Fills the heap, decreases random keys and drains it.
+                        /// </summary>
+                        /// <param name="count">Number of elements.</param>
+                        /// <returns>Elapsed milliseconds.</returns>
+                        template<class THeap>
+                        double DecreaseKeyTrace(std::size_t count)
+                        {
+                            std::mt19937 random(2);
+                            Stopwatch stopwatch;
+                            THeap heap;
+                            std::vector<typename THeap::Handle> handles;
+
+                            handles.reserve(count);
+
+                            for (std::size_t i = 0; i < count; ++i)
+                            {
+                                handles.push_back(heap.Push(random() | 0x80000000u));
+                            }
+
+                            for (std::size_t i = 0; i < count * 4; ++i)
+                            {
+                                typename THeap::Handle handle = handles[random() % count];
+                                std::uint32_t key = heap.Get(handle);
+
+                                heap.DecreaseKey(handle, key - key / 16);
+                            }
+
+                            while (!heap.Empty())
+                            {
+                                heap.EraseMinimum();
+                            }
+
+                            return stopwatch.ElapsedMilliseconds();
+                        }
+
+                        /// <summary>
+                        /// Builds many small heaps, joins them pairwise into one and drains it.
+                        /// </summary>
+                        /// <param name="count">Number of elements.</param>
+                        /// <returns>Elapsed milliseconds.</returns>
+                        template<class THeap>
+                        double MergeTrace(std::size_t count)
+                        {
+                            const std::size_t heapSize = 64;
+
+                            std::mt19937 random(3);
+                            Stopwatch stopwatch;
+                            std::vector<THeap> heaps(count / heapSize + 1);
+
+                            for (std::size_t i = 0; i < count; ++i)
+                            {
+                                heaps[i / heapSize].Push(random());
+                            }
+
+                            for (std::size_t step = 1; step < heaps.size(); step *= 2)
+                            {
+                                for (std::size_t i = 0; i + step < heaps.size(); i += step * 2)
+                                {
+                                    heaps[i].Join(heaps[i + step]);
+                                }
+                            }
+
+                            while (!heaps[0].Empty())
+                            {
+                                heaps[0].EraseMinimum();
+                            }
+
+                            return stopwatch.ElapsedMilliseconds();
+                        }
+
+                        /// <summary>
+                        /// Loads the heap from a prepared backlog and pops the minimum once.
+                        /// </summary>
+                        /// <param name="count">Number of elements.</param>
+                        /// <param name="bulk">Whether to load with PushRange instead of one Push per key.</param>
+                        /// <returns>Elapsed milliseconds.</returns>
+                        template<class THeap>
+                        double LoadTrace(std::size_t count, bool bulk)
+                        {
+                            std::mt19937 random(4);
+                            std::vector<std::uint32_t> backlog(count);
+
+                            for (std::uint32_t & key : backlog)
+                            {
+                                key = random();
+                            }
+
+                            Stopwatch stopwatch;
+                            THeap heap;
+
+                            if (bulk)
+                            {
+                                heap.PushRange(backlog.begin(), backlog.end());
+                            }
+                            else
+                            {
+                                for (std::uint32_t key : backlog)
+                                {
+                                    heap.Push(key);
+                                }
+                            }
+
+                            heap.EraseMinimum();
+
+                            return stopwatch.ElapsedMilliseconds();
+                        }
+
+                        /// <summary>
+                        /// Fills the heap, then drains it with EraseMinimum, Pop and Erase and checks that none of them allocated.
+                        /// </summary>
+                        /// <param name="count">Number of elements.</param>
+                        /// <returns>True if the allocation count stayed the same while draining.</returns>
+                        template<class THeap>
+                        bool PopsWithoutAllocation(std::size_t count)
+                        {
+                            std::mt19937 random(5);
+                            THeap heap;
+                            std::vector<typename THeap::Handle> handles;
+
+                            handles.reserve(count);
+
+                            for (std::size_t i = 0; i < count; ++i)
+                            {
+                                handles.push_back(heap.Push(random() | 0x80000000u));
+                            }
+
+                            std::size_t allocations = heap.AllocationCount();
+
+                            for (std::size_t i = 0; i < count / 4; ++i)
+                            {
+                                heap.Erase(handles[i]);
+                            }
+
+                            for (std::size_t i = 0; !heap.Empty(); ++i)
+                            {
+                                if (i % 2 == 0)
+                                {
+                                    heap.EraseMinimum();
+                                }
+                                else
+                                {
+                                    heap.Pop();
+                                }
+                            }
+
+                            return heap.AllocationCount() == allocations;
+                        }
+
+                        /// <summary>
+                        /// Runs all traces for the engine and prints one row.
+                        /// </summary>
+                        /// <param name="name">Engine name.</param>
+                        /// <param name="count">Number of elements.</param>
+                        template<class TEngine>
+                        void Run(const char * name, std::size_t count)
+                        {
+                            typedef typename TEngine::template Heap<std::uint32_t> Heap;
+
+                            std::cout << std::left << std::setw(12) << name
+                                << std::right << std::fixed << std::setprecision(1)
+                                << std::setw(14) << PushPopTrace<Heap>(count)
+                                << std::setw(14) << DecreaseKeyTrace<Heap>(count)
+                                << std::setw(14) << MergeTrace<Heap>(count)
+                                << std::setw(14) << LoadTrace<Heap>(count, false)
+                                << std::setw(14) << LoadTrace<Heap>(count, true)
+                                << std::endl;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Compares heap engines on push/pop, decrease-key, merge and load heavy traces.
+                    /// Fails when FibonacciHeap allocates in EraseMinimum, Pop or Erase.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of elements.</param>
+                    /// <returns>Exit code.</returns>
+                    int HeapEngines(int argc, char * argv[])
+                    {
+                        std::size_t count = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : (1u << 20);
+
+                        std::cout << "Heap engines, " << count << " elements, times in ms" << std::endl;
+                        std::cout << std::left << std::setw(12) << "engine"
+                            << std::right << std::setw(14) << "push/pop"
+                            << std::setw(14) << "decrease-key"
+                            << std::setw(14) << "merge"
+                            << std::setw(14) << "load"
+                            << std::setw(14) << "bulk load"
+                            << std::endl;
+
+                        Run<Collections::Heaps::FibonacciHeapEngine>("fibonacci", count);
+                        Run<Collections::Heaps::PairingHeapEngine>("pairing", count);
+                        Run<Collections::Heaps::QuaternaryHeapEngine>("4-ary", count);
+
+                        if (!PopsWithoutAllocation<Collections::Heaps::FibonacciHeapEngine::Heap<std::uint32_t>>(count)
+                            || !PopsWithoutAllocation<Collections::Heaps::InstrumentedFibonacciHeapEngine<>::Heap<std::uint32_t>>(count))
+                        {
+                            std::cout << "FibonacciHeap allocated while popping." << std::endl;
+                            return 1;
+                        }
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,173 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "NutaDev.CppLib.Collections/Heaps/HeapEngines.hpp"
+#include "NutaDev.CppLib.Collections/Queues/PriorityQueue/LockStatistics.hpp"
+#include "NutaDev.CppLib.Collections/Queues/PriorityQueue/PriorityQueue.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Latency of one pop with the root list length its consolidation has seen.
+                        /// </summary>
+                        struct PopSample
+                        {
+                            double Microseconds;
+                            unsigned Roots;
+                        };
+
+                        /// <summary>
+                        /// Gets mean root list length of the samples.
+                        /// </summary>
+                        /// <param name="first">Beginning of the samples.</param>
+                        /// <param name="last">End of the samples.</param>
+                        /// <returns>The mean.</returns>
+                        double MeanRoots(std::vector<PopSample>::const_iterator first, std::vector<PopSample>::const_iterator last)
+                        {
+                            double sum = 0;
+                            std::ptrdiff_t count = last - first;
+
+                            for (; first != last; ++first)
+                            {
+                                sum += first->Roots;
+                            }
+
+                            return count > 0 ? sum / count : 0;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Bulk inserts into a populated PriorityQueue and correlates pop latency with root list length.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of resident elements, bulk insert size and number of rounds.</param>
+                    /// <returns>Exit code.</returns>
+                    int HeapStatistics(int argc, char * argv[])
+                    {
+                        typedef Collections::Queues::PriorityQueue::PriorityQueueItem<std::uint32_t> Item;
+                        typedef Collections::Queues::PriorityQueue::PriorityQueue<std::uint32_t,
+                            Collections::Heaps::InstrumentedFibonacciHeapEngine<>,
+                            Collections::Queues::PriorityQueue::LockTimingStatistics> Queue;
+
+                        std::size_t count = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : (1u << 16);
+                        std::size_t batch = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : (1u << 14);
+                        std::size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16;
+
+                        std::mt19937 random(5);
+                        Queue queue;
+                        std::vector<Item> backlog;
+                        std::vector<PopSample> samples;
+                        std::uint32_t value;
+
+                        samples.reserve(batch * rounds);
+
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            queue.Emplace(random() % 1000000, static_cast<std::uint32_t>(i));
+                        }
+
+                        for (std::size_t round = 0; round < rounds; ++round)
+                        {
+                            backlog.clear();
+
+                            for (std::size_t i = 0; i < batch; ++i)
+                            {
+                                backlog.push_back(Item(static_cast<std::uint32_t>(i), random() % 1000000));
+                            }
+
+                            queue.EnqueueRange(backlog.begin(), backlog.end());
+
+                            for (std::size_t i = 0; i < batch; ++i)
+                            {
+                                Stopwatch stopwatch;
+
+                                queue.TryDequeue(value);
+
+                                PopSample sample;
+                                sample.Microseconds = stopwatch.ElapsedMilliseconds() * 1000;
+                                sample.Roots = queue.HeapStatistics().LastMergeRoots;
+
+                                samples.push_back(sample);
+                            }
+                        }
+
+                        if (samples.empty())
+                        {
+                            return 0;
+                        }
+
+                        std::sort(samples.begin(), samples.end(), [](const PopSample & left, const PopSample & right)
+                        {
+                            return left.Microseconds < right.Microseconds;
+                        });
+
+                        std::size_t tail = samples.size() - samples.size() / 100;
+
+                        Collections::Heaps::HeapStatisticsSnapshot heap = queue.HeapStatistics();
+                        Collections::Queues::PriorityQueue::LockStatisticsSnapshot lock = queue.LockStatistics();
+
+                        std::cout << "Heap statistics, " << count << " resident elements, " << rounds << " bulk inserts of " << batch << std::endl;
+                        std::cout << std::fixed << std::setprecision(2);
+                        std::cout << "pop latency us   p50 " << samples[samples.size() / 2].Microseconds
+                            << "  p99 " << samples[tail < samples.size() ? tail : samples.size() - 1].Microseconds
+                            << "  max " << samples.back().Microseconds << std::endl;
+                        std::cout << "mean roots       all pops " << MeanRoots(samples.begin(), samples.end())
+                            << "  slowest 1% " << MeanRoots(samples.begin() + tail, samples.end()) << std::endl;
+                        std::cout << "consolidations   " << heap.Merges
+                            << "  links " << heap.Links
+                            << "  max roots " << heap.MaximumMergeRoots
+                            << "  max links " << heap.MaximumMergeLinks
+                            << "  max rank " << heap.MaximumRank << std::endl;
+                        std::cout << "lock             " << lock.Acquisitions << " acquisitions"
+                            << "  max hold us " << lock.MaximumHold.count() / 1000.0
+                            << "  mean hold us " << (lock.Acquisitions > 0 ? lock.TotalHold.count() / 1000.0 / lock.Acquisitions : 0.0)
+                            << std::endl;
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,264 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "NutaDev.CppLib.Collections/Queues/LockFreeQueue.hpp"
+#include "NutaDev.CppLib.Collections/Queues/Queue.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Message of the stress test.
+                        /// </summary>
+                        struct Message
+                        {
+                            /// <summary>
+                            /// Index of the producer.
+                            /// </summary>
+                            unsigned Producer;
+
+                            /// <summary>
+                            /// Sequence number within the producer.
+                            /// </summary>
+                            std::uint64_t Sequence;
+                        };
+
+                        /// <summary>
+                        /// Number of messages in the queue above which producers of the stress test wait.
+                        /// </summary>
+                        const std::int64_t MaximumBacklog = 1 << 20;
+
+                        /// <summary>
+                        /// Runs threads that alternate enqueue and dequeue, failed calls are retried.
+                        /// </summary>
+                        /// <param name="threads">Number of threads.</param>
+                        /// <param name="operations">Number of enqueue and dequeue pairs per thread.</param>
+                        /// <param name="queue">Queue with TryEnqueue and TryDequeue.</param>
+                        /// <returns>Millions of operations per second.</returns>
+                        template<class TQueue>
+                        double Throughput(unsigned threads, std::size_t operations, TQueue & queue)
+                        {
+                            std::vector<std::thread> workers;
+                            Stopwatch stopwatch;
+
+                            for (unsigned t = 0; t < threads; ++t)
+                            {
+                                workers.emplace_back([&queue, operations]()
+                                {
+                                    std::uint64_t value = 0;
+
+                                    for (std::size_t i = 0; i < operations; ++i)
+                                    {
+                                        while (!queue.TryEnqueue(static_cast<std::uint64_t>(i)))
+                                        {
+                                            std::this_thread::yield();
+                                        }
+
+                                        while (!queue.TryDequeue(value))
+                                        {
+                                            std::this_thread::yield();
+                                        }
+                                    }
+                                });
+                            }
+
+                            for (std::thread & worker : workers)
+                            {
+                                worker.join();
+                            }
+
+                            return 2.0 * threads * operations / stopwatch.ElapsedMilliseconds() / 1000.0;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Compares throughput of Queue and LockFreeQueue from 1 to 64 threads.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of operations per thread and maximum number of threads.</param>
+                    /// <returns>Exit code.</returns>
+                    int LockFreeQueue(int argc, char * argv[])
+                    {
+                        std::size_t operations = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 200000;
+                        unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 64;
+
+                        std::cout << "Unbounded queues, " << operations << " operation pairs per thread, Mops/s" << std::endl;
+                        std::cout << std::left << std::setw(10) << "threads"
+                            << std::right << std::setw(16) << "Queue"
+                            << std::setw(16) << "LockFreeQueue"
+                            << std::endl;
+
+                        for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+                        {
+                            Collections::Queues::Queue<std::uint64_t> locked;
+                            Collections::Queues::LockFreeQueue<std::uint64_t> lockFree;
+
+                            double lockedThroughput = Throughput(threads, operations, locked);
+                            double lockFreeThroughput = Throughput(threads, operations, lockFree);
+
+                            std::cout << std::left << std::setw(10) << threads
+                                << std::right << std::fixed << std::setprecision(2)
+                                << std::setw(16) << lockedThroughput
+                                << std::setw(16) << lockFreeThroughput
+                                << std::endl;
+                        }
+
+                        return 0;
+                    }
+
+                    /// <summary>
+                    /// Runs producers and consumers on LockFreeQueue and verifies that no message is lost,
+                    /// duplicated or reordered within its producer.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional duration in seconds, number of producers and number of consumers.</param>
+                    /// <returns>Exit code, 0 if the queue passed.</returns>
+                    int LockFreeQueueStress(int argc, char * argv[])
+                    {
+                        unsigned seconds = argc > 0 ? static_cast<unsigned>(std::strtoul(argv[0], nullptr, 10)) : 10;
+                        unsigned producers = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 4;
+                        unsigned consumers = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 4;
+
+                        Collections::Queues::LockFreeQueue<Message> queue;
+                        std::atomic<bool> producing(true);
+                        std::atomic<unsigned> runningProducers(producers);
+                        std::atomic<bool> failed(false);
+                        std::atomic<std::int64_t> backlog(0);
+                        std::vector<std::uint64_t> sent(producers, 0);
+                        std::vector<std::vector<std::uint64_t>> received(consumers, std::vector<std::uint64_t>(producers, 0));
+                        std::vector<std::thread> workers;
+
+                        for (unsigned p = 0; p < producers; ++p)
+                        {
+                            workers.emplace_back([&, p]()
+                            {
+                                std::uint64_t sequence = 0;
+
+                                while (producing.load(std::memory_order_relaxed))
+                                {
+                                    // Keeps memory bounded when consumers fall behind.
+                                    if (backlog.load(std::memory_order_relaxed) > MaximumBacklog)
+                                    {
+                                        std::this_thread::yield();
+                                        continue;
+                                    }
+
+                                    queue.TryEmplace(Message { p, sequence++ });
+                                    backlog.fetch_add(1, std::memory_order_relaxed);
+                                }
+
+                                sent[p] = sequence;
+                                runningProducers--;
+                            });
+                        }
+
+                        for (unsigned c = 0; c < consumers; ++c)
+                        {
+                            workers.emplace_back([&, c]()
+                            {
+                                std::vector<std::uint64_t> next(producers, 0);
+                                Message message;
+
+                                for (;;)
+                                {
+                                    if (queue.TryDequeue(message))
+                                    {
+                                        backlog.fetch_sub(1, std::memory_order_relaxed);
+
+                                        // Messages of a producer leave the queue in order, each consumer sees an increasing subsequence.
+                                        if (message.Producer >= producers || message.Sequence < next[message.Producer])
+                                        {
+                                            failed = true;
+                                        }
+                                        else
+                                        {
+                                            next[message.Producer] = message.Sequence + 1;
+                                            received[c][message.Producer]++;
+                                        }
+                                    }
+                                    else if (runningProducers.load() == 0 && queue.IsEmpty())
+                                    {
+                                        break;
+                                    }
+                                }
+                            });
+                        }
+
+                        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+                        producing = false;
+
+                        for (std::thread & worker : workers)
+                        {
+                            worker.join();
+                        }
+
+                        std::uint64_t total = 0;
+
+                        for (unsigned p = 0; p < producers; ++p)
+                        {
+                            std::uint64_t count = 0;
+
+                            for (unsigned c = 0; c < consumers; ++c)
+                            {
+                                count += received[c][p];
+                            }
+
+                            if (count != sent[p])
+                            {
+                                std::cout << "Producer " << p << " sent " << sent[p] << " messages, " << count << " received." << std::endl;
+                                failed = true;
+                            }
+
+                            total += count;
+                        }
+
+                        std::cout << total << " messages, " << producers << " producers, " << consumers << " consumers: "
+                            << (failed ? "FAILED" : "passed") << std::endl;
+
+                        return failed ? 1 : 0;
+                    }
+                }
+            }
+        }
+    }
+}
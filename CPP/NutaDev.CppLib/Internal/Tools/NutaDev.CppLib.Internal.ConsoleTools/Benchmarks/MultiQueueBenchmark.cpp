@@ -0,0 +1,142 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "NutaDev.CppLib.Collections/Queues/PriorityQueue/MultiQueue.hpp"
+#include "NutaDev.CppLib.Collections/Queues/PriorityQueue/PriorityQueue.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Runs threads that alternate enqueue and dequeue on a queue prefilled with one item per operation.
+                        /// </summary>
+                        /// <param name="threads">Number of threads.</param>
+                        /// <param name="operations">Number of enqueue and dequeue pairs per thread.</param>
+                        /// <param name="enqueue">Enqueues the item, returns false if it should be retried.</param>
+                        /// <param name="dequeue">Dequeues an item, returns false if it should be retried.</param>
+                        /// <returns>Millions of operations per second.</returns>
+                        template<class TEnqueue, class TDequeue>
+                        double Throughput(unsigned threads, std::size_t operations, TEnqueue enqueue, TDequeue dequeue)
+                        {
+                            std::vector<std::thread> workers;
+                            Stopwatch stopwatch;
+
+                            for (unsigned t = 0; t < threads; ++t)
+                            {
+                                workers.emplace_back([=]()
+                                {
+                                    std::mt19937 random(t);
+
+                                    for (std::size_t i = 0; i < operations; ++i)
+                                    {
+                                        std::uint32_t value = 0;
+
+                                        while (!enqueue(random() % 1000000, static_cast<unsigned>(random() % 1000000)))
+                                        {
+                                        }
+
+                                        while (!dequeue(value))
+                                        {
+                                        }
+                                    }
+                                });
+                            }
+
+                            for (std::thread & worker : workers)
+                            {
+                                worker.join();
+                            }
+
+                            return 2.0 * threads * operations / stopwatch.ElapsedMilliseconds() / 1000.0;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Compares throughput of PriorityQueue and MultiQueue for growing number of threads.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of operations per thread and maximum number of threads.</param>
+                    /// <returns>Exit code.</returns>
+                    int MultiQueue(int argc, char * argv[])
+                    {
+                        std::size_t operations = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 200000;
+                        unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : std::thread::hardware_concurrency();
+
+                        std::cout << "Concurrent priority queues, " << operations << " operation pairs per thread, Mops/s" << std::endl;
+                        std::cout << std::left << std::setw(10) << "threads"
+                            << std::right << std::setw(16) << "PriorityQueue"
+                            << std::setw(16) << "MultiQueue"
+                            << std::endl;
+
+                        for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+                        {
+                            Collections::Queues::PriorityQueue::PriorityQueue<std::uint32_t, Collections::Heaps::QuaternaryHeapEngine> locked;
+                            Collections::Queues::PriorityQueue::MultiQueue<std::uint32_t> relaxed(threads);
+
+                            for (std::size_t i = 0; i < operations; ++i)
+                            {
+                                locked.TryEnqueue(static_cast<std::uint32_t>(i), static_cast<unsigned>(i));
+                                relaxed.Enqueue(static_cast<std::uint32_t>(i), static_cast<unsigned>(i));
+                            }
+
+                            double lockedThroughput = Throughput(threads, operations,
+                                [&locked](std::uint32_t value, unsigned priority) { return locked.TryEnqueue(value, priority); },
+                                [&locked](std::uint32_t & value) { return locked.TryDequeue(value); });
+
+                            double relaxedThroughput = Throughput(threads, operations,
+                                [&relaxed](std::uint32_t value, unsigned priority) { return relaxed.TryEnqueue(value, priority); },
+                                [&relaxed](std::uint32_t & value) { return relaxed.TryDequeue(value); });
+
+                            std::cout << std::left << std::setw(10) << threads
+                                << std::right << std::fixed << std::setprecision(2)
+                                << std::setw(16) << lockedThroughput
+                                << std::setw(16) << relaxedThroughput
+                                << std::endl;
+                        }
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
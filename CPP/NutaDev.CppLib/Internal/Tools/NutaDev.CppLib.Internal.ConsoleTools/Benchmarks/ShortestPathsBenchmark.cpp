@@ -0,0 +1,237 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "NutaDev.CppLib.Graphs/Csr/CsrGraph.hpp"
+#include "NutaDev.CppLib.Graphs/Heuristics/EuclideanHeuristic.hpp"
+#include "NutaDev.CppLib.Graphs/ShortestPaths/AStar.hpp"
+#include "NutaDev.CppLib.Graphs/ShortestPaths/Dijkstra.hpp"
+#include "NutaDev.CppLib.Graphs/ShortestPaths/LazyDijkstra.hpp"
+#include "NutaDev.CppLib.Math/Models/Point/Point.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        typedef Graphs::Csr::CsrGraph<std::uint32_t> Graph;
+                        typedef Math::Models::Point::Point2dInt Point;
+                        typedef Graphs::Heuristics::EuclideanHeuristic<std::uint32_t> Heuristic;
+
+                        /// <summary>
+                        /// Road-like network: jittered grid with both directions of every street, some diagonals
+                        /// and removed blocks. Weight is straight line length stretched by up to 50%.
+                        /// </summary>
+                        /// <param name="side">Number of vertices along one side.</param>
+                        /// <param name="coordinates">Receives coordinates of vertices.</param>
+                        /// <returns>The graph.</returns>
+                        Graph BuildNetwork(std::uint32_t side, std::vector<Point> & coordinates)
+                        {
+                            const int spacing = 100;
+
+                            std::mt19937 random(6);
+                            std::vector<Graphs::Csr::WeightedEdge<std::uint32_t>> edges;
+
+                            coordinates.resize(static_cast<std::size_t>(side) * side);
+                            edges.reserve(coordinates.size() * 4);
+
+                            for (std::uint32_t y = 0; y < side; ++y)
+                            {
+                                for (std::uint32_t x = 0; x < side; ++x)
+                                {
+                                    Point & point = coordinates[y * side + x];
+
+                                    point.X = static_cast<int>(x) * spacing + static_cast<int>(random() % (spacing / 2));
+                                    point.Y = static_cast<int>(y) * spacing + static_cast<int>(random() % (spacing / 2));
+                                }
+                            }
+
+                            auto connect = [&](std::uint32_t from, std::uint32_t to)
+                            {
+                                double length = Math::Models::Point::distanceBetweenTwoPoints(coordinates[from], coordinates[to]);
+
+                                std::uint32_t forward = static_cast<std::uint32_t>(std::ceil(length * (1.0 + (random() % 50) / 100.0)));
+                                std::uint32_t backward = static_cast<std::uint32_t>(std::ceil(length * (1.0 + (random() % 50) / 100.0)));
+
+                                edges.push_back(Graphs::Csr::WeightedEdge<std::uint32_t>(from, to, forward));
+                                edges.push_back(Graphs::Csr::WeightedEdge<std::uint32_t>(to, from, backward));
+                            };
+
+                            for (std::uint32_t y = 0; y < side; ++y)
+                            {
+                                for (std::uint32_t x = 0; x < side; ++x)
+                                {
+                                    std::uint32_t vertex = y * side + x;
+                                    unsigned roll = random() % 16;
+
+                                    if (x + 1 < side && roll != 0)
+                                    {
+                                        connect(vertex, vertex + 1);
+                                    }
+
+                                    if (y + 1 < side && roll != 1)
+                                    {
+                                        connect(vertex, vertex + side);
+                                    }
+
+                                    if (x + 1 < side && y + 1 < side && roll < 2)
+                                    {
+                                        connect(vertex, vertex + side + 1);
+                                    }
+                                }
+                            }
+
+                            return Graph(static_cast<std::uint32_t>(coordinates.size()), edges);
+                        }
+
+                        /// <summary>
+                        /// Runs the queries with the search and prints one row.
+                        /// </summary>
+                        /// <param name="name">Row name.</param>
+                        /// <param name="search">The search.</param>
+                        /// <param name="queries">Pairs of source and target.</param>
+                        /// <param name="expected">Distances found by the first search, filled when empty.</param>
+                        template<typename TSearch>
+                        void Run(const char * name, TSearch & search, const std::vector<std::pair<std::uint32_t, std::uint32_t>> & queries, std::vector<std::uint32_t> & expected)
+                        {
+                            bool fill = expected.empty();
+                            bool mismatch = false;
+                            std::size_t settled = 0;
+                            Stopwatch stopwatch;
+
+                            for (std::size_t i = 0; i < queries.size(); ++i)
+                            {
+                                bool reached = search.Run(queries[i].first, queries[i].second);
+                                std::uint32_t distance = reached ? search.Distance(queries[i].second) : 0;
+
+                                if (fill)
+                                {
+                                    expected.push_back(distance);
+                                }
+                                else if (expected[i] != distance)
+                                {
+                                    mismatch = true;
+                                }
+
+                                settled += search.SettledCount();
+                            }
+
+                            double elapsed = stopwatch.ElapsedMilliseconds();
+
+                            std::cout << std::left << std::setw(20) << name
+                                << std::right << std::fixed << std::setprecision(1)
+                                << std::setw(14) << elapsed / queries.size()
+                                << std::setw(14) << static_cast<double>(settled) / queries.size()
+                                << (mismatch ? "  distance mismatch" : "")
+                                << std::endl;
+                        }
+
+                        /// <summary>
+                        /// Creates the search, runs the queries and releases the search before the next one is created.
+                        /// </summary>
+                        template<typename TSearch, typename... TArgs>
+                        void Measure(const char * name, const std::vector<std::pair<std::uint32_t, std::uint32_t>> & queries, std::vector<std::uint32_t> & expected, const Graph & graph, TArgs &&... args)
+                        {
+                            TSearch search(graph, std::forward<TArgs>(args)...);
+
+                            Run(name, search, queries, expected);
+                        }
+                    }
+
+                    /// <summary>
+                    /// Compares Dijkstra with decrease-key on each heap engine, lazy deletion Dijkstra and A*
+                    /// on a road-like network.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of edges in millions and number of queries.</param>
+                    /// <returns>Exit code.</returns>
+                    int ShortestPaths(int argc, char * argv[])
+                    {
+                        double millions = argc > 0 ? std::atof(argv[0]) : 20.0;
+                        std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+
+                        if (millions <= 0 || count == 0)
+                        {
+                            std::cout << "Number of edges and queries has to be positive." << std::endl;
+                            return 1;
+                        }
+
+                        // Every vertex has four outgoing edges on average.
+                        std::uint32_t side = static_cast<std::uint32_t>(std::sqrt(millions * 1000000.0 / 4.0)) + 2;
+                        std::vector<Point> coordinates;
+
+                        Stopwatch stopwatch;
+                        Graph graph = BuildNetwork(side, coordinates);
+                        double build = stopwatch.ElapsedMilliseconds();
+
+                        std::mt19937 random(7);
+                        std::vector<std::pair<std::uint32_t, std::uint32_t>> queries;
+
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            queries.push_back(std::make_pair(random() % graph.VertexCount(), random() % graph.VertexCount()));
+                        }
+
+                        std::cout << "Shortest paths, " << graph.VertexCount() << " vertices, " << graph.EdgeCount() << " edges, built in "
+                            << std::fixed << std::setprecision(1) << build << " ms, " << count << " queries" << std::endl;
+                        std::cout << std::left << std::setw(20) << "search"
+                            << std::right << std::setw(14) << "ms/query"
+                            << std::setw(14) << "settled"
+                            << std::endl;
+
+                        std::vector<std::uint32_t> expected;
+                        Heuristic heuristic(coordinates, 1.0);
+
+                        Measure<Graphs::ShortestPaths::LazyDijkstra<std::uint32_t>>("lazy binary", queries, expected, graph);
+                        Measure<Graphs::ShortestPaths::Dijkstra<std::uint32_t, Collections::Heaps::FibonacciHeapEngine>>("fibonacci", queries, expected, graph);
+                        Measure<Graphs::ShortestPaths::Dijkstra<std::uint32_t, Collections::Heaps::PairingHeapEngine>>("pairing", queries, expected, graph);
+                        Measure<Graphs::ShortestPaths::Dijkstra<std::uint32_t, Collections::Heaps::QuaternaryHeapEngine>>("4-ary", queries, expected, graph);
+                        Measure<Graphs::ShortestPaths::AStar<std::uint32_t, Heuristic, Collections::Heaps::FibonacciHeapEngine>>("a* fibonacci", queries, expected, graph, heuristic);
+                        Measure<Graphs::ShortestPaths::AStar<std::uint32_t, Heuristic, Collections::Heaps::PairingHeapEngine>>("a* pairing", queries, expected, graph, heuristic);
+                        Measure<Graphs::ShortestPaths::AStar<std::uint32_t, Heuristic, Collections::Heaps::QuaternaryHeapEngine>>("a* 4-ary", queries, expected, graph, heuristic);
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,215 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "NutaDev.CppLib.Collections/Queues/Queue.hpp"
+#include "NutaDev.CppLib.Collections/Queues/SpscQueue.hpp"
+#include "NutaDev.CppLib.Threading/Thread/Task.hpp"
+
+#include "Benchmarks.hpp"
+#include "Stopwatch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    namespace
+                    {
+                        /// <summary>
+                        /// Pipeline stage, forwards items from input to output until input is closed.
+                        /// </summary>
+                        template<class TQueue>
+                        class ForwardingTask : public Threading::Thread::Task
+                        {
+                        public:
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="input">Queue read by the stage.</param>
+                            /// <param name="output">Queue written by the stage.</param>
+                            ForwardingTask(TQueue & input, TQueue & output)
+                                : _input(input)
+                                , _output(output)
+                            {
+                            }
+
+                            /// <summary>
+                            /// Function that is executed on another thread.
+                            /// </summary>
+                            void ThreadRoutine() override
+                            {
+                                std::uint64_t item = 0;
+
+                                while (_input.Dequeue(item) == Collections::Queues::Dequeued)
+                                {
+                                    _output.Emplace(item);
+                                }
+
+                                _output.Close();
+                            }
+
+                        private:
+                            /// <summary>
+                            /// Queue read by the stage.
+                            /// </summary>
+                            TQueue & _input;
+
+                            /// <summary>
+                            /// Queue written by the stage.
+                            /// </summary>
+                            TQueue & _output;
+                        };
+
+                        /// <summary>
+                        /// Queue of the pipeline, SPSC queues need a capacity.
+                        /// </summary>
+                        template<class TQueue>
+                        struct QueueFactory
+                        {
+                            static std::unique_ptr<TQueue> Create(unsigned capacity)
+                            {
+                                return std::unique_ptr<TQueue>(new TQueue(capacity));
+                            }
+                        };
+
+                        /// <summary>
+                        /// Queue of the pipeline, Queue is unbounded.
+                        /// </summary>
+                        template<class T>
+                        struct QueueFactory<Collections::Queues::Queue<T>>
+                        {
+                            static std::unique_ptr<Collections::Queues::Queue<T>> Create(unsigned)
+                            {
+                                return std::unique_ptr<Collections::Queues::Queue<T>>(new Collections::Queues::Queue<T>());
+                            }
+                        };
+
+                        /// <summary>
+                        /// Runs items through a chain of forwarding tasks.
+                        /// </summary>
+                        /// <param name="stages">Number of forwarding tasks.</param>
+                        /// <param name="count">Number of items.</param>
+                        /// <param name="capacity">Capacity of each queue.</param>
+                        /// <param name="window">Maximum number of items in flight, 1 measures latency of a round trip.</param>
+                        /// <returns>Elapsed milliseconds.</returns>
+                        template<class TQueue>
+                        double Pipeline(unsigned stages, std::size_t count, unsigned capacity, std::size_t window)
+                        {
+                            std::vector<std::unique_ptr<TQueue>> queues;
+                            std::vector<std::unique_ptr<ForwardingTask<TQueue>>> tasks;
+
+                            for (unsigned i = 0; i <= stages; ++i)
+                            {
+                                queues.push_back(QueueFactory<TQueue>::Create(capacity));
+                            }
+
+                            for (unsigned i = 0; i < stages; ++i)
+                            {
+                                tasks.emplace_back(new ForwardingTask<TQueue>(*queues[i], *queues[i + 1]));
+                                tasks.back()->Start();
+                            }
+
+                            Stopwatch stopwatch;
+                            std::size_t sent = 0;
+                            std::uint64_t item = 0;
+
+                            for (std::size_t received = 0; received < count; ++received)
+                            {
+                                while (sent < count && sent - received < window)
+                                {
+                                    queues.front()->Emplace(static_cast<std::uint64_t>(sent++));
+                                }
+
+                                queues.back()->Dequeue(item);
+                            }
+
+                            double elapsed = stopwatch.ElapsedMilliseconds();
+
+                            queues.front()->Close();
+
+                            for (std::unique_ptr<ForwardingTask<TQueue>> & task : tasks)
+                            {
+                                task->Join();
+                            }
+
+                            return elapsed;
+                        }
+
+                        /// <summary>
+                        /// Prints latency of one hop and throughput of the pipeline.
+                        /// </summary>
+                        template<class TQueue>
+                        void Report(const char * name, unsigned stages, std::size_t count, unsigned capacity)
+                        {
+                            std::size_t roundTrips = count / 10 > 0 ? count / 10 : 1;
+                            double latency = Pipeline<TQueue>(stages, roundTrips, capacity, 1) * 1000000.0 / roundTrips / (stages + 1);
+                            double throughput = count / Pipeline<TQueue>(stages, count, capacity, capacity) / 1000.0;
+
+                            std::cout << std::left << std::setw(30) << name
+                                << std::right << std::fixed << std::setprecision(2)
+                                << std::setw(16) << latency
+                                << std::setw(16) << throughput
+                                << std::endl;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Measures hop latency and throughput of a pipeline of tasks connected by Queue and SpscQueue.
+                    /// </summary>
+                    /// <param name="argc">Number of arguments.</param>
+                    /// <param name="argv">Arguments, optional number of items, number of stages and capacity of queues.</param>
+                    /// <returns>Exit code.</returns>
+                    int SpscPipeline(int argc, char * argv[])
+                    {
+                        std::size_t count = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 1000000;
+                        unsigned stages = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 2;
+                        unsigned capacity = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 1024;
+
+                        std::cout << "Pipeline of " << stages << " tasks, " << count << " items" << std::endl;
+                        std::cout << std::left << std::setw(30) << "queue"
+                            << std::right << std::setw(16) << "ns per hop"
+                            << std::setw(16) << "Mitems/s"
+                            << std::endl;
+
+                        Report<Collections::Queues::Queue<std::uint64_t>>("Queue", stages, count, capacity);
+                        Report<Collections::Queues::SpscQueue<std::uint64_t, Collections::Queues::SpinYieldWait>>("SpscQueue<SpinYieldWait>", stages, count, capacity);
+                        Report<Collections::Queues::SpscQueue<std::uint64_t, Collections::Queues::SpinYieldParkWait>>("SpscQueue<SpinYieldParkWait>", stages, count, capacity);
+
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_INTERNAL_CONSOLETOOLS_BENCHMARKS_STOPWATCH_HPP
+#define NUTADEV_CPPLIB_INTERNAL_CONSOLETOOLS_BENCHMARKS_STOPWATCH_HPP
+
+#include <chrono>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Internal
+        {
+            namespace ConsoleTools
+            {
+                namespace Benchmarks
+                {
+                    /// <summary>
+                    /// Measures elapsed wall time.
+                    /// </summary>
+                    class Stopwatch
+                    {
+                    public:
+                        /// <summary>
+                        /// Initializes a new instance of this class and starts measuring.
+                        /// </summary>
+                        Stopwatch()
+                            : _start(std::chrono::steady_clock::now())
+                        {
+                        }
+
+                        /// <summary>
+                        /// Starts measuring again.
+                        /// </summary>
+                        void Restart()
+                        {
+                            _start = std::chrono::steady_clock::now();
+                        }
+
+                        /// <summary>
+                        /// Gets time elapsed since start.
+                        /// </summary>
+                        /// <returns>Elapsed milliseconds.</returns>
+                        double ElapsedMilliseconds() const
+                        {
+                            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count();
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Start of measurement.
+                        /// </summary>
+                        std::chrono::steady_clock::time_point _start;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
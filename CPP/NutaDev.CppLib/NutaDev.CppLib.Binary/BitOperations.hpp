@@ -23,6 +23,10 @@
 #ifndef NUTADEV_CPPLIB_BINARY_BITOPERATIONS_HPP
 #define NUTADEV_CPPLIB_BINARY_BITOPERATIONS_HPP
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace NutaDev
 {
     namespace CppLib
@@ -116,6 +120,54 @@ namespace NutaDev
                 return out;
             }
 
+            /// <summary>
+            /// Gets position of the lowest set bit.
+            /// </summary>
+            /// <param name="val">The value, can't be zero.</param>
+            /// <returns>Position of the bit.</returns>
+            inline int lowestSetBit(unsigned long long val)
+            {
+#if defined(_MSC_VER) && defined(_WIN64)
+                unsigned long index;
+                _BitScanForward64(&index, val);
+                return static_cast<int>(index);
+#elif defined(_MSC_VER)
+                unsigned long index;
+                if (_BitScanForward(&index, static_cast<unsigned long>(val)))
+                {
+                    return static_cast<int>(index);
+                }
+                _BitScanForward(&index, static_cast<unsigned long>(val >> 32));
+                return static_cast<int>(index) + 32;
+#else
+                return __builtin_ctzll(val);
+#endif
+            }
+
+            /// <summary>
+            /// Gets position of the highest set bit.
+            /// </summary>
+            /// <param name="val">The value, can't be zero.</param>
+            /// <returns>Position of the bit.</returns>
+            inline int highestSetBit(unsigned long long val)
+            {
+#if defined(_MSC_VER) && defined(_WIN64)
+                unsigned long index;
+                _BitScanReverse64(&index, val);
+                return static_cast<int>(index);
+#elif defined(_MSC_VER)
+                unsigned long index;
+                if (_BitScanReverse(&index, static_cast<unsigned long>(val >> 32)))
+                {
+                    return static_cast<int>(index) + 32;
+                }
+                _BitScanReverse(&index, static_cast<unsigned long>(val));
+                return static_cast<int>(index);
+#else
+                return 63 - __builtin_clzll(val);
+#endif
+            }
+
             /// <summary>
             /// Prints binary values.
             /// </summary>
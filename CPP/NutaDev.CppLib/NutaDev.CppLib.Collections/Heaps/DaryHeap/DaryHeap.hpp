@@ -0,0 +1,663 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_DARYHEAP_DARYHEAP_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_DARYHEAP_DARYHEAP_HPP
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "../OrderedHeapIterator.hpp"
+#include "../SplitMode.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Heaps
+            {
+                namespace DaryHeap
+                {
+                    /// <summary>
+                    /// Implicit array-backed heap where every node has TArity children.
+                    /// Keys are stored inline in one vector, so there is no per-element allocation.
+                    /// Handle returned by Push stays valid until the element is erased. Keys are ordered by TCompare, smallest first.
+                    /// </summary>
+                    template<class T, std::size_t TArity = 4, class TCompare = std::less<T>>
+                    class DaryHeap
+                    {
+                        static_assert(TArity >= 2, "Heap arity has to be at least 2.");
+
+                    public:
+                        /// <summary>
+                        /// Handle to an element of the heap.
+                        /// </summary>
+                        typedef std::size_t Handle;
+
+                        /// <summary>
+                        /// Type of stored keys.
+                        /// </summary>
+                        typedef T ValueType;
+
+                        /// <summary>
+                        /// Iterator over keys in ascending order, see OrderedHeapIterator.
+                        /// </summary>
+                        typedef OrderedHeapIterator<DaryHeap<T, TArity, TCompare>> OrderedIterator;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        DaryHeap()
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="compare">Key comparer.</param>
+                        explicit DaryHeap(const TCompare & compare)
+                            : _compare(compare)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Indicates whether heap is empty.
+                        /// </summary>
+                        /// <returns>True if heap is empty, false otherwise.</returns>
+                        bool Empty() const
+                        {
+                            return _entries.empty();
+                        }
+
+                        /// <summary>
+                        /// Returns heap size.
+                        /// </summary>
+                        /// <returns>The size.</returns>
+                        unsigned int Size() const noexcept
+                        {
+                            return static_cast<unsigned int>(_entries.size());
+                        }
+
+                        /// <summary>
+                        /// Returns top value.
+                        /// </summary>
+                        /// <returns>The value of top.</returns>
+                        const T & Top() const
+                        {
+                            return _entries.front().Key;
+                        }
+
+                        /// <summary>
+                        /// Returns key of the element.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <returns>The key.</returns>
+                        const T & Get(Handle handle) const
+                        {
+                            return _entries[_positions[handle]].Key;
+                        }
+
+                        /// <summary>
+                        /// Pushes the key.
+                        /// </summary>
+                        /// <param name="key">The key.</param>
+                        /// <returns>Handle of pushed item, valid until the item is erased.</returns>
+                        Handle Push(T key)
+                        {
+                            Handle handle;
+
+                            if (_freeHandles.empty())
+                            {
+                                handle = _positions.size();
+                                _positions.push_back(_entries.size());
+                            }
+                            else
+                            {
+                                handle = _freeHandles.back();
+                                _freeHandles.pop_back();
+                                _positions[handle] = _entries.size();
+                            }
+
+                            _entries.push_back(Entry(std::move(key), handle));
+
+                            SiftUp(_entries.size() - 1);
+
+                            return handle;
+                        }
+
+                        /// <summary>
+                        /// Constructs the key and pushes it. Entries are stored by value, so the key is moved once.
+                        /// </summary>
+                        /// <param name="args">Arguments of the key constructor.</param>
+                        /// <returns>Handle of the element.</returns>
+                        template<typename... TArgs>
+                        Handle Emplace(TArgs &&... args)
+                        {
+                            return Push(T(std::forward<TArgs>(args)...));
+                        }
+
+                        /// <summary>
+                        /// Pushes all keys of the range. When the range is larger than the heap the whole array
+                        /// is rebuilt bottom-up (Floyd), which is O(n), otherwise new keys are sifted up one by one.
+                        /// </summary>
+                        /// <param name="first">Beginning of the range.</param>
+                        /// <param name="last">End of the range.</param>
+                        template<typename TIterator>
+                        void PushRange(TIterator first, TIterator last)
+                        {
+                            std::size_t oldSize = _entries.size();
+                            std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+
+                            _entries.reserve(oldSize + count);
+                            _positions.reserve(_positions.size() + (count > _freeHandles.size() ? count - _freeHandles.size() : 0));
+
+                            for (; first != last; ++first)
+                            {
+                                Handle handle;
+
+                                if (_freeHandles.empty())
+                                {
+                                    handle = _positions.size();
+                                    _positions.push_back(_entries.size());
+                                }
+                                else
+                                {
+                                    handle = _freeHandles.back();
+                                    _freeHandles.pop_back();
+                                    _positions[handle] = _entries.size();
+                                }
+
+                                _entries.push_back(Entry(T(*first), handle));
+                            }
+
+                            if (count > oldSize)
+                            {
+                                Heapify();
+                            }
+                            else
+                            {
+                                for (std::size_t position = oldSize; position < _entries.size(); ++position)
+                                {
+                                    SiftUp(position);
+                                }
+                            }
+                        }
+
+                        /// <summary>
+                        /// Pops the top node.
+                        /// </summary>
+                        void Pop()
+                        {
+                            if (Empty())
+                            {
+                                return;
+                            }
+
+                            EraseMinimum();
+                        }
+
+                        /// <summary>
+                        /// Erases minimum node.
+                        /// </summary>
+                        /// <returns>The key of erased node.</returns>
+                        T EraseMinimum()
+                        {
+                            if (Empty())
+                            {
+                                throw std::exception("You can't erase minimum of empty heap.");
+                            }
+
+                            return RemoveAt(0);
+                        }
+
+                        /// <summary>
+                        /// Erases the element. The handle is invalid afterwards.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <returns>The key of erased element.</returns>
+                        T Erase(Handle handle)
+                        {
+                            return RemoveAt(_positions[handle]);
+                        }
+
+                        /// <summary>
+                        /// Decreases the key of the element.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <param name="key">The new key, can't be greater than the current one.</param>
+                        void DecreaseKey(Handle handle, T key)
+                        {
+                            std::size_t position = _positions[handle];
+
+                            if (_compare(_entries[position].Key, key))
+                            {
+                                throw std::exception("Current key is lower than new key.");
+                            }
+
+                            _entries[position].Key = std::move(key);
+
+                            SiftUp(position);
+                        }
+
+                        /// <summary>
+                        /// Changes the key of the element. The handle stays valid.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <param name="key">The new key.</param>
+                        void Update(Handle handle, T key)
+                        {
+                            std::size_t position = _positions[handle];
+                            bool increased = _compare(_entries[position].Key, key);
+
+                            _entries[position].Key = std::move(key);
+
+                            if (increased)
+                            {
+                                SiftDown(position);
+                            }
+                            else
+                            {
+                                SiftUp(position);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Moves all elements of another heap into this heap. The other heap is left empty
+                        /// and handles obtained from it are no longer valid.
+                        /// </summary>
+                        /// <param name="other">Another heap.</param>
+                        void Join(DaryHeap<T, TArity, TCompare> & other)
+                        {
+                            if (this == &other)
+                            {
+                                return;
+                            }
+
+                            for (Entry & entry : other._entries)
+                            {
+                                Push(std::move(entry.Key));
+                            }
+
+                            other.Clear();
+                        }
+
+                        /// <summary>
+                        /// Clears whole heap.
+                        /// </summary>
+                        void Clear()
+                        {
+                            _entries.clear();
+                            _positions.clear();
+                            _freeHandles.clear();
+                        }
+
+                        /// <summary>
+                        /// Moves half of the items into another heap. ByCount moves the back half of the array,
+                        /// the front half stays a valid heap. Interleaved moves every other entry, so both halves cover
+                        /// all levels of the heap, and rebuilds this heap. Moved items are bulk pushed into the other heap,
+                        /// their handles are no longer valid.
+                        /// </summary>
+                        /// <param name="other">Heap that receives the items.</param>
+                        /// <param name="mode">How to choose moved items.</param>
+                        void Split(DaryHeap<T, TArity, TCompare> & other, SplitMode mode = ByCount)
+                        {
+                            if (this == &other || _entries.size() < 2)
+                            {
+                                return;
+                            }
+
+                            std::size_t count = _entries.size() / 2;
+                            std::vector<T> moved;
+
+                            moved.reserve(count);
+
+                            if (mode == Interleaved)
+                            {
+                                std::size_t kept = 0;
+
+                                for (std::size_t position = 0; position < _entries.size(); ++position)
+                                {
+                                    if (position % 2 == 1 && moved.size() < count)
+                                    {
+                                        moved.push_back(std::move(_entries[position].Key));
+                                        _freeHandles.push_back(_entries[position].Owner);
+                                    }
+                                    else
+                                    {
+                                        if (kept != position)
+                                        {
+                                            Place(kept, std::move(_entries[position]));
+                                        }
+
+                                        ++kept;
+                                    }
+                                }
+
+                                _entries.erase(_entries.begin() + kept, _entries.end());
+
+                                Heapify();
+                            }
+                            else
+                            {
+                                for (std::size_t position = _entries.size() - count; position < _entries.size(); ++position)
+                                {
+                                    moved.push_back(std::move(_entries[position].Key));
+                                    _freeHandles.push_back(_entries[position].Owner);
+                                }
+
+                                _entries.erase(_entries.end() - count, _entries.end());
+                            }
+
+                            other.PushRange(std::make_move_iterator(moved.begin()), std::make_move_iterator(moved.end()));
+                        }
+
+                        /// <summary>
+                        /// Gets iterator to the minimum. Keys are visited in ascending order without modifying the heap,
+                        /// the heap can't be modified while the iterator is used.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        OrderedIterator OrderedBegin() const
+                        {
+                            return OrderedIterator(this);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator past the maximum.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        OrderedIterator OrderedEnd() const
+                        {
+                            return OrderedIterator();
+                        }
+
+                        /// <summary>
+                        /// Copies up to count smallest keys in ascending order without modifying the heap.
+                        /// </summary>
+                        /// <param name="count">Number of keys.</param>
+                        /// <returns>The keys.</returns>
+                        std::vector<T> PeekTopK(std::size_t count) const
+                        {
+                            std::vector<T> result;
+
+                            result.reserve(count < Size() ? count : Size());
+
+                            for (OrderedIterator it = OrderedBegin(), end = OrderedEnd(); it != end && result.size() < count; ++it)
+                            {
+                                result.push_back(*it);
+                            }
+
+                            return result;
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Key stored in the heap array together with its handle.
+                        /// </summary>
+                        struct Entry
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="key">The key.</param>
+                            /// <param name="handle">Handle of the key.</param>
+                            Entry(T && key, Handle handle)
+                                : Key(std::move(key))
+                                , Owner(handle)
+                            {
+                            }
+
+                            /// <summary>
+                            /// The key.
+                            /// </summary>
+                            T Key;
+
+                            /// <summary>
+                            /// Handle of the key.
+                            /// </summary>
+                            Handle Owner;
+                        };
+
+                        /// <summary>
+                        /// Heap ordered keys.
+                        /// </summary>
+                        std::vector<Entry> _entries;
+
+                        /// <summary>
+                        /// Position in _entries for every handle.
+                        /// </summary>
+                        std::vector<std::size_t> _positions;
+
+                        /// <summary>
+                        /// Handles released by erased elements.
+                        /// </summary>
+                        std::vector<Handle> _freeHandles;
+
+                        /// <summary>
+                        /// Key comparer.
+                        /// </summary>
+                        TCompare _compare;
+
+                        /// <summary>
+                        /// Removes the entry on specified position.
+                        /// </summary>
+                        /// <param name="position">The position.</param>
+                        /// <returns>The removed key.</returns>
+                        T RemoveAt(std::size_t position)
+                        {
+                            T key = std::move(_entries[position].Key);
+                            std::size_t last = _entries.size() - 1;
+
+                            _freeHandles.push_back(_entries[position].Owner);
+
+                            if (position != last)
+                            {
+                                bool increased = _compare(key, _entries[last].Key);
+
+                                _entries[position] = std::move(_entries[last]);
+                                _positions[_entries[position].Owner] = position;
+                                _entries.pop_back();
+
+                                if (increased)
+                                {
+                                    SiftDown(position);
+                                }
+                                else
+                                {
+                                    SiftUp(position);
+                                }
+                            }
+                            else
+                            {
+                                _entries.pop_back();
+                            }
+
+                            return key;
+                        }
+
+                        /// <summary>
+                        /// Restores heap order of the whole array, starting from the last inner node.
+                        /// </summary>
+                        void Heapify()
+                        {
+                            std::size_t size = _entries.size();
+
+                            if (size < 2)
+                            {
+                                return;
+                            }
+
+                            for (std::size_t position = (size - 2) / TArity + 1; position > 0; --position)
+                            {
+                                SiftDown(position - 1);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Moves the entry towards the root until heap order is restored.
+                        /// </summary>
+                        /// <param name="position">Position of the entry.</param>
+                        void SiftUp(std::size_t position)
+                        {
+                            if (position == 0)
+                            {
+                                return;
+                            }
+
+                            Entry entry = std::move(_entries[position]);
+
+                            while (position > 0)
+                            {
+                                std::size_t parent = (position - 1) / TArity;
+
+                                if (!_compare(entry.Key, _entries[parent].Key))
+                                {
+                                    break;
+                                }
+
+                                Place(position, std::move(_entries[parent]));
+                                position = parent;
+                            }
+
+                            Place(position, std::move(entry));
+                        }
+
+                        /// <summary>
+                        /// Moves the entry towards the leaves until heap order is restored.
+                        /// </summary>
+                        /// <param name="position">Position of the entry.</param>
+                        void SiftDown(std::size_t position)
+                        {
+                            std::size_t size = _entries.size();
+                            Entry entry = std::move(_entries[position]);
+
+                            while (true)
+                            {
+                                std::size_t first = position * TArity + 1;
+
+                                if (first >= size)
+                                {
+                                    break;
+                                }
+
+                                std::size_t end = first + TArity < size ? first + TArity : size;
+                                std::size_t best = first;
+
+                                for (std::size_t child = first + 1; child < end; ++child)
+                                {
+                                    if (_compare(_entries[child].Key, _entries[best].Key))
+                                    {
+                                        best = child;
+                                    }
+                                }
+
+                                if (!_compare(_entries[best].Key, entry.Key))
+                                {
+                                    break;
+                                }
+
+                                Place(position, std::move(_entries[best]));
+                                position = best;
+                            }
+
+                            Place(position, std::move(entry));
+                        }
+
+                        /// <summary>
+                        /// Stores the entry on specified position and updates its handle.
+                        /// </summary>
+                        /// <param name="position">The position.</param>
+                        /// <param name="entry">The entry.</param>
+                        void Place(std::size_t position, Entry && entry)
+                        {
+                            _entries[position] = std::move(entry);
+                            _positions[_entries[position].Owner] = position;
+                        }
+
+                        friend class OrderedHeapIterator<DaryHeap<T, TArity, TCompare>>;
+
+                        /// <summary>
+                        /// Node visited by OrderedHeapIterator.
+                        /// </summary>
+                        typedef std::size_t TraversalNode;
+
+                        /// <summary>
+                        /// Adds nodes that start ordered traversal.
+                        /// </summary>
+                        /// <param name="nodes">Traversal candidates.</param>
+                        void SeedTraversal(std::vector<TraversalNode> & nodes) const
+                        {
+                            if (!_entries.empty())
+                            {
+                                nodes.push_back(0);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Adds children of the visited node.
+                        /// </summary>
+                        /// <param name="node">Visited node.</param>
+                        /// <param name="nodes">Traversal candidates.</param>
+                        void ExpandTraversal(TraversalNode node, std::vector<TraversalNode> & nodes) const
+                        {
+                            std::size_t first = node * TArity + 1;
+                            std::size_t end = first + TArity < _entries.size() ? first + TArity : _entries.size();
+
+                            for (std::size_t child = first; child < end; ++child)
+                            {
+                                nodes.push_back(child);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Gets key of the node.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        /// <returns>The key.</returns>
+                        const T & TraversalKey(TraversalNode node) const
+                        {
+                            return _entries[node].Key;
+                        }
+
+                        /// <summary>
+                        /// Compares keys of the nodes.
+                        /// </summary>
+                        /// <param name="left">Left node.</param>
+                        /// <param name="right">Right node.</param>
+                        /// <returns>True if left key goes first.</returns>
+                        bool TraversalBefore(TraversalNode left, TraversalNode right) const
+                        {
+                            return _compare(TraversalKey(left), TraversalKey(right));
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -23,9 +23,19 @@
 #ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_FIBONACCIHEAP_FIBONACCIHEAP_HPP
 #define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_FIBONACCIHEAP_FIBONACCIHEAP_HPP
 
-#include <cmath>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <iterator>
 #include <limits>
-
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../HeapStatistics.hpp"
+#include "../OrderedHeapIterator.hpp"
+#include "../SplitMode.hpp"
+#include "../Storage/SlabNodeStorage.hpp"
 #include "HeapItem.hpp"
 
 namespace NutaDev
@@ -40,71 +50,59 @@ namespace NutaDev
                 {
                     /// <summary>
                     /// The fibbonacci heap.
+                    /// Nodes are created by TStorage and linked with raw pointers. Handle returned by Push
+                    /// stays valid until the element is erased. Keys are ordered by TCompare, smallest first.
+                    /// Cuts don't keep subtree sizes, Split counts them in one O(n) pass.
+                    /// TStatistics counts links, cuts and consolidation work, see Heaps/HeapStatistics.hpp.
+                    /// It is an empty base by default, so the heap pays nothing when statistics are disabled.
                     /// </summary>
-                    template<class T>
-                    class FibonacciHeap
+                    template<class T, class TCompare = std::less<T>, class TStorage = Storage::SlabNodeStorage<HeapItem<T>>, class TStatistics = NoHeapStatistics>
+                    class FibonacciHeap : private TStatistics
                     {
                     public:
                         /// <summary>
-                        /// Joins two heaps.
+                        /// Handle to an element of the heap.
+                        /// </summary>
+                        typedef HeapItem<T> * Handle;
+
+                        /// <summary>
+                        /// Type of stored keys.
+                        /// </summary>
+                        typedef T ValueType;
+
+                        /// <summary>
+                        /// Iterator over keys in ascending order, see OrderedHeapIterator.
+                        /// </summary>
+                        typedef OrderedHeapIterator<FibonacciHeap<T, TCompare, TStorage, TStatistics>> OrderedIterator;
+
+                        /// <summary>
+                        /// Joins two heaps. Both heaps are left empty.
                         /// </summary>
                         /// <param name="left">Left heap.</param>
                         /// <param name="right">Right heap.</param>
                         /// <returns>New heap.</returns>
-                        static FibonacciHeap<T> JoinHeaps(FibonacciHeap<T> & left, FibonacciHeap<T> & right)
+                        static FibonacciHeap<T, TCompare, TStorage, TStatistics> JoinHeaps(FibonacciHeap<T, TCompare, TStorage, TStatistics> & left, FibonacciHeap<T, TCompare, TStorage, TStatistics> & right)
                         {
-                            FibonacciHeap<T> merged = FibonacciHeap<T>();
-
-                            merged._root = left._root;
-
-                            if (merged._root != nullptr && right._root != nullptr)
-                            {
-                                merged._root->Right->Left = right._root->Left;
-                                right._root->Left->Right = merged._root->Right;
-                                merged._root->Right = right._root;
-                                right._root->Left = merged._root;
-                            }
-
-                            if (left._root == nullptr || (right._root != nullptr && right._root->Key < left._root->Key))
-                            {
-                                merged._root = right._root;
-                            }
-
-                            right._root = nullptr;
+                            FibonacciHeap<T, TCompare, TStorage, TStatistics> merged = FibonacciHeap<T, TCompare, TStorage, TStatistics>();
 
-                            merged._size = left._size + right._size;
+                            merged.Join(left);
+                            merged.Join(right);
 
                             return merged;
                         }
 
                         /// <summary>
-                        /// Joins two heaps.
+                        /// Joins two heaps. Both heaps are left empty.
                         /// </summary>
                         /// <param name="left">Left heap.</param>
                         /// <param name="right">Right heap.</param>
                         /// <returns>New heap.</returns>
-                        static std::shared_ptr<FibonacciHeap<T>> JoinHeaps(std::shared_ptr<FibonacciHeap<T>> left, std::shared_ptr<FibonacciHeap<T>> right)
+                        static std::shared_ptr<FibonacciHeap<T, TCompare, TStorage, TStatistics>> JoinHeaps(std::shared_ptr<FibonacciHeap<T, TCompare, TStorage, TStatistics>> left, std::shared_ptr<FibonacciHeap<T, TCompare, TStorage, TStatistics>> right)
                         {
-                            std::shared_ptr<FibonacciHeap<T>> merged = std::shared_ptr<FibonacciHeap<T>>(new FibonacciHeap<T>());
-
-                            merged->_root = left->_root;
-
-                            if (merged->_root != nullptr && right->_root != nullptr)
-                            {
-                                merged->_root->Right->Left = right->_root->Left;
-                                right->_root->Left->Right = merged->_root->Right;
-                                merged->_root->Right = right->_root;
-                                right->_root->Left = merged->_root;
-                            }
-
-                            if (left->_root == nullptr || (right->_root != nullptr && right->_root->Key < left->_root->Key))
-                            {
-                                merged->_root = right->_root;
-                            }
-
-                            right->_root = nullptr;
+                            std::shared_ptr<FibonacciHeap<T, TCompare, TStorage, TStatistics>> merged = std::shared_ptr<FibonacciHeap<T, TCompare, TStorage, TStatistics>>(new FibonacciHeap<T, TCompare, TStorage, TStatistics>());
 
-                            merged->_size = left->_size + right->_size;
+                            merged->Join(*left);
+                            merged->Join(*right);
 
                             return merged;
                         }
@@ -112,15 +110,12 @@ namespace NutaDev
                         /// <summary>
                         /// Links two nodes.
                         /// </summary>
-                        /// <param name="leftNode"></param>
-                        /// <param name="rightNode"></param>
-                        static void LinkHeapNodes(std::shared_ptr<HeapItem<T>> leftNode, std::shared_ptr<HeapItem<T>> rightNode)
+                        /// <param name="leftNode">Node that becomes a child.</param>
+                        /// <param name="rightNode">Node that becomes a parent.</param>
+                        static void LinkHeapNodes(HeapItem<T> * leftNode, HeapItem<T> * rightNode)
                         {
-                            std::shared_ptr<HeapItem<T>> tempRight = leftNode->Right;
-                            std::shared_ptr<HeapItem<T>> tempLeft = leftNode->Left;
-
-                            leftNode->Left->Right = tempRight;
-                            leftNode->Right->Left = tempLeft;
+                            leftNode->Left->Right = leftNode->Right;
+                            leftNode->Right->Left = leftNode->Left;
 
                             if (rightNode->Child != nullptr)
                             {
@@ -152,23 +147,182 @@ namespace NutaDev
                         {
                         }
 
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="compare">Key comparer.</param>
+                        explicit FibonacciHeap(const TCompare & compare)
+                            : _size (0)
+                            , _root (nullptr)
+                            , _compare (compare)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, passes the allocator to the node storage,
+                        /// see Storage/AllocatorNodeStorage.hpp.
+                        /// </summary>
+                        /// <param name="allocator">Allocator of nodes.</param>
+                        /// <param name="compare">Key comparer.</param>
+                        template<typename TAllocator>
+                        FibonacciHeap(std::allocator_arg_t, const TAllocator & allocator, const TCompare & compare = TCompare())
+                            : _size (0)
+                            , _root (nullptr)
+                            , _compare (compare)
+                            , _storage (allocator)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="other">Heap to copy.</param>
+                        FibonacciHeap(const FibonacciHeap<T, TCompare, TStorage, TStatistics> & other)
+                            : TStatistics ()
+                            , _size (0)
+                            , _root (nullptr)
+                            , _compare (other._compare)
+                        {
+                            CopyFrom(other);
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="other">Heap to move.</param>
+                        FibonacciHeap(FibonacciHeap<T, TCompare, TStorage, TStatistics> && other) noexcept
+                            : TStatistics (static_cast<const TStatistics &>(other))
+                            , _size (other._size)
+                            , _root (other._root)
+                            , _compare (std::move(other._compare))
+                            , _storage (std::move(other._storage))
+                        {
+                            other._size = 0;
+                            other._root = nullptr;
+                        }
+
+                        /// <summary>
+                        /// Assigns another heap.
+                        /// </summary>
+                        /// <param name="other">Heap to copy.</param>
+                        /// <returns>Reference to itself.</returns>
+                        FibonacciHeap<T, TCompare, TStorage, TStatistics> & operator=(const FibonacciHeap<T, TCompare, TStorage, TStatistics> & other)
+                        {
+                            if (this != &other)
+                            {
+                                Clear();
+                                _compare = other._compare;
+                                CopyFrom(other);
+                            }
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Assigns another heap.
+                        /// </summary>
+                        /// <param name="other">Heap to move.</param>
+                        /// <returns>Reference to itself.</returns>
+                        FibonacciHeap<T, TCompare, TStorage, TStatistics> & operator=(FibonacciHeap<T, TCompare, TStorage, TStatistics> && other) noexcept
+                        {
+                            if (this != &other)
+                            {
+                                Clear();
+
+                                TStatistics::operator=(static_cast<const TStatistics &>(other));
+
+                                _size = other._size;
+                                _root = other._root;
+                                _compare = std::move(other._compare);
+                                _storage = std::move(other._storage);
+
+                                other._size = 0;
+                                other._root = nullptr;
+                            }
+
+                            return *this;
+                        }
+
                         /// <summary>
                         /// Destructs the instance of this class.
                         /// </summary>
                         ~FibonacciHeap()
                         {
-                            Clear(_root);
+                            Clear();
                         }
 
                         /// <summary>
                         /// Erases the node.
                         /// </summary>
                         /// <param name="node">Node to erase.</param>
-                        void EraseNode(std::shared_ptr<HeapItem<T>> node)
+                        void EraseNode(Handle node)
+                        {
+                            Erase(node);
+                        }
+
+                        /// <summary>
+                        /// Erases the element. The handle is invalid afterwards.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <returns>The key of erased element.</returns>
+                        T Erase(Handle handle)
                         {
-                            LowerKey(node, std::numeric_limits<T>::min());
+                            Extract(handle);
+
+                            T key = std::move(handle->Key);
 
-                            std::shared_ptr<HeapItem<T>> fn = EraseMinimum();
+                            _storage.Destroy(handle);
+
+                            return key;
+                        }
+
+                        /// <summary>
+                        /// Decreases the key of the element in amortized constant time.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <param name="key">The new key, can't be greater than the current one.</param>
+                        void DecreaseKey(Handle handle, T key)
+                        {
+                            if (_compare(handle->Key, key))
+                            {
+                                throw std::exception("Current key is lower than new key.");
+                            }
+
+                            handle->Key = std::move(key);
+
+                            HeapItem<T> * parent = handle->Parent;
+
+                            if (parent != nullptr && _compare(handle->Key, parent->Key))
+                            {
+                                Slice(handle, parent);
+                                RecurrentSlice(parent);
+                            }
+
+                            if (_compare(handle->Key, _root->Key))
+                            {
+                                _root = handle;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Changes the key of the element. Lower key is applied with DecreaseKey, greater key
+                        /// detaches the element and inserts it again. The handle stays valid in both cases.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <param name="key">The new key.</param>
+                        void Update(Handle handle, T key)
+                        {
+                            if (!_compare(handle->Key, key))
+                            {
+                                DecreaseKey(handle, std::move(key));
+                                return;
+                            }
+
+                            Extract(handle);
+
+                            handle->Key = std::move(key);
+
+                            Insert(handle);
                         }
 
                         /// <summary>
@@ -184,7 +338,7 @@ namespace NutaDev
                         /// Returns top node.
                         /// </summary>
                         /// <returns>The node.</returns>
-                        std::shared_ptr<HeapItem<T>> TopNode()
+                        Handle TopNode()
                         {
                             return Minimum();
                         }
@@ -193,9 +347,19 @@ namespace NutaDev
                         /// Returns top value.
                         /// </summary>
                         /// <returns>The value of top.</returns>
-                        T Top()
+                        const T & Top() const
                         {
-                            return Minimum()->Key;
+                            return _root->Key;
+                        }
+
+                        /// <summary>
+                        /// Returns key of the element.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <returns>The key.</returns>
+                        const T & Get(Handle handle) const
+                        {
+                            return handle->Key;
                         }
 
                         /// <summary>
@@ -208,21 +372,69 @@ namespace NutaDev
                                 return;
                             }
 
-                            std::shared_ptr<HeapItem<T>> item = EraseMinimum();
+                            EraseMinimum();
                         }
 
                         /// <summary>
                         /// Pushes the key.
                         /// </summary>
                         /// <param name="key"></param>
-                        /// <returns>Pushed item.</returns>
-                        std::shared_ptr<HeapItem<T>> Push(T key)
+                        /// <returns>Handle of pushed item, valid until the item is erased.</returns>
+                        Handle Push(T key)
                         {
-                            std::shared_ptr<HeapItem<T>> item = std::shared_ptr<HeapItem<T>>(new HeapItem<T>(key));
+                            HeapItem<T> * item = _storage.Create(std::move(key));
                             Insert(item);
                             return item;
                         }
 
+                        /// <summary>
+                        /// Constructs the key in place and pushes it.
+                        /// </summary>
+                        /// <param name="args">Arguments of the key constructor.</param>
+                        /// <returns>Handle of the element.</returns>
+                        template<typename... TArgs>
+                        Handle Emplace(TArgs &&... args)
+                        {
+                            HeapItem<T> * item = _storage.Create(std::piecewise_construct, std::forward<TArgs>(args)...);
+                            Insert(item);
+                            return item;
+                        }
+
+                        /// <summary>
+                        /// Pushes all keys of the range in O(n). Nodes for the whole range are allocated at once.
+                        /// </summary>
+                        /// <param name="first">Beginning of the range.</param>
+                        /// <param name="last">End of the range.</param>
+                        template<typename TIterator>
+                        void PushRange(TIterator first, TIterator last)
+                        {
+                            _storage.Reserve(static_cast<std::size_t>(std::distance(first, last)));
+
+                            for (; first != last; ++first)
+                            {
+                                Insert(_storage.Create(*first));
+                            }
+                        }
+
+                        /// <summary>
+                        /// Gets number of allocations made by the node storage. Pop paths never allocate,
+                        /// so the value stays the same across EraseMinimum, Pop and Erase.
+                        /// </summary>
+                        /// <returns>Number of allocations.</returns>
+                        std::size_t AllocationCount() const noexcept
+                        {
+                            return _storage.AllocationCount();
+                        }
+
+                        /// <summary>
+                        /// Gets counters of structural work, zeroed when TStatistics is NoHeapStatistics.
+                        /// </summary>
+                        /// <returns>The counters.</returns>
+                        HeapStatisticsSnapshot Statistics() const noexcept
+                        {
+                            return TStatistics::Snapshot();
+                        }
+
                         /// <summary>
                         /// Returns heap size.
                         /// </summary>
@@ -236,7 +448,7 @@ namespace NutaDev
                         /// Returns minimum.
                         /// </summary>
                         /// <returns>The minimum item.</returns>
-                        std::shared_ptr<HeapItem<T>> Minimum()
+                        Handle Minimum()
                         {
                             return _root;
                         }
@@ -247,231 +459,211 @@ namespace NutaDev
                         void Clear()
                         {
                             Clear(_root);
+
+                            _root = nullptr;
+                            _size = 0;
                         }
 
                         /// <summary>
-                        /// Clears the node.
+                        /// Moves all elements of another heap into this heap. The other heap is left empty.
                         /// </summary>
-                        /// <param name="ndoe">The node.</param>
-                        void Clear(std::shared_ptr<HeapItem<T>> node)
+                        /// <param name="other">Another heap.</param>
+                        void Join(FibonacciHeap<T, TCompare, TStorage, TStatistics> & other)
                         {
-                            if (node == nullptr)
+                            if (this == &other)
                             {
                                 return;
                             }
 
-                            std::shared_ptr<HeapItem<T>> current = node;
+                            _storage.Adopt(other._storage);
 
-                            while (true)
+                            if (_root != nullptr && other._root != nullptr)
                             {
-                                if (current->Left != nullptr && current->Left != node)
-                                {
-                                    std::shared_ptr<HeapItem<T>> temp = current;
+                                HeapItem<T> * tail = other._root->Left;
 
-                                    current = current->Left;
-
-                                    if (temp->Child != nullptr)
-                                    {
-                                        Clear(temp->Child);
-                                    }
-                                }
-                                else
-                                {
-                                    if (current->Child != nullptr)
-                                    {
-                                        Clear(current->Child);
-                                    }
+                                tail->Right = _root->Right;
+                                _root->Right->Left = tail;
+                                _root->Right = other._root;
+                                other._root->Left = _root;
+                            }
 
-                                    break;
-                                }
+                            if (_root == nullptr || (other._root != nullptr && _compare(other._root->Key, _root->Key)))
+                            {
+                                _root = other._root;
                             }
+
+                            _size += other._size;
+
+                            other._root = nullptr;
+                            other._size = 0;
                         }
 
                         /// <summary>
-                        /// Inserts the node.
+                        /// Moves half of the items into another heap by detaching whole trees, so nodes are not copied.
+                        /// ByCount takes the largest trees that fit, Interleaved first spreads trees from the whole key range
+                        /// between both heaps. Subtree sizes are not kept by cuts, so Split counts them in one O(n) pass,
+                        /// choosing the trees after consolidation costs O(log^2 n). Nodes are not copied. Handles of moved
+                        /// items stay valid and belong to the other heap, which shares node storage with this one.
                         /// </summary>
-                        /// <param name="item">Node to insert.</param>
-                        void Insert(std::shared_ptr<HeapItem<T>> item)
+                        /// <param name="other">Heap that receives the items.</param>
+                        /// <param name="mode">How to choose moved items.</param>
+                        void Split(FibonacciHeap<T, TCompare, TStorage, TStatistics> & other, SplitMode mode = ByCount)
                         {
-                            item->Rank = 0;
-                            item->Parent = nullptr;
-                            item->Child = nullptr;
-                            item->Mark = false;
-
-                            if (_root == nullptr)
+                            if (this == &other || _size < 2)
                             {
-                                _root = item;
-                                item->Left = item;
-                                item->Right = item;
+                                return;
                             }
-                            else
-                            {
-                                _root->Left->Right = item;
-                                item->Left = _root->Left;
-                                _root->Left = item;
-                                item->Right = _root;
 
-                                if (item->Key < _root->Key)
-                                {
-                                    _root = item;
-                                }
-                            }
+                            other._storage.Share(_storage);
 
-                            ++_size;
-                        }
+                            Merge();
 
-                        /// <summary>
-                        /// Erases minimum node.
-                        /// </summary>
-                        /// <returns>The erased node.</returns>
-                        std::shared_ptr<HeapItem<T>> EraseMinimum()
-                        {
-                            std::shared_ptr<HeapItem<T>> min;
-                            std::shared_ptr<HeapItem<T>> child;
-                            std::shared_ptr<HeapItem<T>> next;
-                            std::shared_ptr<std::shared_ptr<HeapItem<T>>> childList;
+                            std::vector<HeapItem<T> *> trees;
+                            std::vector<HeapItem<T> *> nodes;
+                            HeapItem<T> * root = _root;
+
+                            do
+                            {
+                                trees.push_back(root);
+                                CountTree(root, nodes);
+                                root = root->Right;
+                            }
+                            while (root != _root);
 
-                            min = _root;
+                            unsigned count = _size / 2;
 
-                            if (min != nullptr)
+                            if (mode == Interleaved)
                             {
-                                child = min->Child;
+                                for (std::size_t i = 0, roots = trees.size(); i < roots; ++i)
+                                {
+                                    OpenTree(trees[i], trees);
+                                }
 
-                                if (child != nullptr)
+                                std::sort(trees.begin(), trees.end(), [this](const HeapItem<T> * left, const HeapItem<T> * right)
                                 {
-                                    childList = Make1dArray(min->Rank);
-                                    next = child;
+                                    return _compare(left->Key, right->Key);
+                                });
+
+                                unsigned moved = 0;
+                                unsigned kept = 0;
+                                std::size_t remaining = 0;
 
-                                    for (int i = 0; i < min->Rank; i++)
+                                for (std::size_t i = 0; i < trees.size(); ++i)
+                                {
+                                    HeapItem<T> * tree = trees[i];
+
+                                    if (moved <= kept && moved + tree->Count <= count)
                                     {
-                                        childList.get()[i]    = next;
-                                        next = next->Right;
+                                        moved += tree->Count;
+                                        MoveTree(tree, other);
                                     }
-
-                                    for (int i = 0; i < min->Rank; i++)
+                                    else
                                     {
-                                        child = childList.get()[i];
-                                        _root->Left->Right = child;
-                                        child->Left = _root->Left;
-                                        _root->Left = child;
-                                        child->Right = _root;
-                                        child->Parent = nullptr;
+                                        kept += tree->Count;
+                                        trees[remaining++] = tree;
                                     }
                                 }
 
-                                min->Left->Right = min->Right;
-                                min->Right->Left = min->Left;
-
-                                if (min == min->Right)
-                                {
-                                    _root = nullptr;
-                                }
-                                else
-                                {
-                                    _root = min->Right;
-                                    Merge();
-                                }
-
-                                _size--;
+                                trees.resize(remaining);
+                                count -= moved;
                             }
 
-                            return min;
+                            MoveCount(count, trees, other);
+
+                            RestoreMinimum();
                         }
 
                         /// <summary>
-                        /// Merges heap.
+                        /// Erases minimum node.
                         /// </summary>
-                        void Merge()
+                        /// <returns>The key of erased node.</returns>
+                        T EraseMinimum()
                         {
-                            std::shared_ptr<HeapItem<T>> nodeInRootList;
-                            std::shared_ptr<HeapItem<T>> next;
-                            std::shared_ptr<std::shared_ptr<HeapItem<T>>> newArray;
-                            std::shared_ptr<std::shared_ptr<HeapItem<T>>> rootList;
+                            HeapItem<T> * min = ExtractMinimum();
 
-                            unsigned rootSize;
-                            int maxDegreePlus2;
-                            int maxDegree;
+                            T key = std::move(min->Key);
 
-                            maxDegree = static_cast<int>(floor(log(static_cast<double>(_size)) / log(static_cast<double>(1 + sqrt(static_cast<double>(5))) / 2)));
-                            maxDegreePlus2 = maxDegree + 2;
-                            newArray = Make1dArray(maxDegreePlus2);
+                            _storage.Destroy(min);
 
-                            for (int i = 0; i < maxDegreePlus2; ++i)
-                            {
-                                newArray.get()[i] = nullptr;
-                            }
+                            return key;
+                        }
 
-                            nodeInRootList = _root;
-                            rootSize = 0;
-                            next = nodeInRootList;
+                        /// <summary>
+                        /// Merges heap. Roots of equal rank are linked until all ranks differ.
+                        /// Root list is walked in place and ranks are tracked in a fixed table, so nothing is allocated.
+                        /// </summary>
+                        void Merge()
+                        {
+                            HeapItem<T> * degrees[DegreeCapacity] = { };
+                            HeapItem<T> * node = _root;
+                            unsigned rootSize = 0;
 
                             do
                             {
                                 ++rootSize;
-                                next = next->Right;
+                                node = node->Right;
                             }
-                            while (next != nodeInRootList);
+                            while (node != _root);
 
-                            rootList = Make1dArray(rootSize);
-
-                            for (unsigned i = 0; i < rootSize; i++)
-                            {
-                                rootList.get()[i]    = next;
-                                next = next->Right;
-                            }
+                            TStatistics::OnMergeStarted(rootSize);
 
                             for (unsigned i = 0; i < rootSize; i++)
                             {
-                                nodeInRootList = rootList.get()[i];
-
-                                std::shared_ptr<HeapItem<T>> nodeInRootTemp = nodeInRootList;
-                                int tempRank = nodeInRootTemp->Rank;
+                                // Linking only unlinks roots that were already visited, so the next root stays in the list.
+                                HeapItem<T> * next = node->Right;
+                                HeapItem<T> * tree = node;
+                                int rank = tree->Rank;
 
-                                while (newArray.get()[tempRank] != nullptr)
+                                while (degrees[rank] != nullptr)
                                 {
-                                    std::shared_ptr<HeapItem<T>> newArrayNode = newArray.get()[tempRank];
+                                    HeapItem<T> * other = degrees[rank];
 
-                                    if (nodeInRootTemp->Key > newArrayNode->Key)
+                                    if (_compare(other->Key, tree->Key))
                                     {
-                                        std::shared_ptr<HeapItem<T>> temp = nodeInRootTemp;
-
-                                        nodeInRootTemp = newArrayNode;
-                                        newArrayNode = temp;
+                                        std::swap(tree, other);
                                     }
 
-                                    LinkHeapNodes(newArrayNode, nodeInRootTemp);
+                                    LinkHeapNodes(other, tree);
+                                    TStatistics::OnLink(tree->Rank);
 
-                                    newArray.get()[tempRank] = nullptr;
+                                    degrees[rank] = nullptr;
 
-                                    ++tempRank;
+                                    ++rank;
                                 }
 
-                                newArray.get()[tempRank] = nodeInRootTemp;
+                                degrees[rank] = tree;
+                                node = next;
                             }
 
+                            TStatistics::OnMergeFinished();
+
                             _root = nullptr;
 
-                            for (int i = 0; i < maxDegreePlus2; i++)
+                            for (int i = 0; i < DegreeCapacity; i++)
                             {
-                                if (newArray.get()[i] != nullptr)
+                                HeapItem<T> * tree = degrees[i];
+
+                                if (tree == nullptr)
                                 {
-                                    if (_root == nullptr)
-                                    {
-                                        _root = newArray.get()[i];
-                                        newArray.get()[i]->Left = newArray.get()[i];
-                                        newArray.get()[i]->Right = newArray.get()[i];
-                                    }
-                                    else
-                                    {
-                                        _root->Left->Right = newArray.get()[i];
-                                        newArray.get()[i]->Left = _root->Left;
-                                        _root->Left = newArray.get()[i];
-                                        newArray.get()[i]->Right = _root;
+                                    continue;
+                                }
 
-                                        if (newArray.get()[i]->Key < _root->Key)
-                                        {
-                                            _root = newArray.get()[i];
-                                        }
+                                if (_root == nullptr)
+                                {
+                                    _root = tree;
+                                    tree->Left = tree;
+                                    tree->Right = tree;
+                                }
+                                else
+                                {
+                                    _root->Left->Right = tree;
+                                    tree->Left = _root->Left;
+                                    _root->Left = tree;
+                                    tree->Right = _root;
+
+                                    if (_compare(tree->Key, _root->Key))
+                                    {
+                                        _root = tree;
                                     }
                                 }
                             }
@@ -482,27 +674,9 @@ namespace NutaDev
                         /// </summary>
                         /// <param name="node">Node to modify.</param>
                         /// <param name="key">The new key.</param>
-                        void LowerKey(std::shared_ptr<HeapItem<T>> node, int key)
+                        void LowerKey(Handle node, T key)
                         {
-                            if (key > node->Key)
-                            {
-                                throw std::exception("Current key is lower than new key.");
-                            }
-
-                            node->Key = key;
-
-                            std::shared_ptr<HeapItem<T>> temp = node->Parent;
-
-                            if (temp != nullptr && node->Key < temp->Key)
-                            {
-                                Slice(node, temp);
-                                RecurrentSlice(temp);
-                            }
-
-                            if (node->Key < _root->Key)
-                            {
-                                _root = node;
-                            }
+                            DecreaseKey(node, std::move(key));
                         }
 
                         /// <summary>
@@ -510,7 +684,7 @@ namespace NutaDev
                         /// </summary>
                         /// <param name="leftNode">The left node.</param>
                         /// <param name="rightNode">The right node.</param>
-                        void Slice(std::shared_ptr<HeapItem<T>> leftNode, std::shared_ptr<HeapItem<T>> rightNode)
+                        void Slice(HeapItem<T> * leftNode, HeapItem<T> * rightNode)
                         {
                             if (leftNode->Right == leftNode)
                             {
@@ -529,11 +703,13 @@ namespace NutaDev
 
                             --(rightNode->Rank);
 
+                            TStatistics::OnCut();
+
                             _root->Right->Left = leftNode;
                             leftNode->Right = _root->Right;
                             _root->Right = leftNode;
-                            leftNode->Left = _root;        
-                            leftNode->Parent = nullptr;        
+                            leftNode->Left = _root;
+                            leftNode->Parent = nullptr;
                             leftNode->Mark = false;
                         }
 
@@ -541,9 +717,9 @@ namespace NutaDev
                         /// Slices the tree.
                         /// </summary>
                         /// <param name="node">The node.</param>
-                        void RecurrentSlice(std::shared_ptr<HeapItem<T>> node)
+                        void RecurrentSlice(HeapItem<T> * node)
                         {
-                            std::shared_ptr<HeapItem<T>> temp;
+                            HeapItem<T> * temp;
 
                             temp = node->Parent;
 
@@ -557,12 +733,57 @@ namespace NutaDev
                                 else
                                 {
                                     Slice(node, temp);
+                                    TStatistics::OnCascadingCut();
                                     RecurrentSlice(temp);
                                 }
                             }
                         }
 
+                        /// <summary>
+                        /// Gets iterator to the minimum. Keys are visited in ascending order without modifying the heap,
+                        /// the heap can't be modified while the iterator is used.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        OrderedIterator OrderedBegin() const
+                        {
+                            return OrderedIterator(this);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator past the maximum.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        OrderedIterator OrderedEnd() const
+                        {
+                            return OrderedIterator();
+                        }
+
+                        /// <summary>
+                        /// Copies up to count smallest keys in ascending order without modifying the heap.
+                        /// </summary>
+                        /// <param name="count">Number of keys.</param>
+                        /// <returns>The keys.</returns>
+                        std::vector<T> PeekTopK(std::size_t count) const
+                        {
+                            std::vector<T> result;
+
+                            result.reserve(count < Size() ? count : Size());
+
+                            for (OrderedIterator it = OrderedBegin(), end = OrderedEnd(); it != end && result.size() < count; ++it)
+                            {
+                                result.push_back(*it);
+                            }
+
+                            return result;
+                        }
+
                     private:
+                        /// <summary>
+                        /// Capacity of the rank table used by Merge. Rank of a node is bounded by log base golden ratio
+                        /// of the heap size, which is less than 1.5 times the bit width of the size type.
+                        /// </summary>
+                        static const int DegreeCapacity = std::numeric_limits<unsigned int>::digits * 3 / 2 + 2;
+
                         /// <summary>
                         /// Tree size.
                         /// </summary>
@@ -571,38 +792,451 @@ namespace NutaDev
                         /// <summary>
                         /// Root pointer.
                         /// </summary>
-                        std::shared_ptr<HeapItem<T>> _root;
+                        HeapItem<T> * _root;
+
+                        /// <summary>
+                        /// Key comparer.
+                        /// </summary>
+                        TCompare _compare;
+
+                        /// <summary>
+                        /// Owner of the nodes.
+                        /// </summary>
+                        TStorage _storage;
+
+                        /// <summary>
+                        /// Inserts the node.
+                        /// </summary>
+                        /// <param name="item">Node to insert.</param>
+                        void Insert(HeapItem<T> * item)
+                        {
+                            item->Rank = 0;
+                            item->Parent = nullptr;
+                            item->Child = nullptr;
+                            item->Mark = false;
+
+                            LinkRoot(item);
+
+                            ++_size;
+                        }
+
+                        /// <summary>
+                        /// Adds the tree to the root list and updates the minimum.
+                        /// </summary>
+                        /// <param name="tree">Root of the tree.</param>
+                        void LinkRoot(HeapItem<T> * tree)
+                        {
+                            if (_root == nullptr)
+                            {
+                                _root = tree;
+                                tree->Left = tree;
+                                tree->Right = tree;
+                            }
+                            else
+                            {
+                                _root->Left->Right = tree;
+                                tree->Left = _root->Left;
+                                _root->Left = tree;
+                                tree->Right = _root;
+
+                                if (_compare(tree->Key, _root->Key))
+                                {
+                                    _root = tree;
+                                }
+                            }
+                        }
+
+                        /// <summary>
+                        /// Removes the tree from the root list. Minimum has to be restored by the caller.
+                        /// </summary>
+                        /// <param name="tree">Root of the tree.</param>
+                        void UnlinkRoot(HeapItem<T> * tree)
+                        {
+                            if (tree->Right == tree)
+                            {
+                                _root = nullptr;
+                                return;
+                            }
+
+                            if (_root == tree)
+                            {
+                                _root = tree->Right;
+                            }
+
+                            tree->Left->Right = tree->Right;
+                            tree->Right->Left = tree->Left;
+                        }
+
+                        /// <summary>
+                        /// Moves children of the root to the root list, the root is left as a single node tree.
+                        /// </summary>
+                        /// <param name="tree">Root of the tree.</param>
+                        /// <param name="trees">Receives the new roots.</param>
+                        void OpenTree(HeapItem<T> * tree, std::vector<HeapItem<T> *> & trees)
+                        {
+                            HeapItem<T> * child = tree->Child;
+
+                            if (child == nullptr)
+                            {
+                                return;
+                            }
+
+                            HeapItem<T> * next = child;
+
+                            do
+                            {
+                                next->Parent = nullptr;
+                                next->Mark = false;
+                                trees.push_back(next);
+                                next = next->Right;
+                            }
+                            while (next != child);
+
+                            HeapItem<T> * lastChild = child->Left;
+
+                            _root->Left->Right = child;
+                            child->Left = _root->Left;
+                            lastChild->Right = _root;
+                            _root->Left = lastChild;
+
+                            tree->Child = nullptr;
+                            tree->Rank = 0;
+                            tree->Count = 1;
+                        }
+
+                        /// <summary>
+                        /// Counts items in subtrees of all nodes of the tree, children are visited after their parents
+                        /// so the sizes can be summed up in reverse order.
+                        /// </summary>
+                        /// <param name="tree">Root of the tree.</param>
+                        /// <param name="nodes">Buffer for the nodes of the tree.</param>
+                        static void CountTree(HeapItem<T> * tree, std::vector<HeapItem<T> *> & nodes)
+                        {
+                            nodes.clear();
+                            nodes.push_back(tree);
+
+                            for (std::size_t i = 0; i < nodes.size(); ++i)
+                            {
+                                HeapItem<T> * node = nodes[i];
+                                HeapItem<T> * child = node->Child;
+
+                                node->Count = 1;
+
+                                if (child != nullptr)
+                                {
+                                    do
+                                    {
+                                        nodes.push_back(child);
+                                        child = child->Right;
+                                    }
+                                    while (child != node->Child);
+                                }
+                            }
+
+                            for (std::size_t i = nodes.size() - 1; i > 0; --i)
+                            {
+                                nodes[i]->Parent->Count += nodes[i]->Count;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Moves the tree from the root list of this heap to the root list of another heap.
+                        /// </summary>
+                        /// <param name="tree">Root of the tree.</param>
+                        /// <param name="other">Another heap.</param>
+                        void MoveTree(HeapItem<T> * tree, FibonacciHeap<T, TCompare, TStorage, TStatistics> & other)
+                        {
+                            UnlinkRoot(tree);
+                            other.LinkRoot(tree);
+
+                            _size -= tree->Count;
+                            other._size += tree->Count;
+                        }
+
+                        /// <summary>
+                        /// Moves trees with exactly count items in total to another heap. Takes the largest tree that fits,
+                        /// or opens the smallest tree that doesn't when none fits.
+                        /// </summary>
+                        /// <param name="count">Number of items to move.</param>
+                        /// <param name="trees">Roots of this heap, moved ones are removed.</param>
+                        /// <param name="other">Another heap.</param>
+                        void MoveCount(unsigned count, std::vector<HeapItem<T> *> & trees, FibonacciHeap<T, TCompare, TStorage, TStatistics> & other)
+                        {
+                            while (count > 0)
+                            {
+                                std::size_t fit = trees.size();
+                                std::size_t over = trees.size();
+
+                                for (std::size_t i = 0; i < trees.size(); ++i)
+                                {
+                                    unsigned size = trees[i]->Count;
+
+                                    if (size <= count)
+                                    {
+                                        if (fit == trees.size() || size > trees[fit]->Count)
+                                        {
+                                            fit = i;
+                                        }
+                                    }
+                                    else if (over == trees.size() || size < trees[over]->Count)
+                                    {
+                                        over = i;
+                                    }
+                                }
+
+                                if (fit != trees.size())
+                                {
+                                    HeapItem<T> * tree = trees[fit];
+
+                                    trees[fit] = trees.back();
+                                    trees.pop_back();
+
+                                    count -= tree->Count;
+                                    MoveTree(tree, other);
+                                }
+                                else
+                                {
+                                    OpenTree(trees[over], trees);
+                                }
+                            }
+                        }
+
+                        /// <summary>
+                        /// Finds the minimum of the root list.
+                        /// </summary>
+                        void RestoreMinimum()
+                        {
+                            if (_root == nullptr)
+                            {
+                                return;
+                            }
+
+                            HeapItem<T> * node = _root->Right;
+
+                            while (node != _root)
+                            {
+                                HeapItem<T> * next = node->Right;
+
+                                if (_compare(node->Key, _root->Key))
+                                {
+                                    _root = node;
+                                }
+
+                                node = next;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Unlinks minimum node without destroying it.
+                        /// </summary>
+                        /// <returns>The unlinked node.</returns>
+                        HeapItem<T> * ExtractMinimum()
+                        {
+                            HeapItem<T> * min = _root;
+
+                            if (min == nullptr)
+                            {
+                                throw std::exception("You can't erase minimum of empty heap.");
+                            }
+
+                            HeapItem<T> * child = min->Child;
+
+                            if (child != nullptr)
+                            {
+                                HeapItem<T> * next = child;
+
+                                do
+                                {
+                                    next->Parent = nullptr;
+                                    next = next->Right;
+                                }
+                                while (next != child);
+
+                                // Splices the whole child list in front of the root.
+                                HeapItem<T> * lastChild = child->Left;
+
+                                _root->Left->Right = child;
+                                child->Left = _root->Left;
+                                lastChild->Right = _root;
+                                _root->Left = lastChild;
+
+                                min->Child = nullptr;
+                            }
+
+                            min->Left->Right = min->Right;
+                            min->Right->Left = min->Left;
+
+                            if (min == min->Right)
+                            {
+                                _root = nullptr;
+                            }
+                            else
+                            {
+                                _root = min->Right;
+                                Merge();
+                            }
+
+                            _size--;
+
+                            return min;
+                        }
+
+                        /// <summary>
+                        /// Unlinks the node without destroying it.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        void Extract(HeapItem<T> * node)
+                        {
+                            HeapItem<T> * parent = node->Parent;
+
+                            if (parent != nullptr)
+                            {
+                                Slice(node, parent);
+                                RecurrentSlice(parent);
+                            }
+
+                            _root = node;
+
+                            ExtractMinimum();
+                        }
+
+                        /// <summary>
+                        /// Destroys the node, its siblings and all their descendants.
+                        /// Children are spliced into the walked list, so no recursion is required.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        void Clear(HeapItem<T> * node)
+                        {
+                            if (node == nullptr)
+                            {
+                                return;
+                            }
+
+                            node->Left->Right = nullptr;
+
+                            HeapItem<T> * current = node;
+
+                            while (current != nullptr)
+                            {
+                                if (current->Child != nullptr)
+                                {
+                                    current->Child->Left->Right = current->Right;
+                                    current->Right = current->Child;
+                                }
+
+                                HeapItem<T> * next = current->Right;
+
+                                _storage.Destroy(current);
+
+                                current = next;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Pushes keys of all nodes of another heap.
+                        /// </summary>
+                        /// <param name="other">Another heap.</param>
+                        void CopyFrom(const FibonacciHeap<T, TCompare, TStorage, TStatistics> & other)
+                        {
+                            if (other._root == nullptr)
+                            {
+                                return;
+                            }
+
+                            std::vector<const HeapItem<T> *> pending;
+                            pending.push_back(other._root);
+
+                            while (!pending.empty())
+                            {
+                                const HeapItem<T> * first = pending.back();
+                                const HeapItem<T> * current = first;
+
+                                pending.pop_back();
+
+                                do
+                                {
+                                    Push(current->Key);
+
+                                    if (current->Child != nullptr)
+                                    {
+                                        pending.push_back(current->Child);
+                                    }
+
+                                    current = current->Right;
+                                }
+                                while (current != first);
+                            }
+                        }
+
+                        friend class OrderedHeapIterator<FibonacciHeap<T, TCompare, TStorage, TStatistics>>;
 
                         /// <summary>
-                        /// Makes 2d array.
+                        /// Node visited by OrderedHeapIterator.
                         /// </summary>
-                        /// <param name="rows">The size.</param>
-                        /// <param name="cols">The size.</param>
-                        /// <returns>The 2d array.</returns>
-                        static std::shared_ptr<std::shared_ptr<HeapItem<T>>> Make2dArray(unsigned rows, unsigned cols)
+                        typedef const HeapItem<T> * TraversalNode;
+
+                        /// <summary>
+                        /// Adds nodes that start ordered traversal.
+                        /// </summary>
+                        /// <param name="nodes">Traversal candidates.</param>
+                        void SeedTraversal(std::vector<TraversalNode> & nodes) const
                         {
-                            std::shared_ptr<std::shared_ptr<HeapItem<T>>> arr =
-                                std::shared_ptr<std::shared_ptr<HeapItem<T>>>(new std::shared_ptr<HeapItem<T>>[rows],
-                                                                              [](std::shared_ptr<HeapItem<T>> * p) -> void { delete[] p; });
+                            if (_root == nullptr)
+                            {
+                                return;
+                            }
+
+                            const HeapItem<T> * root = _root;
 
-                            for (unsigned i = 0; i < rows; ++i)
+                            do
                             {
-                                arr.get()[i] = std::shared_ptr<HeapItem<T>>(new HeapItem<T>[cols],
-                                                                            [](HeapItem<T> * p) -> void { delete[] p; });
+                                nodes.push_back(root);
+                                root = root->Right;
                             }
+                            while (root != _root);
+                        }
 
-                            return arr;
+                        /// <summary>
+                        /// Adds children of the visited node.
+                        /// </summary>
+                        /// <param name="node">Visited node.</param>
+                        /// <param name="nodes">Traversal candidates.</param>
+                        void ExpandTraversal(TraversalNode node, std::vector<TraversalNode> & nodes) const
+                        {
+                            const HeapItem<T> * child = node->Child;
+
+                            if (child == nullptr)
+                            {
+                                return;
+                            }
+
+                            do
+                            {
+                                nodes.push_back(child);
+                                child = child->Right;
+                            }
+                            while (child != node->Child);
+                        }
+
+                        /// <summary>
+                        /// Gets key of the node.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        /// <returns>The key.</returns>
+                        const T & TraversalKey(TraversalNode node) const
+                        {
+                            return node->Key;
                         }
 
                         /// <summary>
-                        /// Makes 1d array of tree.
+                        /// Compares keys of the nodes.
                         /// </summary>
-                        /// <param name="rows">The size.</param>
-                        /// <returns>The 1d arary.</returns>
-                        static std::shared_ptr<std::shared_ptr<HeapItem<T>>> Make1dArray(unsigned rows)
+                        /// <param name="left">Left node.</param>
+                        /// <param name="right">Right node.</param>
+                        /// <returns>True if left key goes first.</returns>
+                        bool TraversalBefore(TraversalNode left, TraversalNode right) const
                         {
-                            return std::shared_ptr<std::shared_ptr<HeapItem<T>>>(new std::shared_ptr<HeapItem<T>>[rows],
-                                                                                 [](std::shared_ptr<HeapItem<T>> * arr) -> void { delete[] arr; });
+                            return _compare(TraversalKey(left), TraversalKey(right));
                         }
                     };
                 }
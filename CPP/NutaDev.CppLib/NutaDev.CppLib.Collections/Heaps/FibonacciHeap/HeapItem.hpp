@@ -23,8 +23,7 @@
 #ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_FIBONACCIHEAP_HEAPITEM_HPP
 #define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_FIBONACCIHEAP_HEAPITEM_HPP
 
-#include <cmath>
-#include <memory>
+#include <utility>
 
 namespace NutaDev
 {
@@ -48,13 +47,31 @@ namespace NutaDev
                         /// </summary>
                         /// <param name="key">Item key</param>
                         HeapItem(T key)
-                            : Key(key)
+                            : Key(std::move(key))
                             , Mark(false)
                             , Parent(nullptr)
                             , Left(nullptr)
                             , Right(nullptr)
                             , Child(nullptr)
                             , Rank(-1)
+                            , Count(1)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, constructs the key in place.
+                        /// </summary>
+                        /// <param name="args">Arguments of the key constructor.</param>
+                        template<typename... TArgs>
+                        explicit HeapItem(std::piecewise_construct_t, TArgs &&... args)
+                            : Key(std::forward<TArgs>(args)...)
+                            , Mark(false)
+                            , Parent(nullptr)
+                            , Left(nullptr)
+                            , Right(nullptr)
+                            , Child(nullptr)
+                            , Rank(-1)
+                            , Count(1)
                         {
                         }
 
@@ -78,27 +95,32 @@ namespace NutaDev
                         /// <summary>
                         /// Parent item.
                         /// </summary>
-                        std::shared_ptr<HeapItem<T>> Parent;
+                        HeapItem<T> * Parent;
 
                         /// <summary>
                         /// Left item.
                         /// </summary>
-                        std::shared_ptr<HeapItem<T>> Left;
+                        HeapItem<T> * Left;
 
                         /// <summary>
                         /// Right item.
                         /// </summary>
-                        std::shared_ptr<HeapItem<T>> Right;
+                        HeapItem<T> * Right;
 
                         /// <summary>
                         /// The child.
                         /// </summary>
-                        std::shared_ptr<HeapItem<T>> Child;
+                        HeapItem<T> * Child;
 
                         /// <summary>
                         /// The rank.
                         /// </summary>
                         int Rank;
+
+                        /// <summary>
+                        /// Number of items in the subtree rooted at this item, counted by Split of the heap.
+                        /// </summary>
+                        unsigned Count;
                     };
                 }
             }
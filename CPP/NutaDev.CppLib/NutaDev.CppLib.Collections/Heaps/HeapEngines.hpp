@@ -0,0 +1,109 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_HEAPENGINES_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_HEAPENGINES_HPP
+
+#include <functional>
+
+#include "DaryHeap/DaryHeap.hpp"
+#include "FibonacciHeap/FibonacciHeap.hpp"
+#include "HeapStatistics.hpp"
+#include "PairingHeap/PairingHeap.hpp"
+#include "Storage/AllocatorNodeStorage.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Heaps
+            {
+                /// <summary>
+                /// Selects FibonacciHeap. Best when the workload relies on DecreaseKey and Join.
+                /// </summary>
+                struct FibonacciHeapEngine
+                {
+                    /// <summary>
+                    /// Heap of specified keys.
+                    /// </summary>
+                    template<class TKey>
+                    using Heap = FibonacciHeap::FibonacciHeap<TKey>;
+                };
+
+                /// <summary>
+                /// Selects FibonacciHeap that records structural work, see Heaps/HeapStatistics.hpp.
+                /// </summary>
+                template<class TStatistics = CountingHeapStatistics>
+                struct InstrumentedFibonacciHeapEngine
+                {
+                    /// <summary>
+                    /// Heap of specified keys.
+                    /// </summary>
+                    template<class TKey>
+                    using Heap = FibonacciHeap::FibonacciHeap<TKey, std::less<TKey>, Storage::SlabNodeStorage<FibonacciHeap::HeapItem<TKey>>, TStatistics>;
+                };
+
+                /// <summary>
+                /// Selects FibonacciHeap that allocates nodes with TAllocator, e.g. Memory::PoolAllocator or Memory::ArenaAllocator.
+                /// Pass the allocator to the container with std::allocator_arg when it has state.
+                /// </summary>
+                template<class TAllocator>
+                struct AllocatorFibonacciHeapEngine
+                {
+                    /// <summary>
+                    /// Heap of specified keys.
+                    /// </summary>
+                    template<class TKey>
+                    using Heap = FibonacciHeap::FibonacciHeap<TKey, std::less<TKey>, Storage::AllocatorNodeStorage<FibonacciHeap::HeapItem<TKey>, TAllocator>>;
+                };
+
+                /// <summary>
+                /// Selects PairingHeap. Cheap Join and DecreaseKey with smaller constants than FibonacciHeap.
+                /// </summary>
+                struct PairingHeapEngine
+                {
+                    /// <summary>
+                    /// Heap of specified keys.
+                    /// </summary>
+                    template<class TKey>
+                    using Heap = PairingHeap::PairingHeap<TKey>;
+                };
+
+                /// <summary>
+                /// Selects array-backed 4-ary heap. Best for push and pop heavy workloads.
+                /// </summary>
+                struct QuaternaryHeapEngine
+                {
+                    /// <summary>
+                    /// Heap of specified keys.
+                    /// </summary>
+                    template<class TKey>
+                    using Heap = DaryHeap::DaryHeap<TKey, 4>;
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,262 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_HEAPSTATISTICS_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_HEAPSTATISTICS_HPP
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Heaps
+            {
+                /// <summary>
+                /// Counters of structural work done by a heap.
+                /// </summary>
+                struct HeapStatisticsSnapshot
+                {
+                    /// <summary>
+                    /// Number of trees linked under another tree.
+                    /// </summary>
+                    unsigned long long Links;
+
+                    /// <summary>
+                    /// Number of subtrees cut from their parents, cascading cuts included.
+                    /// </summary>
+                    unsigned long long Cuts;
+
+                    /// <summary>
+                    /// Number of cuts of marked parents.
+                    /// </summary>
+                    unsigned long long CascadingCuts;
+
+                    /// <summary>
+                    /// Number of consolidations of the root list.
+                    /// </summary>
+                    unsigned long long Merges;
+
+                    /// <summary>
+                    /// Sum of root list lengths seen by all consolidations.
+                    /// </summary>
+                    unsigned long long MergedRoots;
+
+                    /// <summary>
+                    /// Root list length seen by the last consolidation.
+                    /// </summary>
+                    unsigned LastMergeRoots;
+
+                    /// <summary>
+                    /// The longest root list seen by a consolidation.
+                    /// </summary>
+                    unsigned MaximumMergeRoots;
+
+                    /// <summary>
+                    /// Links done by the last consolidation.
+                    /// </summary>
+                    unsigned LastMergeLinks;
+
+                    /// <summary>
+                    /// The most links done by one consolidation.
+                    /// </summary>
+                    unsigned MaximumMergeLinks;
+
+                    /// <summary>
+                    /// The highest rank a tree has reached.
+                    /// </summary>
+                    unsigned MaximumRank;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    HeapStatisticsSnapshot()
+                        : Links(0)
+                        , Cuts(0)
+                        , CascadingCuts(0)
+                        , Merges(0)
+                        , MergedRoots(0)
+                        , LastMergeRoots(0)
+                        , MaximumMergeRoots(0)
+                        , LastMergeLinks(0)
+                        , MaximumMergeLinks(0)
+                        , MaximumRank(0)
+                    {
+                    }
+                };
+
+                /// <summary>
+                /// Statistics policy that records nothing. Empty, so a heap using it stays the same size.
+                /// </summary>
+                class NoHeapStatistics
+                {
+                public:
+                    /// <summary>
+                    /// Indicates whether the policy records anything.
+                    /// </summary>
+                    static const bool Enabled = false;
+
+                    /// <summary>
+                    /// Ignores linking of two trees.
+                    /// </summary>
+                    void OnLink(unsigned) noexcept
+                    {
+                    }
+
+                    /// <summary>
+                    /// Ignores cut of a subtree.
+                    /// </summary>
+                    void OnCut() noexcept
+                    {
+                    }
+
+                    /// <summary>
+                    /// Ignores cut of a marked parent.
+                    /// </summary>
+                    void OnCascadingCut() noexcept
+                    {
+                    }
+
+                    /// <summary>
+                    /// Ignores start of a consolidation.
+                    /// </summary>
+                    void OnMergeStarted(unsigned) noexcept
+                    {
+                    }
+
+                    /// <summary>
+                    /// Ignores end of a consolidation.
+                    /// </summary>
+                    void OnMergeFinished() noexcept
+                    {
+                    }
+
+                    /// <summary>
+                    /// Gets the counters.
+                    /// </summary>
+                    /// <returns>Zeroed counters.</returns>
+                    HeapStatisticsSnapshot Snapshot() const noexcept
+                    {
+                        return HeapStatisticsSnapshot();
+                    }
+                };
+
+                /// <summary>
+                /// Statistics policy that counts links, cuts and consolidation work.
+                /// The heap calls it under the same synchronization as any other modification.
+                /// </summary>
+                class CountingHeapStatistics
+                {
+                public:
+                    /// <summary>
+                    /// Indicates whether the policy records anything.
+                    /// </summary>
+                    static const bool Enabled = true;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    CountingHeapStatistics()
+                        : _snapshot()
+                    {
+                    }
+
+                    /// <summary>
+                    /// Records linking of two trees.
+                    /// </summary>
+                    /// <param name="rank">Rank of the resulting tree.</param>
+                    void OnLink(unsigned rank) noexcept
+                    {
+                        ++_snapshot.Links;
+                        ++_snapshot.LastMergeLinks;
+
+                        if (rank > _snapshot.MaximumRank)
+                        {
+                            _snapshot.MaximumRank = rank;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Records cut of a subtree.
+                    /// </summary>
+                    void OnCut() noexcept
+                    {
+                        ++_snapshot.Cuts;
+                    }
+
+                    /// <summary>
+                    /// Records cut of a marked parent, comes after OnCut of the same cut.
+                    /// </summary>
+                    void OnCascadingCut() noexcept
+                    {
+                        ++_snapshot.CascadingCuts;
+                    }
+
+                    /// <summary>
+                    /// Records start of a consolidation.
+                    /// </summary>
+                    /// <param name="roots">Length of the root list.</param>
+                    void OnMergeStarted(unsigned roots) noexcept
+                    {
+                        ++_snapshot.Merges;
+                        _snapshot.MergedRoots += roots;
+                        _snapshot.LastMergeRoots = roots;
+                        _snapshot.LastMergeLinks = 0;
+
+                        if (roots > _snapshot.MaximumMergeRoots)
+                        {
+                            _snapshot.MaximumMergeRoots = roots;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Records end of a consolidation.
+                    /// </summary>
+                    void OnMergeFinished() noexcept
+                    {
+                        if (_snapshot.LastMergeLinks > _snapshot.MaximumMergeLinks)
+                        {
+                            _snapshot.MaximumMergeLinks = _snapshot.LastMergeLinks;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Gets the counters.
+                    /// </summary>
+                    /// <returns>Copy of the counters.</returns>
+                    HeapStatisticsSnapshot Snapshot() const noexcept
+                    {
+                        return _snapshot;
+                    }
+
+                private:
+                    /// <summary>
+                    /// The counters.
+                    /// </summary>
+                    HeapStatisticsSnapshot _snapshot;
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,189 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_ORDEREDHEAPITERATOR_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_ORDEREDHEAPITERATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Heaps
+            {
+                /// <summary>
+                /// Read-only iterator that visits keys of a heap in ascending order without modifying the heap.
+                /// Keeps an auxiliary heap of candidate nodes: a node becomes a candidate once its parent was visited.
+                /// Visiting k keys costs O((r + c) log n), where r is the number of roots and c the total number of
+                /// children of the visited nodes. A consolidated FibonacciHeap has O(log n) children per node, but
+                /// the root of a PairingHeap can have O(n) of them, all pushed when the first key is visited.
+                /// The heap provides TraversalNode, SeedTraversal, ExpandTraversal and TraversalKey, and has to
+                /// stay unchanged while the iterator is used.
+                /// </summary>
+                template<class THeap>
+                class OrderedHeapIterator
+                {
+                public:
+                    typedef std::input_iterator_tag iterator_category;
+                    typedef typename THeap::ValueType value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef const value_type * pointer;
+                    typedef const value_type & reference;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class which is the end of every traversal.
+                    /// </summary>
+                    OrderedHeapIterator()
+                        : _heap(nullptr)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class which points to the minimum of the heap.
+                    /// </summary>
+                    /// <param name="heap">The heap.</param>
+                    explicit OrderedHeapIterator(const THeap * heap)
+                        : _heap(heap)
+                    {
+                        _heap->SeedTraversal(_candidates);
+                        std::make_heap(_candidates.begin(), _candidates.end(), Later(_heap));
+                    }
+
+                    /// <summary>
+                    /// Gets the current key.
+                    /// </summary>
+                    /// <returns>The key.</returns>
+                    reference operator*() const
+                    {
+                        return _heap->TraversalKey(_candidates.front());
+                    }
+
+                    /// <summary>
+                    /// Gets the current key.
+                    /// </summary>
+                    /// <returns>Pointer to the key.</returns>
+                    pointer operator->() const
+                    {
+                        return &_heap->TraversalKey(_candidates.front());
+                    }
+
+                    /// <summary>
+                    /// Moves to the next key.
+                    /// </summary>
+                    /// <returns>Reference to itself.</returns>
+                    OrderedHeapIterator<THeap> & operator++()
+                    {
+                        Later later(_heap);
+                        typename THeap::TraversalNode node = _candidates.front();
+
+                        std::pop_heap(_candidates.begin(), _candidates.end(), later);
+                        _candidates.pop_back();
+
+                        std::size_t size = _candidates.size();
+
+                        _heap->ExpandTraversal(node, _candidates);
+
+                        for (std::size_t i = size; i < _candidates.size(); ++i)
+                        {
+                            std::push_heap(_candidates.begin(), _candidates.begin() + i + 1, later);
+                        }
+
+                        return *this;
+                    }
+
+                    /// <summary>
+                    /// Moves to the next key.
+                    /// </summary>
+                    /// <returns>Copy of the iterator before the move.</returns>
+                    OrderedHeapIterator<THeap> operator++(int)
+                    {
+                        OrderedHeapIterator<THeap> copy(*this);
+                        ++(*this);
+                        return copy;
+                    }
+
+                    /// <summary>
+                    /// Compares iterators.
+                    /// </summary>
+                    /// <param name="other">Another iterator.</param>
+                    /// <returns>True if both are at the end or at the same node.</returns>
+                    bool operator==(const OrderedHeapIterator<THeap> & other) const
+                    {
+                        if (_candidates.empty() || other._candidates.empty())
+                        {
+                            return _candidates.empty() && other._candidates.empty();
+                        }
+
+                        return _heap == other._heap && _candidates.front() == other._candidates.front();
+                    }
+
+                    /// <summary>
+                    /// Compares iterators.
+                    /// </summary>
+                    /// <param name="other">Another iterator.</param>
+                    /// <returns>True if iterators differ.</returns>
+                    bool operator!=(const OrderedHeapIterator<THeap> & other) const
+                    {
+                        return !(*this == other);
+                    }
+
+                private:
+                    /// <summary>
+                    /// Orders candidates so that std heap algorithms keep the smallest key in front.
+                    /// </summary>
+                    struct Later
+                    {
+                        explicit Later(const THeap * heap)
+                            : Heap(heap)
+                        {
+                        }
+
+                        bool operator()(typename THeap::TraversalNode left, typename THeap::TraversalNode right) const
+                        {
+                            return Heap->TraversalBefore(right, left);
+                        }
+
+                        const THeap * Heap;
+                    };
+
+                    /// <summary>
+                    /// The heap.
+                    /// </summary>
+                    const THeap * _heap;
+
+                    /// <summary>
+                    /// Nodes whose parents have been visited.
+                    /// </summary>
+                    std::vector<typename THeap::TraversalNode> _candidates;
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,850 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_PAIRINGHEAP_PAIRINGHEAP_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_PAIRINGHEAP_PAIRINGHEAP_HPP
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "../OrderedHeapIterator.hpp"
+#include "../SplitMode.hpp"
+#include "../Storage/SlabNodeStorage.hpp"
+#include "PairingHeapItem.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Heaps
+            {
+                namespace PairingHeap
+                {
+                    /// <summary>
+                    /// The pairing heap with two-pass merging.
+                    /// Handle returned by Push stays valid until the element is erased. Keys are ordered by TCompare, smallest first.
+                    /// </summary>
+                    template<class T, class TCompare = std::less<T>, class TStorage = Storage::SlabNodeStorage<PairingHeapItem<T>>>
+                    class PairingHeap
+                    {
+                    public:
+                        /// <summary>
+                        /// Handle to an element of the heap.
+                        /// </summary>
+                        typedef PairingHeapItem<T> * Handle;
+
+                        /// <summary>
+                        /// Type of stored keys.
+                        /// </summary>
+                        typedef T ValueType;
+
+                        /// <summary>
+                        /// Iterator over keys in ascending order, see OrderedHeapIterator.
+                        /// </summary>
+                        typedef OrderedHeapIterator<PairingHeap<T, TCompare, TStorage>> OrderedIterator;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        PairingHeap()
+                            : _size(0)
+                            , _root(nullptr)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="compare">Key comparer.</param>
+                        explicit PairingHeap(const TCompare & compare)
+                            : _size(0)
+                            , _root(nullptr)
+                            , _compare(compare)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="other">Heap to copy.</param>
+                        PairingHeap(const PairingHeap<T, TCompare, TStorage> & other)
+                            : _size(0)
+                            , _root(nullptr)
+                            , _compare(other._compare)
+                        {
+                            CopyFrom(other);
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="other">Heap to move.</param>
+                        PairingHeap(PairingHeap<T, TCompare, TStorage> && other) noexcept
+                            : _size(other._size)
+                            , _root(other._root)
+                            , _compare(std::move(other._compare))
+                            , _storage(std::move(other._storage))
+                        {
+                            other._size = 0;
+                            other._root = nullptr;
+                        }
+
+                        /// <summary>
+                        /// Assigns another heap.
+                        /// </summary>
+                        /// <param name="other">Heap to copy.</param>
+                        /// <returns>Reference to itself.</returns>
+                        PairingHeap<T, TCompare, TStorage> & operator=(const PairingHeap<T, TCompare, TStorage> & other)
+                        {
+                            if (this != &other)
+                            {
+                                Clear();
+                                _compare = other._compare;
+                                CopyFrom(other);
+                            }
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Assigns another heap.
+                        /// </summary>
+                        /// <param name="other">Heap to move.</param>
+                        /// <returns>Reference to itself.</returns>
+                        PairingHeap<T, TCompare, TStorage> & operator=(PairingHeap<T, TCompare, TStorage> && other) noexcept
+                        {
+                            if (this != &other)
+                            {
+                                Clear();
+
+                                _size = other._size;
+                                _root = other._root;
+                                _compare = std::move(other._compare);
+                                _storage = std::move(other._storage);
+
+                                other._size = 0;
+                                other._root = nullptr;
+                            }
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Destructs the instance of this class.
+                        /// </summary>
+                        ~PairingHeap()
+                        {
+                            Clear();
+                        }
+
+                        /// <summary>
+                        /// Indicates whether heap is empty.
+                        /// </summary>
+                        /// <returns>True if heap is empty, false otherwise.</returns>
+                        bool Empty() const
+                        {
+                            return _size == 0;
+                        }
+
+                        /// <summary>
+                        /// Returns heap size.
+                        /// </summary>
+                        /// <returns>The size.</returns>
+                        unsigned int Size() const noexcept
+                        {
+                            return _size;
+                        }
+
+                        /// <summary>
+                        /// Returns top value.
+                        /// </summary>
+                        /// <returns>The value of top.</returns>
+                        const T & Top() const
+                        {
+                            return _root->Key;
+                        }
+
+                        /// <summary>
+                        /// Returns key of the element.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <returns>The key.</returns>
+                        const T & Get(Handle handle) const
+                        {
+                            return handle->Key;
+                        }
+
+                        /// <summary>
+                        /// Pushes the key.
+                        /// </summary>
+                        /// <param name="key">The key.</param>
+                        /// <returns>Handle of pushed item, valid until the item is erased.</returns>
+                        Handle Push(T key)
+                        {
+                            PairingHeapItem<T> * item = _storage.Create(std::move(key));
+                            Insert(item);
+                            return item;
+                        }
+
+                        /// <summary>
+                        /// Constructs the key in place and pushes it.
+                        /// </summary>
+                        /// <param name="args">Arguments of the key constructor.</param>
+                        /// <returns>Handle of the element.</returns>
+                        template<typename... TArgs>
+                        Handle Emplace(TArgs &&... args)
+                        {
+                            PairingHeapItem<T> * item = _storage.Create(std::piecewise_construct, std::forward<TArgs>(args)...);
+                            Insert(item);
+                            return item;
+                        }
+
+                        /// <summary>
+                        /// Pushes all keys of the range in O(n). Nodes for the whole range are allocated at once.
+                        /// </summary>
+                        /// <param name="first">Beginning of the range.</param>
+                        /// <param name="last">End of the range.</param>
+                        template<typename TIterator>
+                        void PushRange(TIterator first, TIterator last)
+                        {
+                            _storage.Reserve(static_cast<std::size_t>(std::distance(first, last)));
+
+                            for (; first != last; ++first)
+                            {
+                                Insert(_storage.Create(*first));
+                            }
+                        }
+
+                        /// <summary>
+                        /// Pops the top node.
+                        /// </summary>
+                        void Pop()
+                        {
+                            if (Empty())
+                            {
+                                return;
+                            }
+
+                            EraseMinimum();
+                        }
+
+                        /// <summary>
+                        /// Erases minimum node.
+                        /// </summary>
+                        /// <returns>The key of erased node.</returns>
+                        T EraseMinimum()
+                        {
+                            if (_root == nullptr)
+                            {
+                                throw std::exception("You can't erase minimum of empty heap.");
+                            }
+
+                            return Erase(_root);
+                        }
+
+                        /// <summary>
+                        /// Erases the element. The handle is invalid afterwards.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <returns>The key of erased element.</returns>
+                        T Erase(Handle handle)
+                        {
+                            Extract(handle);
+
+                            T key = std::move(handle->Key);
+
+                            _storage.Destroy(handle);
+
+                            return key;
+                        }
+
+                        /// <summary>
+                        /// Decreases the key of the element.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <param name="key">The new key, can't be greater than the current one.</param>
+                        void DecreaseKey(Handle handle, T key)
+                        {
+                            if (_compare(handle->Key, key))
+                            {
+                                throw std::exception("Current key is lower than new key.");
+                            }
+
+                            handle->Key = std::move(key);
+
+                            if (handle != _root)
+                            {
+                                Cut(handle);
+                                _root = Meld(_root, handle);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Changes the key of the element. The handle stays valid.
+                        /// </summary>
+                        /// <param name="handle">Handle of the element.</param>
+                        /// <param name="key">The new key.</param>
+                        void Update(Handle handle, T key)
+                        {
+                            if (!_compare(handle->Key, key))
+                            {
+                                DecreaseKey(handle, std::move(key));
+                                return;
+                            }
+
+                            Extract(handle);
+
+                            handle->Key = std::move(key);
+
+                            Insert(handle);
+                        }
+
+                        /// <summary>
+                        /// Moves all elements of another heap into this heap. The other heap is left empty.
+                        /// </summary>
+                        /// <param name="other">Another heap.</param>
+                        void Join(PairingHeap<T, TCompare, TStorage> & other)
+                        {
+                            if (this == &other)
+                            {
+                                return;
+                            }
+
+                            _storage.Adopt(other._storage);
+
+                            if (other._root != nullptr)
+                            {
+                                _root = _root == nullptr ? other._root : Meld(_root, other._root);
+                            }
+
+                            _size += other._size;
+
+                            other._root = nullptr;
+                            other._size = 0;
+                        }
+
+                        /// <summary>
+                        /// Clears whole heap.
+                        /// </summary>
+                        void Clear()
+                        {
+                            PairingHeapItem<T> * current = _root;
+
+                            while (current != nullptr)
+                            {
+                                PairingHeapItem<T> * next = current->Next;
+
+                                if (current->Child != nullptr)
+                                {
+                                    PairingHeapItem<T> * tail = current->Child;
+
+                                    while (tail->Next != nullptr)
+                                    {
+                                        tail = tail->Next;
+                                    }
+
+                                    tail->Next = next;
+                                    next = current->Child;
+                                }
+
+                                _storage.Destroy(current);
+
+                                current = next;
+                            }
+
+                            _root = nullptr;
+                            _size = 0;
+                        }
+
+                        /// <summary>
+                        /// Moves half of the items into another heap by detaching whole subtrees, so nodes are not copied.
+                        /// ByCount takes the largest subtrees that fit, Interleaved spreads subtrees from the whole key range
+                        /// between both heaps. Pairing heap keeps no subtree sizes, so they are counted in O(n).
+                        /// Handles of moved items stay valid and belong to the other heap, which shares node storage with this one.
+                        /// </summary>
+                        /// <param name="other">Heap that receives the items.</param>
+                        /// <param name="mode">How to choose moved items.</param>
+                        void Split(PairingHeap<T, TCompare, TStorage> & other, SplitMode mode = ByCount)
+                        {
+                            if (this == &other || _size < 2)
+                            {
+                                return;
+                            }
+
+                            other._storage.Share(_storage);
+
+                            std::vector<Subtree> trees;
+
+                            AddChildren(_root, trees);
+
+                            unsigned count = _size / 2;
+
+                            if (mode == Interleaved)
+                            {
+                                std::sort(trees.begin(), trees.end(), [this](const Subtree & left, const Subtree & right)
+                                {
+                                    return _compare(left.first->Key, right.first->Key);
+                                });
+
+                                unsigned moved = 0;
+                                unsigned kept = 0;
+                                std::size_t remaining = 0;
+
+                                for (std::size_t i = 0; i < trees.size(); ++i)
+                                {
+                                    if (moved <= kept && moved + trees[i].second <= count)
+                                    {
+                                        moved += trees[i].second;
+                                        MoveTree(trees[i], other);
+                                    }
+                                    else
+                                    {
+                                        kept += trees[i].second;
+                                        trees[remaining++] = trees[i];
+                                    }
+                                }
+
+                                trees.resize(remaining);
+                                count -= moved;
+                            }
+
+                            while (count > 0)
+                            {
+                                std::size_t fit = trees.size();
+                                std::size_t over = trees.size();
+
+                                for (std::size_t i = 0; i < trees.size(); ++i)
+                                {
+                                    if (trees[i].second <= count)
+                                    {
+                                        if (fit == trees.size() || trees[i].second > trees[fit].second)
+                                        {
+                                            fit = i;
+                                        }
+                                    }
+                                    else if (over == trees.size() || trees[i].second < trees[over].second)
+                                    {
+                                        over = i;
+                                    }
+                                }
+
+                                if (fit != trees.size())
+                                {
+                                    Subtree tree = trees[fit];
+
+                                    trees[fit] = trees.back();
+                                    trees.pop_back();
+
+                                    count -= tree.second;
+                                    MoveTree(tree, other);
+                                }
+                                else
+                                {
+                                    // Children of the subtree become children of the root, the subtree is left as a leaf.
+                                    PairingHeapItem<T> * node = trees[over].first;
+
+                                    trees[over].second = 1;
+
+                                    while (node->Child != nullptr)
+                                    {
+                                        PairingHeapItem<T> * child = node->Child;
+
+                                        Cut(child);
+
+                                        child->Next = _root->Child;
+                                        child->Prev = _root;
+                                        _root->Child->Prev = child;
+                                        _root->Child = child;
+
+                                        trees.push_back(Subtree(child, CountNodes(child)));
+                                    }
+                                }
+                            }
+                        }
+
+                        /// <summary>
+                        /// Gets iterator to the minimum. Keys are visited in ascending order without modifying the heap,
+                        /// the heap can't be modified while the iterator is used.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        OrderedIterator OrderedBegin() const
+                        {
+                            return OrderedIterator(this);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator past the maximum.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        OrderedIterator OrderedEnd() const
+                        {
+                            return OrderedIterator();
+                        }
+
+                        /// <summary>
+                        /// Copies up to count smallest keys in ascending order without modifying the heap.
+                        /// </summary>
+                        /// <param name="count">Number of keys.</param>
+                        /// <returns>The keys.</returns>
+                        std::vector<T> PeekTopK(std::size_t count) const
+                        {
+                            std::vector<T> result;
+
+                            result.reserve(count < Size() ? count : Size());
+
+                            for (OrderedIterator it = OrderedBegin(), end = OrderedEnd(); it != end && result.size() < count; ++it)
+                            {
+                                result.push_back(*it);
+                            }
+
+                            return result;
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Child of the root with the number of its items.
+                        /// </summary>
+                        typedef std::pair<PairingHeapItem<T> *, unsigned> Subtree;
+
+                        /// <summary>
+                        /// Heap size.
+                        /// </summary>
+                        unsigned int _size;
+
+                        /// <summary>
+                        /// Root pointer.
+                        /// </summary>
+                        PairingHeapItem<T> * _root;
+
+                        /// <summary>
+                        /// Key comparer.
+                        /// </summary>
+                        TCompare _compare;
+
+                        /// <summary>
+                        /// Owner of the nodes.
+                        /// </summary>
+                        TStorage _storage;
+
+                        /// <summary>
+                        /// Inserts the node.
+                        /// </summary>
+                        /// <param name="item">Node to insert.</param>
+                        void Insert(PairingHeapItem<T> * item)
+                        {
+                            item->Child = nullptr;
+                            item->Next = nullptr;
+                            item->Prev = nullptr;
+
+                            _root = _root == nullptr ? item : Meld(_root, item);
+
+                            ++_size;
+                        }
+
+                        /// <summary>
+                        /// Unlinks the node without destroying it.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        void Extract(PairingHeapItem<T> * node)
+                        {
+                            PairingHeapItem<T> * subtree = MergePairs(node->Child);
+
+                            node->Child = nullptr;
+
+                            if (node == _root)
+                            {
+                                _root = subtree;
+                            }
+                            else
+                            {
+                                Cut(node);
+
+                                if (subtree != nullptr)
+                                {
+                                    _root = Meld(_root, subtree);
+                                }
+                            }
+
+                            --_size;
+                        }
+
+                        /// <summary>
+                        /// Adds children of the node with sizes of their subtrees.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        /// <param name="trees">Receives the children.</param>
+                        void AddChildren(PairingHeapItem<T> * node, std::vector<Subtree> & trees) const
+                        {
+                            for (PairingHeapItem<T> * child = node->Child; child != nullptr; child = child->Next)
+                            {
+                                trees.push_back(Subtree(child, CountNodes(child)));
+                            }
+                        }
+
+                        /// <summary>
+                        /// Counts items in the subtree of the node.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        /// <returns>Number of items.</returns>
+                        unsigned CountNodes(const PairingHeapItem<T> * node) const
+                        {
+                            unsigned count = 0;
+                            std::vector<const PairingHeapItem<T> *> pending(1, node);
+
+                            while (!pending.empty())
+                            {
+                                const PairingHeapItem<T> * current = pending.back();
+                                pending.pop_back();
+
+                                for (const PairingHeapItem<T> * child = current->Child; child != nullptr; child = child->Next)
+                                {
+                                    pending.push_back(child);
+                                }
+
+                                ++count;
+                            }
+
+                            return count;
+                        }
+
+                        /// <summary>
+                        /// Moves the child of the root with its subtree to another heap.
+                        /// </summary>
+                        /// <param name="tree">The subtree.</param>
+                        /// <param name="other">Another heap.</param>
+                        void MoveTree(const Subtree & tree, PairingHeap<T, TCompare, TStorage> & other)
+                        {
+                            Cut(tree.first);
+
+                            other._root = other._root == nullptr ? tree.first : other.Meld(other._root, tree.first);
+
+                            _size -= tree.second;
+                            other._size += tree.second;
+                        }
+
+                        /// <summary>
+                        /// Links two roots, the greater one becomes the leftmost child of the other.
+                        /// </summary>
+                        /// <param name="left">The first root.</param>
+                        /// <param name="right">The second root.</param>
+                        /// <returns>The new root.</returns>
+                        PairingHeapItem<T> * Meld(PairingHeapItem<T> * left, PairingHeapItem<T> * right)
+                        {
+                            if (_compare(right->Key, left->Key))
+                            {
+                                std::swap(left, right);
+                            }
+
+                            right->Next = left->Child;
+
+                            if (left->Child != nullptr)
+                            {
+                                left->Child->Prev = right;
+                            }
+
+                            right->Prev = left;
+                            left->Child = right;
+                            left->Next = nullptr;
+                            left->Prev = nullptr;
+
+                            return left;
+                        }
+
+                        /// <summary>
+                        /// Detaches the node with its subtree from the parent.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        void Cut(PairingHeapItem<T> * node)
+                        {
+                            if (node->Prev->Child == node)
+                            {
+                                node->Prev->Child = node->Next;
+                            }
+                            else
+                            {
+                                node->Prev->Next = node->Next;
+                            }
+
+                            if (node->Next != nullptr)
+                            {
+                                node->Next->Prev = node->Prev;
+                            }
+
+                            node->Next = nullptr;
+                            node->Prev = nullptr;
+                        }
+
+                        /// <summary>
+                        /// Merges list of siblings into one tree with the two-pass method.
+                        /// </summary>
+                        /// <param name="first">The first sibling.</param>
+                        /// <returns>The root of merged tree.</returns>
+                        PairingHeapItem<T> * MergePairs(PairingHeapItem<T> * first)
+                        {
+                            if (first == nullptr)
+                            {
+                                return nullptr;
+                            }
+
+                            PairingHeapItem<T> * pairs = nullptr;
+
+                            while (first != nullptr)
+                            {
+                                PairingHeapItem<T> * left = first;
+                                PairingHeapItem<T> * right = first->Next;
+                                PairingHeapItem<T> * melded = left;
+
+                                if (right != nullptr)
+                                {
+                                    first = right->Next;
+
+                                    left->Next = nullptr;
+                                    right->Next = nullptr;
+
+                                    melded = Meld(left, right);
+                                }
+                                else
+                                {
+                                    first = nullptr;
+                                }
+
+                                melded->Prev = nullptr;
+                                melded->Next = pairs;
+                                pairs = melded;
+                            }
+
+                            PairingHeapItem<T> * result = pairs;
+
+                            pairs = pairs->Next;
+                            result->Next = nullptr;
+
+                            while (pairs != nullptr)
+                            {
+                                PairingHeapItem<T> * next = pairs->Next;
+
+                                pairs->Next = nullptr;
+                                result = Meld(result, pairs);
+
+                                pairs = next;
+                            }
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Pushes keys of all nodes of another heap.
+                        /// </summary>
+                        /// <param name="other">Another heap.</param>
+                        void CopyFrom(const PairingHeap<T, TCompare, TStorage> & other)
+                        {
+                            if (other._root == nullptr)
+                            {
+                                return;
+                            }
+
+                            std::vector<const PairingHeapItem<T> *> pending;
+                            pending.push_back(other._root);
+
+                            while (!pending.empty())
+                            {
+                                const PairingHeapItem<T> * current = pending.back();
+
+                                pending.pop_back();
+
+                                for (; current != nullptr; current = current->Next)
+                                {
+                                    Push(current->Key);
+
+                                    if (current->Child != nullptr)
+                                    {
+                                        pending.push_back(current->Child);
+                                    }
+                                }
+                            }
+                        }
+
+                        friend class OrderedHeapIterator<PairingHeap<T, TCompare, TStorage>>;
+
+                        /// <summary>
+                        /// Node visited by OrderedHeapIterator.
+                        /// </summary>
+                        typedef const PairingHeapItem<T> * TraversalNode;
+
+                        /// <summary>
+                        /// Adds nodes that start ordered traversal.
+                        /// </summary>
+                        /// <param name="nodes">Traversal candidates.</param>
+                        void SeedTraversal(std::vector<TraversalNode> & nodes) const
+                        {
+                            if (_root != nullptr)
+                            {
+                                nodes.push_back(_root);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Adds children of the visited node.
+                        /// </summary>
+                        /// <param name="node">Visited node.</param>
+                        /// <param name="nodes">Traversal candidates.</param>
+                        void ExpandTraversal(TraversalNode node, std::vector<TraversalNode> & nodes) const
+                        {
+                            for (const PairingHeapItem<T> * child = node->Child; child != nullptr; child = child->Next)
+                            {
+                                nodes.push_back(child);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Gets key of the node.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        /// <returns>The key.</returns>
+                        const T & TraversalKey(TraversalNode node) const
+                        {
+                            return node->Key;
+                        }
+
+                        /// <summary>
+                        /// Compares keys of the nodes.
+                        /// </summary>
+                        /// <param name="left">Left node.</param>
+                        /// <param name="right">Right node.</param>
+                        /// <returns>True if left key goes first.</returns>
+                        bool TraversalBefore(TraversalNode left, TraversalNode right) const
+                        {
+                            return _compare(TraversalKey(left), TraversalKey(right));
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
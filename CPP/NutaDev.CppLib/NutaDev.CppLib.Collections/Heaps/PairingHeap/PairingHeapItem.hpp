@@ -0,0 +1,96 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_PAIRINGHEAP_PAIRINGHEAPITEM_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_PAIRINGHEAP_PAIRINGHEAPITEM_HPP
+
+#include <utility>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Heaps
+            {
+                namespace PairingHeap
+                {
+                    /// <summary>
+                    /// Element of pairing heap.
+                    /// </summary>
+                    template <typename T>
+                    class PairingHeapItem
+                    {
+                    public:
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="key">Item key</param>
+                        PairingHeapItem(T key)
+                            : Key(std::move(key))
+                            , Child(nullptr)
+                            , Next(nullptr)
+                            , Prev(nullptr)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, constructs the key in place.
+                        /// </summary>
+                        /// <param name="args">Arguments of the key constructor.</param>
+                        template<typename... TArgs>
+                        explicit PairingHeapItem(std::piecewise_construct_t, TArgs &&... args)
+                            : Key(std::forward<TArgs>(args)...)
+                            , Child(nullptr)
+                            , Next(nullptr)
+                            , Prev(nullptr)
+                        {
+                        }
+
+                        /// <summary>
+                        /// The key.
+                        /// </summary>
+                        T Key;
+
+                        /// <summary>
+                        /// The leftmost child.
+                        /// </summary>
+                        PairingHeapItem<T> * Child;
+
+                        /// <summary>
+                        /// Next sibling.
+                        /// </summary>
+                        PairingHeapItem<T> * Next;
+
+                        /// <summary>
+                        /// Previous sibling, or parent for the leftmost child.
+                        /// </summary>
+                        PairingHeapItem<T> * Prev;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
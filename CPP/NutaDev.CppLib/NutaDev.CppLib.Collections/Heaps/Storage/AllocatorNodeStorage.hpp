@@ -0,0 +1,193 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_STORAGE_ALLOCATORNODESTORAGE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_STORAGE_ALLOCATORNODESTORAGE_HPP
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Heaps
+            {
+                namespace Storage
+                {
+                    /// <summary>
+                    /// Node storage that allocates every node with TAllocator, rebound to the node type, e.g.
+                    /// Memory::PoolAllocator or Memory::ArenaAllocator. Nodes can move only between storages with equal
+                    /// allocators. A storage that has never held a node takes over the allocator of a used one.
+                    /// </summary>
+                    template<typename TNode, typename TAllocator = std::allocator<TNode>>
+                    class AllocatorNodeStorage
+                    {
+                    public:
+                        /// <summary>
+                        /// Allocator of nodes.
+                        /// </summary>
+                        typedef typename std::allocator_traits<TAllocator>::template rebind_alloc<TNode> NodeAllocator;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        AllocatorNodeStorage()
+                            : _allocationCount(0)
+                            , _used(false)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="allocator">Allocator of nodes.</param>
+                        explicit AllocatorNodeStorage(const TAllocator & allocator)
+                            : _allocator(allocator)
+                            , _allocationCount(0)
+                            , _used(false)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Constructs a node.
+                        /// </summary>
+                        /// <param name="args">Node constructor arguments.</param>
+                        /// <returns>The node.</returns>
+                        template<typename... TArgs>
+                        TNode * Create(TArgs &&... args)
+                        {
+                            TNode * node = std::allocator_traits<NodeAllocator>::allocate(_allocator, 1);
+
+                            try
+                            {
+                                std::allocator_traits<NodeAllocator>::construct(_allocator, node, std::forward<TArgs>(args)...);
+                            }
+                            catch (...)
+                            {
+                                std::allocator_traits<NodeAllocator>::deallocate(_allocator, node, 1);
+                                throw;
+                            }
+
+                            ++_allocationCount;
+                            _used = true;
+
+                            return node;
+                        }
+
+                        /// <summary>
+                        /// Destroys the node.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        void Destroy(TNode * node)
+                        {
+                            std::allocator_traits<NodeAllocator>::destroy(_allocator, node);
+                            std::allocator_traits<NodeAllocator>::deallocate(_allocator, node, 1);
+                        }
+
+                        /// <summary>
+                        /// Does nothing, nodes are allocated one by one.
+                        /// </summary>
+                        /// <param name="count">Number of nodes.</param>
+                        void Reserve(std::size_t /*count*/)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Makes sure that nodes of another storage can be destroyed by this one.
+                        /// </summary>
+                        /// <param name="other">Another storage.</param>
+                        void Adopt(AllocatorNodeStorage<TNode, TAllocator> & other)
+                        {
+                            Share(other);
+                        }
+
+                        /// <summary>
+                        /// Makes sure that nodes of another storage can be destroyed by this one.
+                        /// </summary>
+                        /// <param name="other">Another storage.</param>
+                        void Share(const AllocatorNodeStorage<TNode, TAllocator> & other)
+                        {
+                            // A storage that has never held a node hands over no nodes, so its allocator doesn't matter.
+                            if (this == &other || !other._used)
+                            {
+                                return;
+                            }
+
+                            if (!(_allocator == other._allocator))
+                            {
+                                if (_used)
+                                {
+                                    throw std::exception("Nodes can't be moved between storages with different allocators.");
+                                }
+
+                                _allocator = other._allocator;
+                            }
+
+                            _used = true;
+                        }
+
+                        /// <summary>
+                        /// Gets allocator of nodes.
+                        /// </summary>
+                        /// <returns>The allocator.</returns>
+                        NodeAllocator GetAllocator() const
+                        {
+                            return _allocator;
+                        }
+
+                        /// <summary>
+                        /// Gets number of nodes this storage has ever allocated.
+                        /// </summary>
+                        /// <returns>Number of allocations.</returns>
+                        std::size_t AllocationCount() const noexcept
+                        {
+                            return _allocationCount;
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Allocator of nodes.
+                        /// </summary>
+                        NodeAllocator _allocator;
+
+                        /// <summary>
+                        /// Number of allocated nodes.
+                        /// </summary>
+                        std::size_t _allocationCount;
+
+                        /// <summary>
+                        /// Indicates whether the storage has created or received a node.
+                        /// </summary>
+                        bool _used;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,123 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_STORAGE_DYNAMICNODESTORAGE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_STORAGE_DYNAMICNODESTORAGE_HPP
+
+#include <cstddef>
+#include <utility>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Heaps
+            {
+                namespace Storage
+                {
+                    /// <summary>
+                    /// Node storage that allocates every node separately with global new.
+                    /// </summary>
+                    template<typename TNode>
+                    class DynamicNodeStorage
+                    {
+                    public:
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        DynamicNodeStorage()
+                            : _allocationCount(0)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Constructs a node.
+                        /// </summary>
+                        /// <param name="args">Node constructor arguments.</param>
+                        /// <returns>The node.</returns>
+                        template<typename... TArgs>
+                        TNode * Create(TArgs &&... args)
+                        {
+                            TNode * node = new TNode(std::forward<TArgs>(args)...);
+
+                            ++_allocationCount;
+
+                            return node;
+                        }
+
+                        /// <summary>
+                        /// Destroys the node.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        void Destroy(TNode * node)
+                        {
+                            delete node;
+                        }
+
+                        /// <summary>
+                        /// Does nothing, nodes are allocated one by one.
+                        /// </summary>
+                        /// <param name="count">Number of nodes.</param>
+                        void Reserve(std::size_t /*count*/)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Does nothing, every node owns its memory.
+                        /// </summary>
+                        /// <param name="other">Another storage.</param>
+                        void Adopt(DynamicNodeStorage<TNode> & /*other*/)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Does nothing, every node owns its memory.
+                        /// </summary>
+                        /// <param name="other">Another storage.</param>
+                        void Share(const DynamicNodeStorage<TNode> & /*other*/)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Gets number of nodes this storage has ever allocated.
+                        /// </summary>
+                        /// <returns>Number of allocations.</returns>
+                        std::size_t AllocationCount() const noexcept
+                        {
+                            return _allocationCount;
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Number of allocated nodes.
+                        /// </summary>
+                        std::size_t _allocationCount;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
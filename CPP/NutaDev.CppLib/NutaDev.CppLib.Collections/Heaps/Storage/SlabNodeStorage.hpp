@@ -0,0 +1,438 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_HEAPS_STORAGE_SLABNODESTORAGE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_HEAPS_STORAGE_SLABNODESTORAGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Heaps
+            {
+                namespace Storage
+                {
+                    /// <summary>
+                    /// Node storage that keeps nodes in contiguous chunks owned by the container.
+                    /// Released nodes are recycled through an intrusive free list, so steady state
+                    /// push and pop do not touch the global allocator. Node addresses are stable
+                    /// until the node is destroyed.
+                    /// Chunks are reference counted, so several storages can share them after a container
+                    /// hands some of its nodes to another one. Every storage keeps its own free list.
+                    /// </summary>
+                    template<typename TNode>
+                    class SlabNodeStorage
+                    {
+                    public:
+                        /// <summary>
+                        /// Number of nodes in the first chunk.
+                        /// </summary>
+                        static const std::size_t InitialChunkSize = 64;
+
+                        /// <summary>
+                        /// Upper bound of nodes in a chunk allocated by growth.
+                        /// </summary>
+                        static const std::size_t MaximumChunkSize = 65536;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        SlabNodeStorage()
+                            : _freeList(nullptr)
+                            , _freeTail(nullptr)
+                            , _cursor(nullptr)
+                            , _end(nullptr)
+                            , _nextChunkSize(InitialChunkSize)
+                            , _allocationCount(0)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Storage can't be copied, nodes are owned by exactly one container.
+                        /// </summary>
+                        SlabNodeStorage(const SlabNodeStorage<TNode> & other) = delete;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="other">Storage to move.</param>
+                        SlabNodeStorage(SlabNodeStorage<TNode> && other) noexcept
+                            : _chunks(std::move(other._chunks))
+                            , _spareRanges(std::move(other._spareRanges))
+                            , _freeList(other._freeList)
+                            , _freeTail(other._freeTail)
+                            , _cursor(other._cursor)
+                            , _end(other._end)
+                            , _nextChunkSize(other._nextChunkSize)
+                            , _allocationCount(other._allocationCount)
+                        {
+                            other.Reset();
+                        }
+
+                        /// <summary>
+                        /// Storage can't be copied, nodes are owned by exactly one container.
+                        /// </summary>
+                        SlabNodeStorage<TNode> & operator=(const SlabNodeStorage<TNode> & other) = delete;
+
+                        /// <summary>
+                        /// Assigns another storage.
+                        /// </summary>
+                        /// <param name="other">Storage to move.</param>
+                        /// <returns>Reference to itself.</returns>
+                        SlabNodeStorage<TNode> & operator=(SlabNodeStorage<TNode> && other) noexcept
+                        {
+                            if (this != &other)
+                            {
+                                _chunks = std::move(other._chunks);
+                                _spareRanges = std::move(other._spareRanges);
+                                _freeList = other._freeList;
+                                _freeTail = other._freeTail;
+                                _cursor = other._cursor;
+                                _end = other._end;
+                                _nextChunkSize = other._nextChunkSize;
+                                _allocationCount = other._allocationCount;
+
+                                other.Reset();
+                            }
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Destructs the instance of this class. Nodes have to be destroyed by the owner first.
+                        /// </summary>
+                        ~SlabNodeStorage()
+                        {
+                        }
+
+                        /// <summary>
+                        /// Constructs a node in the storage.
+                        /// </summary>
+                        /// <param name="args">Node constructor arguments.</param>
+                        /// <returns>The node.</returns>
+                        template<typename... TArgs>
+                        TNode * Create(TArgs &&... args)
+                        {
+                            Slot * slot = Acquire();
+
+                            try
+                            {
+                                return new (static_cast<void *>(&slot->Storage)) TNode(std::forward<TArgs>(args)...);
+                            }
+                            catch (...)
+                            {
+                                Recycle(slot);
+                                throw;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Destroys the node and returns its slot to the free list.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        void Destroy(TNode * node)
+                        {
+                            node->~TNode();
+                            Recycle(reinterpret_cast<Slot *>(node));
+                        }
+
+                        /// <summary>
+                        /// Makes sure that at least specified number of nodes can be created without growing more than once.
+                        /// </summary>
+                        /// <param name="count">Number of nodes.</param>
+                        void Reserve(std::size_t count)
+                        {
+                            std::size_t available = static_cast<std::size_t>(_end - _cursor);
+
+                            if (available >= count)
+                            {
+                                return;
+                            }
+
+                            AllocateChunk(count);
+                        }
+
+                        /// <summary>
+                        /// Takes over all chunks and free slots of another storage. Nodes created by the other storage
+                        /// become owned by this one and the other storage is left empty.
+                        /// Costs O(number of chunks), free slots are spliced, not visited.
+                        /// </summary>
+                        /// <param name="other">Another storage.</param>
+                        void Adopt(SlabNodeStorage<TNode> & other)
+                        {
+                            if (this == &other)
+                            {
+                                return;
+                            }
+
+                            ShareChunks(other._chunks);
+
+                            if (other._freeList != nullptr)
+                            {
+                                other._freeTail->Next = _freeList;
+
+                                if (_freeList == nullptr)
+                                {
+                                    _freeTail = other._freeTail;
+                                }
+
+                                _freeList = other._freeList;
+                            }
+
+                            _spareRanges.insert(_spareRanges.end(), other._spareRanges.begin(), other._spareRanges.end());
+
+                            if (other._cursor != other._end)
+                            {
+                                _spareRanges.push_back(std::make_pair(other._cursor, other._end));
+                            }
+
+                            other.Reset();
+                        }
+
+                        /// <summary>
+                        /// Becomes co-owner of all chunks of another storage, so nodes created by the other storage
+                        /// can be moved to the container of this one and destroyed here. Chunks are released
+                        /// when the last storage that shares them is destroyed.
+                        /// </summary>
+                        /// <param name="other">Another storage.</param>
+                        void Share(const SlabNodeStorage<TNode> & other)
+                        {
+                            if (this != &other)
+                            {
+                                ShareChunks(other._chunks);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Gets number of chunks owned or shared by this storage.
+                        /// </summary>
+                        /// <returns>Number of chunks.</returns>
+                        std::size_t ChunkCount() const noexcept
+                        {
+                            return _chunks.size();
+                        }
+
+                        /// <summary>
+                        /// Gets number of chunks this storage has ever requested from the global allocator.
+                        /// Unlike ChunkCount it never decreases, so it can be compared before and after an operation.
+                        /// </summary>
+                        /// <returns>Number of allocations.</returns>
+                        std::size_t AllocationCount() const noexcept
+                        {
+                            return _allocationCount;
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Memory of single node, reused as free list link when node is released.
+                        /// </summary>
+                        union Slot
+                        {
+                            /// <summary>
+                            /// Next free slot.
+                            /// </summary>
+                            Slot * Next;
+
+                            /// <summary>
+                            /// Node memory.
+                            /// </summary>
+                            typename std::aligned_storage<sizeof(TNode), alignof(TNode)>::type Storage;
+                        };
+
+                        /// <summary>
+                        /// Allocated or shared chunks, sorted by address.
+                        /// </summary>
+                        std::vector<std::shared_ptr<Slot>> _chunks;
+
+                        /// <summary>
+                        /// Never used slot ranges left behind by Reserve and Adopt.
+                        /// </summary>
+                        std::vector<std::pair<Slot *, Slot *>> _spareRanges;
+
+                        /// <summary>
+                        /// First released slot.
+                        /// </summary>
+                        Slot * _freeList;
+
+                        /// <summary>
+                        /// Last released slot.
+                        /// </summary>
+                        Slot * _freeTail;
+
+                        /// <summary>
+                        /// First never used slot of the current chunk.
+                        /// </summary>
+                        Slot * _cursor;
+
+                        /// <summary>
+                        /// End of the current chunk.
+                        /// </summary>
+                        Slot * _end;
+
+                        /// <summary>
+                        /// Size of the next chunk allocated by growth.
+                        /// </summary>
+                        std::size_t _nextChunkSize;
+
+                        /// <summary>
+                        /// Number of allocated chunks.
+                        /// </summary>
+                        std::size_t _allocationCount;
+
+                        /// <summary>
+                        /// Gets a free slot, grows the storage if required.
+                        /// </summary>
+                        /// <returns>The slot.</returns>
+                        Slot * Acquire()
+                        {
+                            if (_freeList != nullptr)
+                            {
+                                Slot * slot = _freeList;
+                                _freeList = slot->Next;
+
+                                if (_freeList == nullptr)
+                                {
+                                    _freeTail = nullptr;
+                                }
+
+                                return slot;
+                            }
+
+                            if (_cursor == _end)
+                            {
+                                if (!_spareRanges.empty())
+                                {
+                                    _cursor = _spareRanges.back().first;
+                                    _end = _spareRanges.back().second;
+                                    _spareRanges.pop_back();
+                                }
+                                else
+                                {
+                                    AllocateChunk(_nextChunkSize);
+
+                                    if (_nextChunkSize < MaximumChunkSize)
+                                    {
+                                        _nextChunkSize *= 2;
+                                    }
+                                }
+                            }
+
+                            return _cursor++;
+                        }
+
+                        /// <summary>
+                        /// Puts the slot on the free list.
+                        /// </summary>
+                        /// <param name="slot">The slot.</param>
+                        void Recycle(Slot * slot) noexcept
+                        {
+                            slot->Next = _freeList;
+
+                            if (_freeList == nullptr)
+                            {
+                                _freeTail = slot;
+                            }
+
+                            _freeList = slot;
+                        }
+
+                        /// <summary>
+                        /// Allocates a new chunk and makes it current. Unused tail of the previous chunk is kept as a spare range.
+                        /// </summary>
+                        /// <param name="size">Number of slots.</param>
+                        void AllocateChunk(std::size_t size)
+                        {
+                            std::shared_ptr<Slot> chunk(new Slot[size], std::default_delete<Slot[]>());
+
+                            ++_allocationCount;
+
+                            if (_cursor != _end)
+                            {
+                                _spareRanges.push_back(std::make_pair(_cursor, _end));
+                            }
+
+                            _cursor = chunk.get();
+                            _end = _cursor + size;
+
+                            _chunks.insert(std::upper_bound(_chunks.begin(), _chunks.end(), chunk, ChunkOrder), std::move(chunk));
+                        }
+
+                        /// <summary>
+                        /// Adds chunks that are not owned yet.
+                        /// </summary>
+                        /// <param name="chunks">Chunks sorted by address.</param>
+                        void ShareChunks(const std::vector<std::shared_ptr<Slot>> & chunks)
+                        {
+                            std::vector<std::shared_ptr<Slot>> merged;
+
+                            merged.reserve(_chunks.size() + chunks.size());
+
+                            std::set_union(_chunks.begin(), _chunks.end(), chunks.begin(), chunks.end(), std::back_inserter(merged), ChunkOrder);
+
+                            _chunks.swap(merged);
+                        }
+
+                        /// <summary>
+                        /// Orders chunks by address.
+                        /// </summary>
+                        /// <param name="left">Left chunk.</param>
+                        /// <param name="right">Right chunk.</param>
+                        /// <returns>True if left chunk has lower address.</returns>
+                        static bool ChunkOrder(const std::shared_ptr<Slot> & left, const std::shared_ptr<Slot> & right)
+                        {
+                            return std::less<Slot *>()(left.get(), right.get());
+                        }
+
+                        /// <summary>
+                        /// Forgets all owned memory.
+                        /// </summary>
+                        void Reset() noexcept
+                        {
+                            _chunks.clear();
+                            _spareRanges.clear();
+                            _freeList = nullptr;
+                            _freeTail = nullptr;
+                            _cursor = nullptr;
+                            _end = nullptr;
+                            _nextChunkSize = InitialChunkSize;
+                            _allocationCount = 0;
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -23,9 +23,13 @@
 #ifndef NUTADEV_CPPLIB_COLLECTIONS_LISTS_DOUBLELINKEDLIST_DOUBLELINKEDLIST_HPP
 #define NUTADEV_CPPLIB_COLLECTIONS_LISTS_DOUBLELINKEDLIST_DOUBLELINKEDLIST_HPP
 
+#include <cstddef>
+#include <exception>
 #include <memory>
+#include <utility>
 
 #include "DoubleLinkedListItem.hpp"
+#include "DoubleLinkedListIterator.hpp"
 
 namespace NutaDev
 {
@@ -38,34 +42,45 @@ namespace NutaDev
                 namespace DoubleLinkedList
                 {
                     /// <summary>
-                    /// Double linked lsit.
+                    /// Double linked lsit. Nodes are allocated with TAllocator, each node keeps a copy of it, so nodes can
+                    /// be spliced between lists with different allocators.
                     /// </summary>
-                    template <typename T>
+                    template <typename T, typename TAllocator = std::allocator<T>>
                     class DoubleLinkedList
                     {
                     public:
+                        typedef T value_type;
+                        typedef T & reference;
+                        typedef const T & const_reference;
+                        typedef DoubleLinkedListIterator<T, T> iterator;
+                        typedef DoubleLinkedListIterator<T, const T> const_iterator;
+                        typedef std::ptrdiff_t difference_type;
+                        typedef unsigned size_type;
+                        typedef TAllocator allocator_type;
 
                         /// <summary>
-                        /// Joins two lists.
+                        /// Creates a list that alternates elements of two lists, starting with the left one. Copies all
+                        /// elements in a single pass, O(n). Use Splice to concatenate lists without copying.
                         /// </summary>
                         /// <param name="left">First list.</param>
-                        /// <param name="right">Right list.</param>
+                        /// <param name="right">Second list.</param>
                         /// <returns>New list.</returns>
-                        static DoubleLinkedList<T> JoinLists(DoubleLinkedList<T> & left, DoubleLinkedList<T> & right)
+                        static DoubleLinkedList<T, TAllocator> Interleave(const DoubleLinkedList<T, TAllocator> & left, const DoubleLinkedList<T, TAllocator> & right)
                         {
-                            DoubleLinkedList<T> result;
+                            DoubleLinkedList<T, TAllocator> result(std::allocator_traits<TAllocator>::select_on_container_copy_construction(left._allocator));
 
-                            unsigned size = left._size > right._size ? left._size : right._size;
+                            const_iterator leftElement = left.begin();
+                            const_iterator rightElement = right.begin();
 
-                            for (unsigned i = 0; i < size; ++i)
+                            while (leftElement != left.end() || rightElement != right.end())
                             {
-                                if (i < left._size)
+                                if (leftElement != left.end())
                                 {
-                                    result.Add(left.Get(i));
+                                    result.Add(*leftElement++);
                                 }
-                                if (i < right._size)
+                                if (rightElement != right.end())
                                 {
-                                    result.Add(right.Get(i));
+                                    result.Add(*rightElement++);
                                 }
                             }
 
@@ -73,85 +88,87 @@ namespace NutaDev
                         }
 
                         /// <summary>
-                        /// Joins two lists.
+                        /// Joins two lists, same as Interleave.
                         /// </summary>
                         /// <param name="left">First list.</param>
                         /// <param name="right">Right list.</param>
                         /// <returns>New list.</returns>
-                        static std::shared_ptr<DoubleLinkedList<T>> JoinLists(std::shared_ptr<DoubleLinkedList<T>> left, std::shared_ptr<DoubleLinkedList<T>> right)
+                        static DoubleLinkedList<T, TAllocator> JoinLists(DoubleLinkedList<T, TAllocator> & left, DoubleLinkedList<T, TAllocator> & right)
                         {
-                            std::shared_ptr<DoubleLinkedList<T>> result = std::shared_ptr<DoubleLinkedList<T>>(new DoubleLinkedList<T>());
-
-                            unsigned size = left->_size > right->_size ? left->_size : right->_size;
-                            for (unsigned i = 0; i < size; ++i)
-                            {
-                                if (i < left->_size)
-                                {
-                                    result->Add(left->Get(i));
-                                }
-                                if (i < right->_size)
-                                {
-                                    result->Add(right->Get(i));
-                                }
-                            }
+                            return Interleave(left, right);
+                        }
 
-                            return result;
+                        /// <summary>
+                        /// Joins two lists, same as Interleave.
+                        /// </summary>
+                        /// <param name="left">First list.</param>
+                        /// <param name="right">Right list.</param>
+                        /// <returns>New list.</returns>
+                        static std::shared_ptr<DoubleLinkedList<T, TAllocator>> JoinLists(std::shared_ptr<DoubleLinkedList<T, TAllocator>> left, std::shared_ptr<DoubleLinkedList<T, TAllocator>> right)
+                        {
+                            return std::shared_ptr<DoubleLinkedList<T, TAllocator>>(new DoubleLinkedList<T, TAllocator>(Interleave(*left, *right)));
                         }
 
                         /// <summary>
-                        /// Adds element to list.
+                        /// Moves all elements of another list to the end of this list by relinking its first and last node, O(1).
                         /// </summary>
-                        /// <param name="value">Value to add.</param>
+                        /// <param name="other">List to take elements from, empty afterwards.</param>
                         /// <returns>Reference to itself.</returns>
-                        DoubleLinkedList<T> & Add(T & value)
+                        DoubleLinkedList<T, TAllocator> & Splice(DoubleLinkedList<T, TAllocator> & other)
                         {
+                            if (&other == this || other._root == nullptr)
+                            {
+                                return *this;
+                            }
+
                             if (_root == nullptr)
                             {
-                                _root = std::shared_ptr<ListItem<T>>(new ListItem<T>());
-                                _last = _root;
-                                _root->Value = value;
+                                _root = std::move(other._root);
                             }
                             else
                             {
-                                std::shared_ptr<ListItem<T>> newElem = std::shared_ptr<ListItem<T>>(new ListItem<T>());
-                                newElem->Value = value;
-                                newElem->Next = nullptr;
-                                newElem->Prev = _last;
-                                _last->Next = newElem;
-                                _last = newElem;
+                                other._root->Prev = _last;
+                                _last->Next = std::move(other._root);
                             }
 
-                            _size++;
+                            _last = other._last;
+                            _size += other._size;
+
+                            other._root = nullptr;
+                            other._last = nullptr;
+                            other._size = 0;
 
                             return *this;
                         }
 
+                        /// <summary>
+                        /// Moves all elements of another list to the end of this list, O(1).
+                        /// </summary>
+                        /// <param name="other">List to take elements from.</param>
+                        /// <returns>Reference to itself.</returns>
+                        DoubleLinkedList<T, TAllocator> & Append(DoubleLinkedList<T, TAllocator> && other)
+                        {
+                            return Splice(other);
+                        }
+
                         /// <summary>
                         /// Adds element to list.
                         /// </summary>
                         /// <param name="value">Value to add.</param>
                         /// <returns>Reference to itself.</returns>
-                        DoubleLinkedList<T> & Add(T && value)
+                        DoubleLinkedList<T, TAllocator> & Add(T & value)
                         {
-                            if (_root == nullptr)
-                            {
-                                _root = std::shared_ptr<ListItem<T>>(new ListItem<T>());
-                                _last = _root;
-                                _root->Value = value;
-                            }
-                            else
-                            {
-                                std::shared_ptr<ListItem<T>> newElem = std::shared_ptr<ListItem<T>>(new ListItem<T>());
-                                newElem->Value = value;
-                                newElem->Next = nullptr;
-                                newElem->Prev = _last;
-                                _last->Next = newElem;
-                                _last = newElem;
-                            }
-
-                            _size++;
+                            return Emplace(value);
+                        }
 
-                            return *this;
+                        /// <summary>
+                        /// Adds element to list.
+                        /// </summary>
+                        /// <param name="value">Value to add.</param>
+                        /// <returns>Reference to itself.</returns>
+                        DoubleLinkedList<T, TAllocator> & Add(T && value)
+                        {
+                            return Emplace(std::move(value));
                         }
 
                         /// <summary>
@@ -159,27 +176,105 @@ namespace NutaDev
                         /// </summary>
                         /// <param name="value">Value to add.</param>
                         /// <returns>Reference to itself.</returns>
-                        DoubleLinkedList<T> & Add(const T & value)
+                        DoubleLinkedList<T, TAllocator> & Add(const T & value)
                         {
-                            if (_root == nullptr)
+                            return Emplace(value);
+                        }
+
+                        /// <summary>
+                        /// Constructs element in place at the end of list.
+                        /// </summary>
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        /// <returns>Reference to itself.</returns>
+                        template<typename... TArgs>
+                        DoubleLinkedList<T, TAllocator> & Emplace(TArgs &&... args)
+                        {
+                            LinkBefore(nullptr, CreateNode(std::forward<TArgs>(args)...));
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Constructs element in place at the beginning of list, O(1).
+                        /// </summary>
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        /// <returns>Reference to itself.</returns>
+                        template<typename... TArgs>
+                        DoubleLinkedList<T, TAllocator> & PushFront(TArgs &&... args)
+                        {
+                            LinkBefore(_root.get(), CreateNode(std::forward<TArgs>(args)...));
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Constructs element in place before the specified position, O(1).
+                        /// </summary>
+                        /// <param name="position">Position of the new element, end() appends.</param>
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        /// <returns>Iterator to the new element.</returns>
+                        template<typename... TArgs>
+                        iterator InsertBefore(const_iterator position, TArgs &&... args)
+                        {
+                            return iterator(LinkBefore(position._node, CreateNode(std::forward<TArgs>(args)...)), &_last);
+                        }
+
+                        /// <summary>
+                        /// Removes element at the specified position, O(1).
+                        /// </summary>
+                        /// <param name="position">Position of the element, must not be end().</param>
+                        /// <returns>Iterator to the element that followed the removed one.</returns>
+                        iterator Erase(const_iterator position)
+                        {
+                            DoubleLinkedListItem<T> * next = position._node->Next.get();
+
+                            Unlink(position._node);
+
+                            return iterator(next, &_last);
+                        }
+
+                        /// <summary>
+                        /// Removes elements of the specified range, O(length of the range).
+                        /// </summary>
+                        /// <param name="first">First element to remove.</param>
+                        /// <param name="last">Element after the last one to remove.</param>
+                        /// <returns>Iterator to the element that followed the removed ones.</returns>
+                        iterator Erase(const_iterator first, const_iterator last)
+                        {
+                            while (first != last)
                             {
-                                _root = std::shared_ptr<ListItem<T>>(new ListItem<T>());
-                                _last = _root;
-                                _root->Value = value;
+                                first = Erase(first);
                             }
-                            else
+
+                            return iterator(last._node, &_last);
+                        }
+
+                        /// <summary>
+                        /// Removes the first element and returns it, O(1).
+                        /// </summary>
+                        /// <returns>The removed element.</returns>
+                        T PopFront()
+                        {
+                            if (_root == nullptr)
                             {
-                                std::shared_ptr<ListItem<T>> newElem = std::shared_ptr<ListItem<T>>(new ListItem<T>());
-                                newElem->Value = value;
-                                newElem->Next = nullptr;
-                                newElem->Prev = _last;
-                                _last->Next = newElem;
-                                _last = newElem;
+                                throw std::exception("You can't pop empty list.");
                             }
 
-                            _size++;
+                            return std::move(Unlink(_root.get())->Value);
+                        }
 
-                            return *this;
+                        /// <summary>
+                        /// Removes the last element and returns it, O(1).
+                        /// </summary>
+                        /// <returns>The removed element.</returns>
+                        T PopBack()
+                        {
+                            if (_last == nullptr)
+                            {
+                                throw std::exception("You can't pop empty list.");
+                            }
+
+                            return std::move(Unlink(_last)->Value);
                         }
 
                         /// <summary>
@@ -189,184 +284,364 @@ namespace NutaDev
                         /// <returns>The removed element.</returns>
                         T Pop(unsigned idx)
                         {
-                            if (idx > GetSize())
+                            std::shared_ptr<DoubleLinkedListItem<T>> element = Unlink(NodeAt(idx));
+
+                            return std::move(element->Value);
+                        }
+
+                        /// <summary>
+                        /// Removes node on specified index.
+                        /// </summary>
+                        /// <param name="idx">Idx</param>
+                        /// <returns>Reference to itself.</returns>
+                        DoubleLinkedList<T, TAllocator> & Remove(unsigned idx)
+                        {
+                            Unlink(NodeAt(idx));
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Removes all elements.
+                        /// </summary>
+                        void Clear() noexcept
+                        {
+                            // Releases nodes one by one, destroying the chain from the root would recurse once per node.
+                            while (_root != nullptr)
                             {
-                                throw std::exception("Index out of bounds.");
+                                std::shared_ptr<DoubleLinkedListItem<T>> next = std::move(_root->Next);
+                                _root = std::move(next);
                             }
 
-                            T result;
+                            _last = nullptr;
+                            _size = 0;
+                        }
 
-                            std::shared_ptr<ListItem<T>> element = _root;
-                            for (unsigned i = 0; i < _size; ++i)
-                            {
-                                if (i == idx)
-                                {
-                                    if (element->Prev != nullptr)
-                                    {
-                                        element->Prev->Next = element->Next;
-                                    }
+                        /// <summary>
+                        /// Gets element on specified index.
+                        /// </summary>
+                        /// <param name="idx">Element index.</param>
+                        /// <returns>Element on provided index.</returns>
+                        T & Get(unsigned idx)
+                        {
+                            return NodeAt(idx)->Value;
+                        }
 
-                                    if (element->Next != nullptr)
-                                    {
-                                        element->Next->Prev = element->Prev;
-                                    }
+                        /// <summary>
+                        /// Gets element on specified index.
+                        /// </summary>
+                        /// <param name="idx">Element index.</param>
+                        /// <returns>Element on provided index.</returns>
+                        const T & Get(unsigned idx) const
+                        {
+                            return NodeAt(idx)->Value;
+                        }
 
-                                    result = element->Value;
+                        /// <summary>
+                        /// Gets list size.
+                        /// </summary>
+                        /// <returns>List size.</returns>
+                        unsigned GetSize() const noexcept
+                        {
+                            return _size;
+                        }
 
-                                    if (idx == 0)
-                                    {
-                                        _root = element->Next;
-                                    }
+                        /// <summary>
+                        /// Gets iterator to the first element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        iterator begin() noexcept
+                        {
+                            return iterator(_root.get(), &_last);
+                        }
 
-                                    break;
-                                }
-                                element = element->Next;
-                            }
+                        /// <summary>
+                        /// Gets iterator past the last element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        iterator end() noexcept
+                        {
+                            return iterator(nullptr, &_last);
+                        }
 
-                            if (_size == 1)
-                            {
-                                _root = nullptr;
-                                _last = nullptr;
-                            }
+                        /// <summary>
+                        /// Gets iterator to the first element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator begin() const noexcept
+                        {
+                            return const_iterator(_root.get(), &_last);
+                        }
 
-                            _size--;
+                        /// <summary>
+                        /// Gets iterator past the last element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator end() const noexcept
+                        {
+                            return const_iterator(nullptr, &_last);
+                        }
 
-                            return result;
+                        /// <summary>
+                        /// Gets iterator to the first element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator cbegin() const noexcept
+                        {
+                            return begin();
                         }
 
                         /// <summary>
-                        /// Removes node on specified index.
+                        /// Gets iterator past the last element.
                         /// </summary>
-                        /// <param name="idx">Idx</param>
-                        /// <returns>Reference to itself.</returns>
-                        DoubleLinkedList<T> & Remove(unsigned idx)
+                        /// <returns>The iterator.</returns>
+                        const_iterator cend() const noexcept
+                        {
+                            return end();
+                        }
+
+                        /// <summary>
+                        /// Gets allocator of nodes.
+                        /// </summary>
+                        /// <returns>The allocator.</returns>
+                        TAllocator GetAllocator() const
+                        {
+                            return _allocator;
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        DoubleLinkedList()
+                            : _root(nullptr)
+                            , _last(nullptr)
+                            , _size(0)
+                        {
+
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="allocator">Allocator of nodes.</param>
+                        explicit DoubleLinkedList(const TAllocator & allocator)
+                            : _root(nullptr)
+                            , _last(nullptr)
+                            , _size(0)
+                            , _allocator(allocator)
                         {
-                            if (idx > GetSize())
-                            {
-                                throw std::exception("Index out of bounds.");
-                            }
 
-                            std::shared_ptr<ListItem<T>> element = _root;
-                            for (unsigned i = 0; i < _size; ++i)
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, copies elements of another list.
+                        /// </summary>
+                        /// <param name="other">List to copy.</param>
+                        DoubleLinkedList(const DoubleLinkedList<T, TAllocator> & other)
+                            : _root(nullptr)
+                            , _last(nullptr)
+                            , _size(0)
+                            , _allocator(std::allocator_traits<TAllocator>::select_on_container_copy_construction(other._allocator))
+                        {
+                            try
                             {
-                                if (i == idx)
+                                for (const T & value : other)
                                 {
-                                    if (element->Prev != nullptr)
-                                    {
-                                        element->Prev->Next = element->Next;
-                                    }
-
-                                    if (element->Next != nullptr)
-                                    {
-                                        element->Next->Prev = element->Prev;
-                                    }
-
-                                    if (idx == 0)
-                                    {
-                                        _root = element->Next;
-                                    }
-
-                                    break;
+                                    Add(value);
                                 }
-                                element = element->Next;
                             }
-
-                            if (_size == 1)
+                            catch (...)
                             {
-                                _root = nullptr;
-                                _last = nullptr;
+                                Clear();
+                                throw;
                             }
+                        }
 
-                            _size--;
-
-                            return *this;
+                        /// <summary>
+                        /// Initializes a new instance of this class, takes over nodes of another list.
+                        /// </summary>
+                        /// <param name="other">List to take nodes from, empty afterwards.</param>
+                        DoubleLinkedList(DoubleLinkedList<T, TAllocator> && other) noexcept
+                            : _root(std::move(other._root))
+                            , _last(other._last)
+                            , _size(other._size)
+                            , _allocator(other._allocator)
+                        {
+                            other._last = nullptr;
+                            other._size = 0;
                         }
 
                         /// <summary>
-                        /// Gets element on specified index.
+                        /// Assigns another list, copies its elements.
                         /// </summary>
-                        /// <param name="idx">Element index.</param>
-                        /// <returns>Element on provided index.</returns>
-                        T & Get(unsigned idx)
+                        /// <param name="other">List to copy.</param>
+                        /// <returns>Reference to itself.</returns>
+                        DoubleLinkedList<T, TAllocator> & operator=(const DoubleLinkedList<T, TAllocator> & other)
                         {
-                            if (idx > GetSize())
+                            if (this != &other)
                             {
-                                throw std::exception("Index out of bounds.");
+                                DoubleLinkedList<T, TAllocator> copy(other);
+                                *this = std::move(copy);
                             }
 
-                            std::shared_ptr<ListItem<T>> element = _root;
-                            for (unsigned i = 0; i < _size; ++i)
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Assigns another list, takes over its nodes.
+                        /// </summary>
+                        /// <param name="other">List to take nodes from, empty afterwards.</param>
+                        /// <returns>Reference to itself.</returns>
+                        DoubleLinkedList<T, TAllocator> & operator=(DoubleLinkedList<T, TAllocator> && other) noexcept
+                        {
+                            if (this != &other)
                             {
-                                if (i == idx)
-                                {
-                                    break;
-                                }
-                                element = element->Next;
+                                Clear();
+
+                                _root = std::move(other._root);
+                                _last = other._last;
+                                _size = other._size;
+
+                                other._last = nullptr;
+                                other._size = 0;
                             }
 
-                            return element->Value;
+                            return *this;
                         }
 
                         /// <summary>
-                        /// Gets element on specified index.
+                        /// Destructs the instance of this class.
                         /// </summary>
-                        /// <param name="idx">Element index.</param>
-                        /// <returns>Element on provided index.</returns>
-                        const T & Get(unsigned idx) const
+                        ~DoubleLinkedList()
+                        {
+                            Clear();
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Creates a detached node, the node and its reference count share one allocation.
+                        /// </summary>
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        /// <returns>The node.</returns>
+                        template<typename... TArgs>
+                        std::shared_ptr<DoubleLinkedListItem<T>> CreateNode(TArgs &&... args)
+                        {
+                            return std::allocate_shared<DoubleLinkedListItem<T>>(_allocator, std::piecewise_construct, std::forward<TArgs>(args)...);
+                        }
+
+                        /// <summary>
+                        /// Finds node on specified index, walks from the nearer end.
+                        /// </summary>
+                        /// <param name="idx">Index of element.</param>
+                        /// <returns>The node.</returns>
+                        DoubleLinkedListItem<T> * NodeAt(unsigned idx) const
                         {
-                            if (idx > GetSize())
+                            if (idx >= GetSize())
                             {
                                 throw std::exception("Index out of bounds.");
                             }
 
-                            std::shared_ptr<ListItem<T>> element = _root;
-                            for (unsigned i = 0; i < _size; ++i)
+                            DoubleLinkedListItem<T> * element;
+
+                            if (idx < _size / 2)
                             {
-                                if (i == idx)
+                                element = _root.get();
+                                for (unsigned i = 0; i < idx; ++i)
                                 {
-                                    break;
+                                    element = element->Next.get();
+                                }
+                            }
+                            else
+                            {
+                                element = _last;
+                                for (unsigned i = _size - 1; i > idx; --i)
+                                {
+                                    element = element->Prev;
                                 }
-                                element = element->Next;
                             }
 
-                            return element->Value;
+                            return element;
                         }
 
                         /// <summary>
-                        /// Gets list size.
+                        /// Attaches node before the specified one.
                         /// </summary>
-                        /// <returns>List size.</returns>
-                        unsigned GetSize() const noexcept
+                        /// <param name="position">Node that will follow the new one, nullptr appends.</param>
+                        /// <param name="node">Detached node.</param>
+                        /// <returns>The attached node.</returns>
+                        DoubleLinkedListItem<T> * LinkBefore(DoubleLinkedListItem<T> * position, std::shared_ptr<DoubleLinkedListItem<T>> node) noexcept
                         {
-                            return _size;
+                            DoubleLinkedListItem<T> * element = node.get();
+
+                            if (position == nullptr)
+                            {
+                                element->Prev = _last;
+                                (_last != nullptr ? _last->Next : _root) = std::move(node);
+                                _last = element;
+                            }
+                            else
+                            {
+                                std::shared_ptr<DoubleLinkedListItem<T>> & owner = position->Prev != nullptr ? position->Prev->Next : _root;
+
+                                element->Prev = position->Prev;
+                                element->Next = std::move(owner);
+                                position->Prev = element;
+                                owner = std::move(node);
+                            }
+
+                            _size++;
+
+                            return element;
                         }
 
                         /// <summary>
-                        /// Initializes a new instance of this class.
+                        /// Detaches node from the list.
                         /// </summary>
-                        DoubleLinkedList()
-                            : _root(nullptr)
-                            , _last(nullptr)
-                            , _size(0)
+                        /// <param name="element">Node of this list.</param>
+                        /// <returns>The detached node.</returns>
+                        std::shared_ptr<DoubleLinkedListItem<T>> Unlink(DoubleLinkedListItem<T> * element) noexcept
                         {
+                            std::shared_ptr<DoubleLinkedListItem<T>> & owner = element->Prev != nullptr ? element->Prev->Next : _root;
+                            std::shared_ptr<DoubleLinkedListItem<T>> detached = std::move(owner);
+
+                            if (element->Next != nullptr)
+                            {
+                                element->Next->Prev = element->Prev;
+                            }
+                            else
+                            {
+                                _last = element->Prev;
+                            }
 
+                            owner = std::move(element->Next);
+
+                            element->Prev = nullptr;
+                            element->Next = nullptr;
+
+                            _size--;
+
+                            return detached;
                         }
 
-                    private:
                         /// <summary>
                         /// Frist node.
                         /// </summary>
-                        std::shared_ptr<ListItem<T>> _root;
+                        std::shared_ptr<DoubleLinkedListItem<T>> _root;
 
                         /// <summary>
                         /// Last node.
                         /// </summary>
-                        std::shared_ptr<ListItem<T>> _last;
+                        DoubleLinkedListItem<T> * _last;
 
                         /// <summary>
                         /// List size.
                         /// </summary>
                         unsigned _size;
+
+                        /// <summary>
+                        /// Allocator of nodes.
+                        /// </summary>
+                        TAllocator _allocator;
                     };
                 }
             }
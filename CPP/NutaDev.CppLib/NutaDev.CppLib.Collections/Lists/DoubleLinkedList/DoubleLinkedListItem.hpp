@@ -24,6 +24,7 @@
 #define NUTADEV_CPPLIB_COLLECTIONS_LISTS_DOUBLELINKEDLIST_DOUBLELINKEDLISTITEM_HPP
 
 #include <memory>
+#include <utility>
 
 namespace NutaDev
 {
@@ -52,6 +53,19 @@ namespace NutaDev
 
                         }
 
+                        /// <summary>
+                        /// Initializes a new instance of this class, constructs the value in place.
+                        /// </summary>
+                        /// <param name="args">Arguments of the value constructor.</param>
+                        template<typename... TArgs>
+                        explicit DoubleLinkedListItem(std::piecewise_construct_t, TArgs &&... args)
+                            : Prev(nullptr)
+                            , Next(nullptr)
+                            , Value(std::forward<TArgs>(args)...)
+                        {
+
+                        }
+
                         /// <summary>
                         /// Destructs the instance of this class.
                         /// </summary>
@@ -62,12 +76,12 @@ namespace NutaDev
                         }
 
                         /// <summary>
-                        /// Previous node.
+                        /// Previous node, owned by the node before it or by the list.
                         /// </summary>
-                        std::shared_ptr<DoubleLinkedListItem> Prev;
+                        DoubleLinkedListItem * Prev;
 
                         /// <summary>
-                        /// Next node.
+                        /// Next node, owned by this node.
                         /// </summary>
                         std::shared_ptr<DoubleLinkedListItem> Next;
 
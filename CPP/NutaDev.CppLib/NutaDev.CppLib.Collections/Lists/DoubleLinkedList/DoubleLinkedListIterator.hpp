@@ -0,0 +1,196 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_LISTS_DOUBLELINKEDLIST_DOUBLELINKEDLISTITERATOR_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_LISTS_DOUBLELINKEDLIST_DOUBLELINKEDLISTITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "DoubleLinkedListItem.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Lists
+            {
+                namespace DoubleLinkedList
+                {
+                    template <typename T, typename TAllocator>
+                    class DoubleLinkedList;
+
+                    /// <summary>
+                    /// Bidirectional iterator of DoubleLinkedList. TValue is T or const T. The end iterator holds no node
+                    /// and reads the last node of the list when decremented. Iterators stay valid until their element is
+                    /// erased, insertions and splices don't invalidate them.
+                    /// </summary>
+                    template <typename T, typename TValue>
+                    class DoubleLinkedListIterator
+                    {
+                    public:
+                        typedef std::bidirectional_iterator_tag iterator_category;
+                        typedef typename std::remove_const<TValue>::type value_type;
+                        typedef std::ptrdiff_t difference_type;
+                        typedef TValue * pointer;
+                        typedef TValue & reference;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class which points nowhere.
+                        /// </summary>
+                        DoubleLinkedListIterator()
+                            : _node(nullptr)
+                            , _last(nullptr)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, converts iterator to const iterator.
+                        /// </summary>
+                        /// <param name="other">Iterator to convert.</param>
+                        template<typename TOther, typename = typename std::enable_if<std::is_const<TValue>::value && std::is_same<TOther, T>::value>::type>
+                        DoubleLinkedListIterator(const DoubleLinkedListIterator<T, TOther> & other)
+                            : _node(other._node)
+                            , _last(other._last)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Gets the current element.
+                        /// </summary>
+                        /// <returns>The element.</returns>
+                        reference operator*() const
+                        {
+                            return _node->Value;
+                        }
+
+                        /// <summary>
+                        /// Gets the current element.
+                        /// </summary>
+                        /// <returns>Pointer to the element.</returns>
+                        pointer operator->() const
+                        {
+                            return &_node->Value;
+                        }
+
+                        /// <summary>
+                        /// Moves to the next element.
+                        /// </summary>
+                        /// <returns>Reference to itself.</returns>
+                        DoubleLinkedListIterator<T, TValue> & operator++()
+                        {
+                            _node = _node->Next.get();
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Moves to the next element.
+                        /// </summary>
+                        /// <returns>Copy of the iterator before the move.</returns>
+                        DoubleLinkedListIterator<T, TValue> operator++(int)
+                        {
+                            DoubleLinkedListIterator<T, TValue> copy(*this);
+                            ++(*this);
+                            return copy;
+                        }
+
+                        /// <summary>
+                        /// Moves to the previous element.
+                        /// </summary>
+                        /// <returns>Reference to itself.</returns>
+                        DoubleLinkedListIterator<T, TValue> & operator--()
+                        {
+                            _node = _node != nullptr ? _node->Prev : *_last;
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Moves to the previous element.
+                        /// </summary>
+                        /// <returns>Copy of the iterator before the move.</returns>
+                        DoubleLinkedListIterator<T, TValue> operator--(int)
+                        {
+                            DoubleLinkedListIterator<T, TValue> copy(*this);
+                            --(*this);
+                            return copy;
+                        }
+
+                        /// <summary>
+                        /// Compares iterators.
+                        /// </summary>
+                        /// <param name="other">Another iterator.</param>
+                        /// <returns>True if both point to the same node or both are at the end.</returns>
+                        template<typename TOther>
+                        bool operator==(const DoubleLinkedListIterator<T, TOther> & other) const
+                        {
+                            return _node == other._node;
+                        }
+
+                        /// <summary>
+                        /// Compares iterators.
+                        /// </summary>
+                        /// <param name="other">Another iterator.</param>
+                        /// <returns>True if iterators differ.</returns>
+                        template<typename TOther>
+                        bool operator!=(const DoubleLinkedListIterator<T, TOther> & other) const
+                        {
+                            return _node != other._node;
+                        }
+
+                    private:
+                        template <typename, typename>
+                        friend class DoubleLinkedList;
+
+                        template <typename, typename>
+                        friend class DoubleLinkedListIterator;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="node">Current node, nullptr at the end.</param>
+                        /// <param name="last">Last node pointer of the list.</param>
+                        DoubleLinkedListIterator(DoubleLinkedListItem<T> * node, DoubleLinkedListItem<T> * const * last)
+                            : _node(node)
+                            , _last(last)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Current node.
+                        /// </summary>
+                        DoubleLinkedListItem<T> * _node;
+
+                        /// <summary>
+                        /// Last node pointer of the list.
+                        /// </summary>
+                        DoubleLinkedListItem<T> * const * _last;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,472 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_LISTS_INTRUSIVELIST_INTRUSIVELIST_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_LISTS_INTRUSIVELIST_INTRUSIVELIST_HPP
+
+#include <cstddef>
+#include <exception>
+
+#include "IntrusiveListHook.hpp"
+#include "IntrusiveListIterator.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Lists
+            {
+                namespace IntrusiveList
+                {
+                    /// <summary>
+                    /// Double linked list of objects that live elsewhere. Links are stored in a hook embedded in the
+                    /// object, selected by BaseHook or MemberHook, so the list never allocates. The list doesn't own
+                    /// its elements, they must outlive their membership. Every operation except index access is O(1).
+                    /// </summary>
+                    template <typename T, typename THook = BaseHook<>>
+                    class IntrusiveList
+                    {
+                    public:
+                        typedef T value_type;
+                        typedef T & reference;
+                        typedef const T & const_reference;
+                        typedef IntrusiveListIterator<T, T, THook> iterator;
+                        typedef IntrusiveListIterator<T, const T, THook> const_iterator;
+                        typedef std::ptrdiff_t difference_type;
+                        typedef unsigned size_type;
+
+                        /// <summary>
+                        /// Moves all elements of another list to the end of this list, O(1).
+                        /// </summary>
+                        /// <param name="other">List to take elements from, empty afterwards.</param>
+                        /// <returns>Reference to itself.</returns>
+                        IntrusiveList<T, THook> & Splice(IntrusiveList<T, THook> & other) noexcept
+                        {
+                            if (&other == this || other._size == 0)
+                            {
+                                return *this;
+                            }
+
+                            Hook * first = other._root.Next;
+                            Hook * last = other._root.Prev;
+
+                            first->Prev = _root.Prev;
+                            _root.Prev->Next = first;
+                            last->Next = &_root;
+                            _root.Prev = last;
+                            _size += other._size;
+
+                            other.Reset();
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Adds element at the end of list.
+                        /// </summary>
+                        /// <param name="value">Element which is on no list of this kind.</param>
+                        /// <returns>Reference to itself.</returns>
+                        IntrusiveList<T, THook> & Add(T & value)
+                        {
+                            Link(&_root, value);
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Adds element at the beginning of list.
+                        /// </summary>
+                        /// <param name="value">Element which is on no list of this kind.</param>
+                        /// <returns>Reference to itself.</returns>
+                        IntrusiveList<T, THook> & PushFront(T & value)
+                        {
+                            Link(_root.Next, value);
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Adds element before the specified position.
+                        /// </summary>
+                        /// <param name="position">Position in this list, end() appends. A position in another list links the element there but counts it here.</param>
+                        /// <param name="value">Element which is on no list of this kind.</param>
+                        /// <returns>Iterator to the element.</returns>
+                        iterator InsertBefore(const_iterator position, T & value)
+                        {
+                            return iterator(Link(position._hook, value));
+                        }
+
+                        /// <summary>
+                        /// Removes element from the list.
+                        /// The element must be on this list, this is not checked: an element on another list with the same hook
+                        /// is unlinked from that list and both lists end up with wrong sizes.
+                        /// </summary>
+                        /// <param name="value">Element of this list.</param>
+                        /// <returns>Reference to itself.</returns>
+                        IntrusiveList<T, THook> & Remove(T & value)
+                        {
+                            Hook * hook = THook::ToHook(value);
+
+                            if (!hook->IsLinked())
+                            {
+                                throw std::exception("The element is not on a list.");
+                            }
+
+                            Unlink(hook);
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Removes element at the specified position.
+                        /// </summary>
+                        /// <param name="position">Position of an element of this list, must not be end(). Not checked, see Remove.</param>
+                        /// <returns>Iterator to the element that followed the removed one.</returns>
+                        iterator Erase(const_iterator position) noexcept
+                        {
+                            Hook * next = position._hook->Next;
+
+                            Unlink(position._hook);
+
+                            return iterator(next);
+                        }
+
+                        /// <summary>
+                        /// Removes elements of the specified range.
+                        /// </summary>
+                        /// <param name="first">First element to remove, the range must be in this list.</param>
+                        /// <param name="last">Element after the last one to remove.</param>
+                        /// <returns>Iterator to the element that followed the removed ones.</returns>
+                        iterator Erase(const_iterator first, const_iterator last) noexcept
+                        {
+                            while (first != last)
+                            {
+                                first = Erase(first);
+                            }
+
+                            return iterator(last._hook);
+                        }
+
+                        /// <summary>
+                        /// Removes the first element and returns it.
+                        /// </summary>
+                        /// <returns>The removed element.</returns>
+                        T & PopFront()
+                        {
+                            if (_size == 0)
+                            {
+                                throw std::exception("You can't pop empty list.");
+                            }
+
+                            Hook * hook = _root.Next;
+                            Unlink(hook);
+
+                            return *THook::template ToValue<T>(hook);
+                        }
+
+                        /// <summary>
+                        /// Removes the last element and returns it.
+                        /// </summary>
+                        /// <returns>The removed element.</returns>
+                        T & PopBack()
+                        {
+                            if (_size == 0)
+                            {
+                                throw std::exception("You can't pop empty list.");
+                            }
+
+                            Hook * hook = _root.Prev;
+                            Unlink(hook);
+
+                            return *THook::template ToValue<T>(hook);
+                        }
+
+                        /// <summary>
+                        /// Removes all elements, they can be added to a list again.
+                        /// </summary>
+                        void Clear() noexcept
+                        {
+                            Hook * hook = _root.Next;
+
+                            while (hook != &_root)
+                            {
+                                Hook * next = hook->Next;
+                                hook->Prev = nullptr;
+                                hook->Next = nullptr;
+                                hook = next;
+                            }
+
+                            Reset();
+                        }
+
+                        /// <summary>
+                        /// Gets element on specified index.
+                        /// </summary>
+                        /// <param name="idx">Element index.</param>
+                        /// <returns>Element on provided index.</returns>
+                        T & Get(unsigned idx)
+                        {
+                            return *THook::template ToValue<T>(HookAt(idx));
+                        }
+
+                        /// <summary>
+                        /// Gets element on specified index.
+                        /// </summary>
+                        /// <param name="idx">Element index.</param>
+                        /// <returns>Element on provided index.</returns>
+                        const T & Get(unsigned idx) const
+                        {
+                            return *THook::template ToValue<T>(HookAt(idx));
+                        }
+
+                        /// <summary>
+                        /// Gets list size.
+                        /// </summary>
+                        /// <returns>List size.</returns>
+                        unsigned GetSize() const noexcept
+                        {
+                            return _size;
+                        }
+
+                        /// <summary>
+                        /// Gets iterator to the first element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        iterator begin() noexcept
+                        {
+                            return iterator(_root.Next);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator past the last element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        iterator end() noexcept
+                        {
+                            return iterator(&_root);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator to the first element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator begin() const noexcept
+                        {
+                            return const_iterator(_root.Next);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator past the last element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator end() const noexcept
+                        {
+                            return const_iterator(const_cast<Hook *>(&_root));
+                        }
+
+                        /// <summary>
+                        /// Gets iterator to the first element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator cbegin() const noexcept
+                        {
+                            return begin();
+                        }
+
+                        /// <summary>
+                        /// Gets iterator past the last element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator cend() const noexcept
+                        {
+                            return end();
+                        }
+
+                        /// <summary>
+                        /// Gets iterator to the element, O(1).
+                        /// </summary>
+                        /// <param name="value">Element of this list.</param>
+                        /// <returns>The iterator.</returns>
+                        iterator IteratorTo(T & value) noexcept
+                        {
+                            return iterator(THook::ToHook(value));
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        IntrusiveList() noexcept
+                            : _size(0)
+                        {
+                            Reset();
+                        }
+
+                        /// <summary>
+                        /// Elements can't be on two lists through one hook, so list can't be copied.
+                        /// </summary>
+                        IntrusiveList(const IntrusiveList<T, THook> & other) = delete;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, takes over elements of another list.
+                        /// </summary>
+                        /// <param name="other">List to take elements from, empty afterwards.</param>
+                        IntrusiveList(IntrusiveList<T, THook> && other) noexcept
+                            : _size(0)
+                        {
+                            Reset();
+                            Splice(other);
+                        }
+
+                        /// <summary>
+                        /// Elements can't be on two lists through one hook, so list can't be copied.
+                        /// </summary>
+                        IntrusiveList<T, THook> & operator=(const IntrusiveList<T, THook> & other) = delete;
+
+                        /// <summary>
+                        /// Assigns another list, removes own elements and takes over elements of the other one.
+                        /// </summary>
+                        /// <param name="other">List to take elements from, empty afterwards.</param>
+                        /// <returns>Reference to itself.</returns>
+                        IntrusiveList<T, THook> & operator=(IntrusiveList<T, THook> && other) noexcept
+                        {
+                            if (this != &other)
+                            {
+                                Clear();
+                                Splice(other);
+                            }
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Destructs the instance of this class, removes all elements.
+                        /// </summary>
+                        ~IntrusiveList()
+                        {
+                            Clear();
+                        }
+
+                    private:
+                        typedef typename THook::Hook Hook;
+
+                        /// <summary>
+                        /// Makes the list empty without touching elements.
+                        /// </summary>
+                        void Reset() noexcept
+                        {
+                            _root.Prev = &_root;
+                            _root.Next = &_root;
+                            _size = 0;
+                        }
+
+                        /// <summary>
+                        /// Links element before the specified hook.
+                        /// </summary>
+                        /// <param name="position">Hook that will follow the element.</param>
+                        /// <param name="value">Element which is on no list of this kind.</param>
+                        /// <returns>Hook of the element.</returns>
+                        Hook * Link(Hook * position, T & value)
+                        {
+                            Hook * hook = THook::ToHook(value);
+
+                            if (hook->IsLinked())
+                            {
+                                throw std::exception("The element is already on a list.");
+                            }
+
+                            hook->Prev = position->Prev;
+                            hook->Next = position;
+                            position->Prev->Next = hook;
+                            position->Prev = hook;
+
+                            _size++;
+
+                            return hook;
+                        }
+
+                        /// <summary>
+                        /// Unlinks hook of an element of this list.
+                        /// </summary>
+                        /// <param name="hook">The hook.</param>
+                        void Unlink(Hook * hook) noexcept
+                        {
+                            hook->Prev->Next = hook->Next;
+                            hook->Next->Prev = hook->Prev;
+                            hook->Prev = nullptr;
+                            hook->Next = nullptr;
+
+                            _size--;
+                        }
+
+                        /// <summary>
+                        /// Finds hook of element on specified index, walks from the nearer end.
+                        /// </summary>
+                        /// <param name="idx">Index of element.</param>
+                        /// <returns>The hook.</returns>
+                        Hook * HookAt(unsigned idx) const
+                        {
+                            if (idx >= _size)
+                            {
+                                throw std::exception("Index out of bounds.");
+                            }
+
+                            Hook * hook;
+
+                            if (idx < _size / 2)
+                            {
+                                hook = _root.Next;
+                                for (unsigned i = 0; i < idx; ++i)
+                                {
+                                    hook = hook->Next;
+                                }
+                            }
+                            else
+                            {
+                                hook = _root.Prev;
+                                for (unsigned i = _size - 1; i > idx; --i)
+                                {
+                                    hook = hook->Prev;
+                                }
+                            }
+
+                            return hook;
+                        }
+
+                        /// <summary>
+                        /// Hook of the list, its next is the first element and its previous the last one.
+                        /// </summary>
+                        Hook _root;
+
+                        /// <summary>
+                        /// List size.
+                        /// </summary>
+                        unsigned _size;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
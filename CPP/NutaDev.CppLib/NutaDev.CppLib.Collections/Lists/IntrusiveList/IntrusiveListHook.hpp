@@ -0,0 +1,184 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_LISTS_INTRUSIVELIST_INTRUSIVELISTHOOK_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_LISTS_INTRUSIVELIST_INTRUSIVELISTHOOK_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Lists
+            {
+                namespace IntrusiveList
+                {
+                    /// <summary>
+                    /// Tag of the hook used when an object is on one kind of list only.
+                    /// </summary>
+                    struct DefaultHookTag
+                    {
+                    };
+
+                    /// <summary>
+                    /// Links of an object on IntrusiveList, embedded in the object as a base class or a member.
+                    /// An object that derives from hooks with different tags can be on as many lists at once.
+                    /// The object must be removed from its list before it is destroyed.
+                    /// </summary>
+                    template <typename TTag = DefaultHookTag>
+                    class IntrusiveListHook
+                    {
+                    public:
+                        /// <summary>
+                        /// Initializes a new instance of this class which is on no list.
+                        /// </summary>
+                        IntrusiveListHook() noexcept
+                            : Prev(nullptr)
+                            , Next(nullptr)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, a copy of an object is on no list.
+                        /// </summary>
+                        IntrusiveListHook(const IntrusiveListHook &) noexcept
+                            : Prev(nullptr)
+                            , Next(nullptr)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Assigning an object keeps it on its list.
+                        /// </summary>
+                        /// <returns>Reference to itself.</returns>
+                        IntrusiveListHook & operator=(const IntrusiveListHook &) noexcept
+                        {
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Indicates whether the object is on a list.
+                        /// </summary>
+                        /// <returns>True if the object is on a list.</returns>
+                        bool IsLinked() const noexcept
+                        {
+                            return Next != nullptr;
+                        }
+
+                        /// <summary>
+                        /// Previous hook, the list itself before the first element.
+                        /// </summary>
+                        IntrusiveListHook * Prev;
+
+                        /// <summary>
+                        /// Next hook, the list itself after the last element.
+                        /// </summary>
+                        IntrusiveListHook * Next;
+                    };
+
+                    /// <summary>
+                    /// Selects hook that the element derives from.
+                    /// </summary>
+                    template <typename TTag = DefaultHookTag>
+                    struct BaseHook
+                    {
+                        typedef IntrusiveListHook<TTag> Hook;
+
+                        /// <summary>
+                        /// Gets hook of the element.
+                        /// </summary>
+                        /// <param name="value">The element.</param>
+                        /// <returns>The hook.</returns>
+                        template<typename T>
+                        static Hook * ToHook(T & value) noexcept
+                        {
+                            return static_cast<Hook *>(&value);
+                        }
+
+                        /// <summary>
+                        /// Gets element that owns the hook.
+                        /// </summary>
+                        /// <param name="hook">The hook.</param>
+                        /// <returns>The element.</returns>
+                        template<typename T>
+                        static T * ToValue(Hook * hook) noexcept
+                        {
+                            return static_cast<T *>(hook);
+                        }
+                    };
+
+                    /// <summary>
+                    /// Selects hook that is a member of the element.
+                    /// </summary>
+                    template <typename T, typename THook, THook T::* TMember>
+                    struct MemberHook
+                    {
+                        typedef THook Hook;
+
+                        /// <summary>
+                        /// Gets hook of the element.
+                        /// </summary>
+                        /// <param name="value">The element.</param>
+                        /// <returns>The hook.</returns>
+                        template<typename TValue>
+                        static Hook * ToHook(TValue & value) noexcept
+                        {
+                            return &(value.*TMember);
+                        }
+
+                        /// <summary>
+                        /// Gets element that owns the hook.
+                        /// </summary>
+                        /// <param name="hook">The hook.</param>
+                        /// <returns>The element.</returns>
+                        template<typename TValue>
+                        static TValue * ToValue(Hook * hook) noexcept
+                        {
+                            static_assert(std::is_same<TValue, T>::value, "MemberHook selects hook of another type.");
+
+                            return reinterpret_cast<T *>(reinterpret_cast<char *>(hook) - Offset());
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Gets offset of the hook in the element.
+                        /// </summary>
+                        /// <returns>The offset.</returns>
+                        static std::ptrdiff_t Offset() noexcept
+                        {
+                            static const typename std::aligned_storage<sizeof(T), alignof(T)>::type sample = {};
+                            static const std::ptrdiff_t offset = reinterpret_cast<const char *>(&(reinterpret_cast<const T *>(&sample)->*TMember)) - reinterpret_cast<const char *>(&sample);
+
+                            return offset;
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,184 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_LISTS_INTRUSIVELIST_INTRUSIVELISTITERATOR_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_LISTS_INTRUSIVELIST_INTRUSIVELISTITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Lists
+            {
+                namespace IntrusiveList
+                {
+                    template <typename T, typename THook>
+                    class IntrusiveList;
+
+                    /// <summary>
+                    /// Bidirectional iterator of IntrusiveList. TValue is T or const T. The end iterator points to the
+                    /// hook of the list itself. Iterators stay valid until their element is removed.
+                    /// </summary>
+                    template <typename T, typename TValue, typename THook>
+                    class IntrusiveListIterator
+                    {
+                    public:
+                        typedef std::bidirectional_iterator_tag iterator_category;
+                        typedef typename std::remove_const<TValue>::type value_type;
+                        typedef std::ptrdiff_t difference_type;
+                        typedef TValue * pointer;
+                        typedef TValue & reference;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class which points nowhere.
+                        /// </summary>
+                        IntrusiveListIterator()
+                            : _hook(nullptr)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, converts iterator to const iterator.
+                        /// </summary>
+                        /// <param name="other">Iterator to convert.</param>
+                        template<typename TOther, typename = typename std::enable_if<std::is_const<TValue>::value && std::is_same<TOther, T>::value>::type>
+                        IntrusiveListIterator(const IntrusiveListIterator<T, TOther, THook> & other)
+                            : _hook(other._hook)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Gets the current element.
+                        /// </summary>
+                        /// <returns>The element.</returns>
+                        reference operator*() const
+                        {
+                            return *THook::template ToValue<T>(_hook);
+                        }
+
+                        /// <summary>
+                        /// Gets the current element.
+                        /// </summary>
+                        /// <returns>Pointer to the element.</returns>
+                        pointer operator->() const
+                        {
+                            return THook::template ToValue<T>(_hook);
+                        }
+
+                        /// <summary>
+                        /// Moves to the next element.
+                        /// </summary>
+                        /// <returns>Reference to itself.</returns>
+                        IntrusiveListIterator<T, TValue, THook> & operator++()
+                        {
+                            _hook = _hook->Next;
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Moves to the next element.
+                        /// </summary>
+                        /// <returns>Copy of the iterator before the move.</returns>
+                        IntrusiveListIterator<T, TValue, THook> operator++(int)
+                        {
+                            IntrusiveListIterator<T, TValue, THook> copy(*this);
+                            ++(*this);
+                            return copy;
+                        }
+
+                        /// <summary>
+                        /// Moves to the previous element.
+                        /// </summary>
+                        /// <returns>Reference to itself.</returns>
+                        IntrusiveListIterator<T, TValue, THook> & operator--()
+                        {
+                            _hook = _hook->Prev;
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Moves to the previous element.
+                        /// </summary>
+                        /// <returns>Copy of the iterator before the move.</returns>
+                        IntrusiveListIterator<T, TValue, THook> operator--(int)
+                        {
+                            IntrusiveListIterator<T, TValue, THook> copy(*this);
+                            --(*this);
+                            return copy;
+                        }
+
+                        /// <summary>
+                        /// Compares iterators.
+                        /// </summary>
+                        /// <param name="other">Another iterator.</param>
+                        /// <returns>True if both point to the same element or both are at the end.</returns>
+                        template<typename TOther>
+                        bool operator==(const IntrusiveListIterator<T, TOther, THook> & other) const
+                        {
+                            return _hook == other._hook;
+                        }
+
+                        /// <summary>
+                        /// Compares iterators.
+                        /// </summary>
+                        /// <param name="other">Another iterator.</param>
+                        /// <returns>True if iterators differ.</returns>
+                        template<typename TOther>
+                        bool operator!=(const IntrusiveListIterator<T, TOther, THook> & other) const
+                        {
+                            return _hook != other._hook;
+                        }
+
+                    private:
+                        template <typename, typename>
+                        friend class IntrusiveList;
+
+                        template <typename, typename, typename>
+                        friend class IntrusiveListIterator;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="hook">Hook of the current element or of the list at the end.</param>
+                        explicit IntrusiveListIterator(typename THook::Hook * hook)
+                            : _hook(hook)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Hook of the current element.
+                        /// </summary>
+                        typename THook::Hook * _hook;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
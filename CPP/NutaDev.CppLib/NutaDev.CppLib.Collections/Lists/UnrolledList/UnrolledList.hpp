@@ -0,0 +1,576 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_LISTS_UNROLLEDLIST_UNROLLEDLIST_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_LISTS_UNROLLEDLIST_UNROLLEDLIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "../../Memory/CacheLine.hpp"
+#include "UnrolledListChunk.hpp"
+#include "UnrolledListIterator.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Lists
+            {
+                namespace UnrolledList
+                {
+                    /// <summary>
+                    /// Unrolled list, a singly linked list of chunks that hold up to TChunkCapacity elements each.
+                    /// Adds at the end and removes from the front in amortised O(1) with one allocation per chunk
+                    /// instead of one per element. Emptied chunks are kept for reuse, up to SpareChunks of them.
+                    /// Default capacity is 64 elements of up to 16 bytes and 32 of larger ones. Chunks are allocated with TAllocator.
+                    /// </summary>
+                    template <typename T, std::size_t TChunkCapacity = (sizeof(T) <= 16 ? 64 : 32), typename TAllocator = std::allocator<T>>
+                    class UnrolledList
+                    {
+                    public:
+                        static_assert(TChunkCapacity > 0, "Chunk must hold at least one element.");
+                        static_assert(alignof(T) <= Memory::CacheLineSize, "UnrolledList supports alignment up to a cache line.");
+
+                        typedef T value_type;
+                        typedef T & reference;
+                        typedef const T & const_reference;
+                        typedef UnrolledListIterator<T, T, TChunkCapacity> iterator;
+                        typedef UnrolledListIterator<T, const T, TChunkCapacity> const_iterator;
+                        typedef std::ptrdiff_t difference_type;
+                        typedef unsigned size_type;
+                        typedef TAllocator allocator_type;
+
+                        /// <summary>
+                        /// Maximum number of emptied chunks kept for reuse.
+                        /// </summary>
+                        static const unsigned SpareChunks = 4;
+
+                        /// <summary>
+                        /// Moves all elements of another list to the end of this list by linking its chunks, O(1).
+                        /// When allocators of the lists differ, elements are moved one by one, O(n).
+                        /// </summary>
+                        /// <param name="other">List to take elements from, empty afterwards.</param>
+                        /// <returns>Reference to itself.</returns>
+                        UnrolledList<T, TChunkCapacity, TAllocator> & Splice(UnrolledList<T, TChunkCapacity, TAllocator> & other)
+                        {
+                            if (&other == this || other._head == nullptr)
+                            {
+                                return *this;
+                            }
+
+                            if (_allocator != other._allocator)
+                            {
+                                while (other._head != nullptr)
+                                {
+                                    Emplace(other.PopFront());
+                                }
+
+                                return *this;
+                            }
+
+                            if (_head == nullptr)
+                            {
+                                _head = other._head;
+                            }
+                            else
+                            {
+                                _tail->Next = other._head;
+                            }
+
+                            _tail = other._tail;
+                            _size += other._size;
+
+                            other._head = nullptr;
+                            other._tail = nullptr;
+                            other._size = 0;
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Moves all elements of another list to the end of this list, O(1).
+                        /// </summary>
+                        /// <param name="other">List to take elements from.</param>
+                        /// <returns>Reference to itself.</returns>
+                        UnrolledList<T, TChunkCapacity, TAllocator> & Append(UnrolledList<T, TChunkCapacity, TAllocator> && other)
+                        {
+                            return Splice(other);
+                        }
+
+                        /// <summary>
+                        /// Adds element to list.
+                        /// </summary>
+                        /// <param name="value">Value to add.</param>
+                        /// <returns>Reference to itself.</returns>
+                        UnrolledList<T, TChunkCapacity, TAllocator> & Add(T & value)
+                        {
+                            return Emplace(value);
+                        }
+
+                        /// <summary>
+                        /// Adds element to list.
+                        /// </summary>
+                        /// <param name="value">Value to add.</param>
+                        /// <returns>Reference to itself.</returns>
+                        UnrolledList<T, TChunkCapacity, TAllocator> & Add(T && value)
+                        {
+                            return Emplace(std::move(value));
+                        }
+
+                        /// <summary>
+                        /// Adds element to list.
+                        /// </summary>
+                        /// <param name="value">Value to add.</param>
+                        /// <returns>Reference to itself.</returns>
+                        UnrolledList<T, TChunkCapacity, TAllocator> & Add(const T & value)
+                        {
+                            return Emplace(value);
+                        }
+
+                        /// <summary>
+                        /// Constructs element in place at the end of list.
+                        /// </summary>
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        /// <returns>Reference to itself.</returns>
+                        template<typename... TArgs>
+                        UnrolledList<T, TChunkCapacity, TAllocator> & Emplace(TArgs &&... args)
+                        {
+                            if (_tail != nullptr && _tail->End < TChunkCapacity)
+                            {
+                                new (_tail->At(_tail->End)) T(std::forward<TArgs>(args)...);
+                                _tail->End++;
+                            }
+                            else
+                            {
+                                Chunk * chunk = Acquire();
+
+                                try
+                                {
+                                    new (chunk->At(0)) T(std::forward<TArgs>(args)...);
+                                }
+                                catch (...)
+                                {
+                                    Recycle(chunk);
+                                    throw;
+                                }
+
+                                chunk->End = 1;
+
+                                (_tail != nullptr ? _tail->Next : _head) = chunk;
+                                _tail = chunk;
+                            }
+
+                            _size++;
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Removes the first element and returns it.
+                        /// </summary>
+                        /// <returns>The removed element.</returns>
+                        T PopFront()
+                        {
+                            if (_head == nullptr)
+                            {
+                                throw std::exception("You can't pop empty list.");
+                            }
+
+                            T * element = _head->At(_head->Begin);
+                            T result(std::move(*element));
+
+                            element->~T();
+                            _head->Begin++;
+                            _size--;
+
+                            if (_head->Begin == _head->End)
+                            {
+                                Chunk * chunk = _head;
+                                _head = chunk->Next;
+
+                                if (_head == nullptr)
+                                {
+                                    _tail = nullptr;
+                                }
+
+                                Recycle(chunk);
+                            }
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Removes all elements.
+                        /// </summary>
+                        void Clear() noexcept
+                        {
+                            while (_head != nullptr)
+                            {
+                                Chunk * chunk = _head;
+                                _head = chunk->Next;
+
+                                for (unsigned i = chunk->Begin; i < chunk->End; ++i)
+                                {
+                                    chunk->At(i)->~T();
+                                }
+
+                                Recycle(chunk);
+                            }
+
+                            _tail = nullptr;
+                            _size = 0;
+                        }
+
+                        /// <summary>
+                        /// Gets element on specified index, skips whole chunks.
+                        /// </summary>
+                        /// <param name="idx">Element index.</param>
+                        /// <returns>Element on provided index.</returns>
+                        T & Get(unsigned idx)
+                        {
+                            return *ElementAt(idx);
+                        }
+
+                        /// <summary>
+                        /// Gets element on specified index, skips whole chunks.
+                        /// </summary>
+                        /// <param name="idx">Element index.</param>
+                        /// <returns>Element on provided index.</returns>
+                        const T & Get(unsigned idx) const
+                        {
+                            return *ElementAt(idx);
+                        }
+
+                        /// <summary>
+                        /// Gets list size.
+                        /// </summary>
+                        /// <returns>List size.</returns>
+                        unsigned GetSize() const noexcept
+                        {
+                            return _size;
+                        }
+
+                        /// <summary>
+                        /// Gets iterator to the first element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        iterator begin() noexcept
+                        {
+                            return iterator(_head, _head != nullptr ? _head->Begin : 0);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator past the last element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        iterator end() noexcept
+                        {
+                            return iterator(nullptr, 0);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator to the first element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator begin() const noexcept
+                        {
+                            return const_iterator(_head, _head != nullptr ? _head->Begin : 0);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator past the last element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator end() const noexcept
+                        {
+                            return const_iterator(nullptr, 0);
+                        }
+
+                        /// <summary>
+                        /// Gets iterator to the first element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator cbegin() const noexcept
+                        {
+                            return begin();
+                        }
+
+                        /// <summary>
+                        /// Gets iterator past the last element.
+                        /// </summary>
+                        /// <returns>The iterator.</returns>
+                        const_iterator cend() const noexcept
+                        {
+                            return end();
+                        }
+
+                        /// <summary>
+                        /// Gets allocator of chunks.
+                        /// </summary>
+                        /// <returns>The allocator.</returns>
+                        TAllocator GetAllocator() const
+                        {
+                            return _allocator;
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        UnrolledList()
+                            : _head(nullptr)
+                            , _tail(nullptr)
+                            , _spare(nullptr)
+                            , _size(0)
+                            , _spareCount(0)
+                        {
+
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="allocator">Allocator of chunks.</param>
+                        explicit UnrolledList(const TAllocator & allocator)
+                            : _head(nullptr)
+                            , _tail(nullptr)
+                            , _spare(nullptr)
+                            , _size(0)
+                            , _spareCount(0)
+                            , _allocator(allocator)
+                        {
+
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, copies elements of another list.
+                        /// </summary>
+                        /// <param name="other">List to copy.</param>
+                        UnrolledList(const UnrolledList<T, TChunkCapacity, TAllocator> & other)
+                            : UnrolledList(std::allocator_traits<TAllocator>::select_on_container_copy_construction(other._allocator))
+                        {
+                            // The delegated constructor has completed, so the destructor releases copied elements if a copy throws.
+                            for (const T & value : other)
+                            {
+                                Add(value);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, takes over chunks of another list.
+                        /// </summary>
+                        /// <param name="other">List to take chunks from, empty afterwards.</param>
+                        UnrolledList(UnrolledList<T, TChunkCapacity, TAllocator> && other) noexcept
+                            : UnrolledList(other._allocator)
+                        {
+                            Splice(other);
+                        }
+
+                        /// <summary>
+                        /// Assigns another list, copies its elements.
+                        /// </summary>
+                        /// <param name="other">List to copy.</param>
+                        /// <returns>Reference to itself.</returns>
+                        UnrolledList<T, TChunkCapacity, TAllocator> & operator=(const UnrolledList<T, TChunkCapacity, TAllocator> & other)
+                        {
+                            if (this != &other)
+                            {
+                                UnrolledList<T, TChunkCapacity, TAllocator> copy(other);
+                                *this = std::move(copy);
+                            }
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Assigns another list, takes over its chunks if allocators of the lists are equal.
+                        /// </summary>
+                        /// <param name="other">List to take chunks from, empty afterwards.</param>
+                        /// <returns>Reference to itself.</returns>
+                        UnrolledList<T, TChunkCapacity, TAllocator> & operator=(UnrolledList<T, TChunkCapacity, TAllocator> && other)
+                        {
+                            if (this != &other)
+                            {
+                                Clear();
+                                Splice(other);
+                            }
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Destructs the instance of this class.
+                        /// </summary>
+                        ~UnrolledList()
+                        {
+                            Clear();
+                            Release();
+                        }
+
+                    private:
+                        typedef UnrolledListChunk<T, TChunkCapacity> Chunk;
+
+                        /// <summary>
+                        /// Allocator of chunk memory.
+                        /// </summary>
+                        typedef typename std::allocator_traits<TAllocator>::template rebind_alloc<char> ByteAllocator;
+
+                        /// <summary>
+                        /// Size of chunk memory, large enough to align the chunk.
+                        /// </summary>
+                        static const std::size_t ChunkBytes = sizeof(Chunk) + alignof(Chunk) - 1;
+
+                        /// <summary>
+                        /// Gets an empty chunk, reuses a spare one if there is any.
+                        /// </summary>
+                        /// <returns>The chunk.</returns>
+                        Chunk * Acquire()
+                        {
+                            Chunk * chunk = _spare;
+
+                            if (chunk != nullptr)
+                            {
+                                _spare = chunk->Next;
+                                _spareCount--;
+                            }
+                            else
+                            {
+                                char * memory = ByteAllocator(_allocator).allocate(ChunkBytes);
+                                chunk = reinterpret_cast<Chunk *>((reinterpret_cast<std::uintptr_t>(memory) + alignof(Chunk) - 1) & ~static_cast<std::uintptr_t>(alignof(Chunk) - 1));
+                                chunk->Memory = memory;
+                            }
+
+                            chunk->Next = nullptr;
+                            chunk->Begin = 0;
+                            chunk->End = 0;
+
+                            return chunk;
+                        }
+
+                        /// <summary>
+                        /// Keeps an emptied chunk for reuse or frees it when there are enough spare chunks.
+                        /// </summary>
+                        /// <param name="chunk">Chunk without elements.</param>
+                        void Recycle(Chunk * chunk) noexcept
+                        {
+                            if (_spareCount < SpareChunks)
+                            {
+                                chunk->Next = _spare;
+                                _spare = chunk;
+                                _spareCount++;
+                            }
+                            else
+                            {
+                                Free(chunk);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Frees spare chunks.
+                        /// </summary>
+                        void Release() noexcept
+                        {
+                            while (_spare != nullptr)
+                            {
+                                Chunk * chunk = _spare;
+                                _spare = chunk->Next;
+                                Free(chunk);
+                            }
+
+                            _spareCount = 0;
+                        }
+
+                        /// <summary>
+                        /// Releases memory of a chunk.
+                        /// </summary>
+                        /// <param name="chunk">Chunk without elements.</param>
+                        void Free(Chunk * chunk) noexcept
+                        {
+                            ByteAllocator(_allocator).deallocate(static_cast<char *>(chunk->Memory), ChunkBytes);
+                        }
+
+                        /// <summary>
+                        /// Finds element on specified index.
+                        /// </summary>
+                        /// <param name="idx">Index of element.</param>
+                        /// <returns>The element.</returns>
+                        T * ElementAt(unsigned idx) const
+                        {
+                            if (idx >= _size)
+                            {
+                                throw std::exception("Index out of bounds.");
+                            }
+
+                            Chunk * chunk = _head;
+
+                            while (idx >= chunk->End - chunk->Begin)
+                            {
+                                idx -= chunk->End - chunk->Begin;
+                                chunk = chunk->Next;
+                            }
+
+                            return chunk->At(chunk->Begin + idx);
+                        }
+
+                        /// <summary>
+                        /// First chunk.
+                        /// </summary>
+                        Chunk * _head;
+
+                        /// <summary>
+                        /// Last chunk.
+                        /// </summary>
+                        Chunk * _tail;
+
+                        /// <summary>
+                        /// Emptied chunks kept for reuse.
+                        /// </summary>
+                        Chunk * _spare;
+
+                        /// <summary>
+                        /// List size.
+                        /// </summary>
+                        unsigned _size;
+
+                        /// <summary>
+                        /// Number of spare chunks.
+                        /// </summary>
+                        unsigned _spareCount;
+
+                        /// <summary>
+                        /// Allocator of chunks.
+                        /// </summary>
+                        TAllocator _allocator;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
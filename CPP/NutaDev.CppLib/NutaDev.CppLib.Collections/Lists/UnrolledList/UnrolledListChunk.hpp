@@ -0,0 +1,88 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_LISTS_UNROLLEDLIST_UNROLLEDLISTCHUNK_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_LISTS_UNROLLEDLIST_UNROLLEDLISTCHUNK_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../../Memory/CacheLine.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Lists
+            {
+                namespace UnrolledList
+                {
+                    /// <summary>
+                    /// A list chunk. Holds elements in range [Begin, End) of its array, the array starts on a cache line.
+                    /// </summary>
+                    template <typename T, std::size_t TCapacity>
+                    struct alignas(Memory::CacheLineSize) UnrolledListChunk
+                    {
+                        /// <summary>
+                        /// Gets element on specified index of the array.
+                        /// </summary>
+                        /// <param name="idx">Index in the array.</param>
+                        /// <returns>The element.</returns>
+                        T * At(std::size_t idx) noexcept
+                        {
+                            return reinterpret_cast<T *>(&Items[idx]);
+                        }
+
+                        /// <summary>
+                        /// Storage of elements.
+                        /// </summary>
+                        typename std::aligned_storage<sizeof(T), alignof(T)>::type Items[TCapacity];
+
+                        /// <summary>
+                        /// Next chunk.
+                        /// </summary>
+                        UnrolledListChunk * Next;
+
+                        /// <summary>
+                        /// Memory block the chunk has been aligned in.
+                        /// </summary>
+                        void * Memory;
+
+                        /// <summary>
+                        /// Index of the first element.
+                        /// </summary>
+                        unsigned Begin;
+
+                        /// <summary>
+                        /// Index past the last element.
+                        /// </summary>
+                        unsigned End;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
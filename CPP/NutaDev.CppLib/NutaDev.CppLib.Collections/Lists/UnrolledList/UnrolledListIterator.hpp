@@ -0,0 +1,179 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_LISTS_UNROLLEDLIST_UNROLLEDLISTITERATOR_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_LISTS_UNROLLEDLIST_UNROLLEDLISTITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "UnrolledListChunk.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Lists
+            {
+                namespace UnrolledList
+                {
+                    template <typename T, std::size_t TChunkCapacity, typename TAllocator>
+                    class UnrolledList;
+
+                    /// <summary>
+                    /// Forward iterator of UnrolledList. TValue is T or const T. Walks the array of a chunk and moves to
+                    /// the next chunk only at its end.
+                    /// </summary>
+                    template <typename T, typename TValue, std::size_t TChunkCapacity>
+                    class UnrolledListIterator
+                    {
+                    public:
+                        typedef std::forward_iterator_tag iterator_category;
+                        typedef typename std::remove_const<TValue>::type value_type;
+                        typedef std::ptrdiff_t difference_type;
+                        typedef TValue * pointer;
+                        typedef TValue & reference;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class which points nowhere.
+                        /// </summary>
+                        UnrolledListIterator()
+                            : _chunk(nullptr)
+                            , _idx(0)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, converts iterator to const iterator.
+                        /// </summary>
+                        /// <param name="other">Iterator to convert.</param>
+                        template<typename TOther, typename = typename std::enable_if<std::is_const<TValue>::value && std::is_same<TOther, T>::value>::type>
+                        UnrolledListIterator(const UnrolledListIterator<T, TOther, TChunkCapacity> & other)
+                            : _chunk(other._chunk)
+                            , _idx(other._idx)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Gets the current element.
+                        /// </summary>
+                        /// <returns>The element.</returns>
+                        reference operator*() const
+                        {
+                            return *_chunk->At(_idx);
+                        }
+
+                        /// <summary>
+                        /// Gets the current element.
+                        /// </summary>
+                        /// <returns>Pointer to the element.</returns>
+                        pointer operator->() const
+                        {
+                            return _chunk->At(_idx);
+                        }
+
+                        /// <summary>
+                        /// Moves to the next element.
+                        /// </summary>
+                        /// <returns>Reference to itself.</returns>
+                        UnrolledListIterator<T, TValue, TChunkCapacity> & operator++()
+                        {
+                            if (++_idx == _chunk->End)
+                            {
+                                _chunk = _chunk->Next;
+                                _idx = _chunk != nullptr ? _chunk->Begin : 0;
+                            }
+
+                            return *this;
+                        }
+
+                        /// <summary>
+                        /// Moves to the next element.
+                        /// </summary>
+                        /// <returns>Copy of the iterator before the move.</returns>
+                        UnrolledListIterator<T, TValue, TChunkCapacity> operator++(int)
+                        {
+                            UnrolledListIterator<T, TValue, TChunkCapacity> copy(*this);
+                            ++(*this);
+                            return copy;
+                        }
+
+                        /// <summary>
+                        /// Compares iterators.
+                        /// </summary>
+                        /// <param name="other">Another iterator.</param>
+                        /// <returns>True if both point to the same element or both are at the end.</returns>
+                        template<typename TOther>
+                        bool operator==(const UnrolledListIterator<T, TOther, TChunkCapacity> & other) const
+                        {
+                            return _chunk == other._chunk && _idx == other._idx;
+                        }
+
+                        /// <summary>
+                        /// Compares iterators.
+                        /// </summary>
+                        /// <param name="other">Another iterator.</param>
+                        /// <returns>True if iterators differ.</returns>
+                        template<typename TOther>
+                        bool operator!=(const UnrolledListIterator<T, TOther, TChunkCapacity> & other) const
+                        {
+                            return !(*this == other);
+                        }
+
+                    private:
+                        template <typename, std::size_t, typename>
+                        friend class UnrolledList;
+
+                        template <typename, typename, std::size_t>
+                        friend class UnrolledListIterator;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="chunk">Current chunk, nullptr at the end.</param>
+                        /// <param name="idx">Index in the chunk array.</param>
+                        UnrolledListIterator(UnrolledListChunk<T, TChunkCapacity> * chunk, unsigned idx)
+                            : _chunk(chunk)
+                            , _idx(idx)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Current chunk.
+                        /// </summary>
+                        UnrolledListChunk<T, TChunkCapacity> * _chunk;
+
+                        /// <summary>
+                        /// Index in the chunk array.
+                        /// </summary>
+                        unsigned _idx;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_MEMORY_ARENAALLOCATOR_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_MEMORY_ARENAALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+#include "MonotonicArena.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Memory
+            {
+                /// <summary>
+                /// Allocator that takes memory from MonotonicArena, deallocation does nothing. A default constructed
+                /// allocator has no arena and uses global new and delete, like the default resource of std::pmr.
+                /// Allocators are equal when they use the same arena.
+                /// </summary>
+                template<typename T>
+                class ArenaAllocator
+                {
+                    static_assert(alignof(T) <= alignof(std::max_align_t), "ArenaAllocator supports only default alignment.");
+
+                public:
+                    typedef T value_type;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class that uses global new and delete.
+                    /// </summary>
+                    ArenaAllocator() noexcept
+                        : _arena(nullptr)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="arena">Arena that provides memory, must outlive all containers that use it.</param>
+                    ArenaAllocator(MonotonicArena & arena) noexcept
+                        : _arena(&arena)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class from allocator of another type.
+                    /// </summary>
+                    /// <param name="other">Allocator with the arena.</param>
+                    template<typename TOther>
+                    ArenaAllocator(const ArenaAllocator<TOther> & other) noexcept
+                        : _arena(other.Arena())
+                    {
+                    }
+
+                    /// <summary>
+                    /// Allocates memory for specified number of objects.
+                    /// </summary>
+                    /// <param name="count">Number of objects.</param>
+                    /// <returns>Pointer to the memory.</returns>
+                    T * allocate(std::size_t count)
+                    {
+                        if (count > static_cast<std::size_t>(-1) / sizeof(T))
+                        {
+                            throw std::bad_alloc();
+                        }
+
+                        if (_arena == nullptr)
+                        {
+                            return static_cast<T *>(::operator new(count * sizeof(T)));
+                        }
+
+                        return static_cast<T *>(_arena->Allocate(count * sizeof(T), alignof(T)));
+                    }
+
+                    /// <summary>
+                    /// Releases memory allocated without arena, memory of the arena is released with the arena.
+                    /// </summary>
+                    /// <param name="pointer">Pointer to the memory.</param>
+                    void deallocate(T * pointer, std::size_t) noexcept
+                    {
+                        if (_arena == nullptr)
+                        {
+                            ::operator delete(pointer);
+                        }
+                    }
+
+                    /// <summary>
+                    /// Gets the arena.
+                    /// </summary>
+                    /// <returns>The arena or nullptr.</returns>
+                    MonotonicArena * Arena() const noexcept
+                    {
+                        return _arena;
+                    }
+
+                private:
+                    /// <summary>
+                    /// Arena that provides memory.
+                    /// </summary>
+                    MonotonicArena * _arena;
+                };
+
+                /// <summary>
+                /// Compares allocators, they are equal when they use the same arena.
+                /// </summary>
+                template<typename T, typename TOther>
+                bool operator==(const ArenaAllocator<T> & left, const ArenaAllocator<TOther> & right) noexcept
+                {
+                    return left.Arena() == right.Arena();
+                }
+
+                /// <summary>
+                /// Compares allocators, they are equal when they use the same arena.
+                /// </summary>
+                template<typename T, typename TOther>
+                bool operator!=(const ArenaAllocator<T> & left, const ArenaAllocator<TOther> & right) noexcept
+                {
+                    return left.Arena() != right.Arena();
+                }
+            }
+        }
+    }
+}
+
+#endif
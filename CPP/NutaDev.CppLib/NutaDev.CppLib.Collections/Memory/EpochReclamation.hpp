@@ -0,0 +1,412 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_MEMORY_EPOCHRECLAMATION_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_MEMORY_EPOCHRECLAMATION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Memory
+            {
+                /// <summary>
+                /// Epoch-based reclamation of nodes of lock-free structures. Threads read shared nodes only inside
+                /// a Guard, which announces the global epoch the thread has seen. A node unlinked from a structure is
+                /// retired in the current epoch and reclaimed once the global epoch has advanced twice, because every
+                /// thread that could still hold a pointer to it must have left its Guard by then. The epoch advances
+                /// when all threads inside a Guard have seen it.
+                /// </summary>
+                class EpochReclamation
+                {
+                private:
+                    /// <summary>
+                    /// State of a thread.
+                    /// </summary>
+                    struct ThreadRecord;
+
+                public:
+                    /// <summary>
+                    /// Function that reclaims a retired node.
+                    /// </summary>
+                    typedef void (*Reclaimer)(void *);
+
+                    /// <summary>
+                    /// Critical section of the calling thread, pointers to shared nodes are valid while it lives. Guards may be nested.
+                    /// </summary>
+                    class Guard
+                    {
+                    public:
+                        /// <summary>
+                        /// Enters the critical section.
+                        /// </summary>
+                        Guard()
+                            : _record(EpochReclamation::Local())
+                        {
+                            if (_record->Nesting++ == 0)
+                            {
+                                std::uint64_t epoch = Domain().Epoch.load(std::memory_order_relaxed);
+
+                                for (;;)
+                                {
+                                    _record->Announced.store(Announce(epoch), std::memory_order_relaxed);
+                                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                                    std::uint64_t current = Domain().Epoch.load(std::memory_order_relaxed);
+                                    if (current == epoch)
+                                    {
+                                        break;
+                                    }
+
+                                    epoch = current;
+                                }
+                            }
+                        }
+
+                        /// <summary>
+                        /// Leaves the critical section.
+                        /// </summary>
+                        ~Guard()
+                        {
+                            if (--_record->Nesting == 0)
+                            {
+                                _record->Announced.store(Inactive, std::memory_order_release);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Guard belongs to its scope and thread.
+                        /// </summary>
+                        Guard(const Guard & other) = delete;
+
+                        /// <summary>
+                        /// Guard belongs to its scope and thread.
+                        /// </summary>
+                        Guard & operator=(const Guard & other) = delete;
+
+                    private:
+                        /// <summary>
+                        /// Record of the calling thread.
+                        /// </summary>
+                        ThreadRecord * _record;
+                    };
+
+                    /// <summary>
+                    /// Retires a node unlinked from a structure, it's reclaimed when no thread can reach it.
+                    /// </summary>
+                    /// <param name="pointer">Pointer to the node.</param>
+                    /// <param name="reclaimer">Function that reclaims the node.</param>
+                    static void Retire(void * pointer, Reclaimer reclaimer)
+                    {
+                        ThreadRecord * record = Local();
+                        std::uint64_t epoch = Domain().Epoch.load(std::memory_order_acquire);
+
+                        Collect(*record, epoch);
+
+                        Limbo & limbo = record->Limbos[epoch % LimboCount];
+                        limbo.Epoch = epoch;
+                        limbo.Nodes.push_back(Retired(pointer, reclaimer));
+
+                        if (++record->RetiredSinceAdvance >= AdvanceInterval)
+                        {
+                            record->RetiredSinceAdvance = 0;
+                            TryAdvance(epoch);
+                        }
+                    }
+
+                    /// <summary>
+                    /// Number of retired nodes between attempts to advance the epoch.
+                    /// </summary>
+                    static const unsigned AdvanceInterval = 64;
+
+                private:
+                    /// <summary>
+                    /// Announcement of a thread outside any Guard.
+                    /// </summary>
+                    static const std::uint64_t Inactive = 0;
+
+                    /// <summary>
+                    /// Number of limbo lists, nodes retired in epoch e are in list e % LimboCount.
+                    /// </summary>
+                    static const std::size_t LimboCount = 3;
+
+                    /// <summary>
+                    /// Retired node.
+                    /// </summary>
+                    struct Retired
+                    {
+                        Retired(void * pointer, Reclaimer reclaimer)
+                            : Pointer(pointer)
+                            , Reclaim(reclaimer)
+                        {
+                        }
+
+                        void * Pointer;
+
+                        Reclaimer Reclaim;
+                    };
+
+                    /// <summary>
+                    /// Nodes retired in one epoch.
+                    /// </summary>
+                    struct Limbo
+                    {
+                        Limbo()
+                            : Epoch(0)
+                        {
+                        }
+
+                        std::uint64_t Epoch;
+
+                        std::vector<Retired> Nodes;
+                    };
+
+                    /// <summary>
+                    /// State of a thread. Records are never freed, a record of an ended thread is taken over by a new one
+                    /// together with its limbo lists.
+                    /// </summary>
+                    struct ThreadRecord
+                    {
+                        ThreadRecord()
+                            : Announced(Inactive)
+                            , Owned(true)
+                            , Next(nullptr)
+                            , Nesting(0)
+                            , RetiredSinceAdvance(0)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Epoch seen by the thread inside a Guard, see Announce, or Inactive.
+                        /// </summary>
+                        std::atomic<std::uint64_t> Announced;
+
+                        /// <summary>
+                        /// Indicates whether a living thread uses the record.
+                        /// </summary>
+                        std::atomic<bool> Owned;
+
+                        /// <summary>
+                        /// Next record.
+                        /// </summary>
+                        ThreadRecord * Next;
+
+                        /// <summary>
+                        /// Depth of nested Guards.
+                        /// </summary>
+                        unsigned Nesting;
+
+                        /// <summary>
+                        /// Number of nodes retired since the last attempt to advance the epoch.
+                        /// </summary>
+                        unsigned RetiredSinceAdvance;
+
+                        /// <summary>
+                        /// Retired nodes.
+                        /// </summary>
+                        Limbo Limbos[LimboCount];
+
+                        /// <summary>
+                        /// Keeps announcements of different threads on separate cache lines.
+                        /// </summary>
+                        char Padding[64];
+                    };
+
+                    /// <summary>
+                    /// Global state.
+                    /// </summary>
+                    struct State
+                    {
+                        State()
+                            : Epoch(1)
+                            , Records(nullptr)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Reclaims remaining nodes when the process ends.
+                        /// </summary>
+                        ~State()
+                        {
+                            ThreadRecord * record = Records.load();
+
+                            while (record != nullptr)
+                            {
+                                for (Limbo & limbo : record->Limbos)
+                                {
+                                    Reclaim(limbo);
+                                }
+
+                                ThreadRecord * next = record->Next;
+                                delete record;
+                                record = next;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Global epoch.
+                        /// </summary>
+                        std::atomic<std::uint64_t> Epoch;
+
+                        /// <summary>
+                        /// Records of all threads that used reclamation.
+                        /// </summary>
+                        std::atomic<ThreadRecord *> Records;
+                    };
+
+                    /// <summary>
+                    /// Releases the record of the thread when the thread ends.
+                    /// </summary>
+                    struct ThreadSlot
+                    {
+                        ThreadSlot()
+                            : Record(nullptr)
+                        {
+                        }
+
+                        ~ThreadSlot()
+                        {
+                            if (Record != nullptr)
+                            {
+                                Record->Owned.store(false, std::memory_order_release);
+                            }
+                        }
+
+                        ThreadRecord * Record;
+                    };
+
+                    /// <summary>
+                    /// Encodes announced epoch, never equal to Inactive.
+                    /// </summary>
+                    static std::uint64_t Announce(std::uint64_t epoch) noexcept
+                    {
+                        return (epoch << 1) | 1;
+                    }
+
+                    /// <summary>
+                    /// Gets global state.
+                    /// </summary>
+                    static State & Domain()
+                    {
+                        static State state;
+                        return state;
+                    }
+
+                    /// <summary>
+                    /// Gets record of the calling thread, takes over a free record or adds a new one.
+                    /// </summary>
+                    static ThreadRecord * Local()
+                    {
+                        static thread_local ThreadSlot slot;
+
+                        if (slot.Record != nullptr)
+                        {
+                            return slot.Record;
+                        }
+
+                        State & state = Domain();
+
+                        for (ThreadRecord * record = state.Records.load(std::memory_order_acquire); record != nullptr; record = record->Next)
+                        {
+                            bool owned = false;
+                            if (!record->Owned.load(std::memory_order_relaxed) && record->Owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+                            {
+                                slot.Record = record;
+                                return record;
+                            }
+                        }
+
+                        ThreadRecord * record = new ThreadRecord();
+                        ThreadRecord * head = state.Records.load(std::memory_order_relaxed);
+
+                        do
+                        {
+                            record->Next = head;
+                        }
+                        while (!state.Records.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+
+                        slot.Record = record;
+                        return record;
+                    }
+
+                    /// <summary>
+                    /// Reclaims limbo lists of the record that no thread can reach in the specified epoch.
+                    /// </summary>
+                    static void Collect(ThreadRecord & record, std::uint64_t epoch)
+                    {
+                        for (Limbo & limbo : record.Limbos)
+                        {
+                            if (limbo.Epoch + 2 <= epoch)
+                            {
+                                Reclaim(limbo);
+                            }
+                        }
+                    }
+
+                    /// <summary>
+                    /// Reclaims all nodes of the limbo list.
+                    /// </summary>
+                    static void Reclaim(Limbo & limbo)
+                    {
+                        for (Retired & retired : limbo.Nodes)
+                        {
+                            retired.Reclaim(retired.Pointer);
+                        }
+
+                        limbo.Nodes.clear();
+                    }
+
+                    /// <summary>
+                    /// Advances the global epoch if every thread inside a Guard has seen it.
+                    /// </summary>
+                    static void TryAdvance(std::uint64_t epoch)
+                    {
+                        State & state = Domain();
+
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                        for (ThreadRecord * record = state.Records.load(std::memory_order_acquire); record != nullptr; record = record->Next)
+                        {
+                            std::uint64_t announced = record->Announced.load(std::memory_order_acquire);
+
+                            if (announced != Inactive && announced != Announce(epoch))
+                            {
+                                return;
+                            }
+                        }
+
+                        state.Epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+                    }
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,256 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_MEMORY_MONOTONICARENA_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_MEMORY_MONOTONICARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Memory
+            {
+                /// <summary>
+                /// Arena that hands out memory from growing blocks and releases all of it at once. Deallocation of
+                /// single objects does nothing, so containers that use the arena, e.g. for one request, can be
+                /// dropped together without visiting their nodes. Not thread safe, use one arena per thread.
+                /// </summary>
+                class MonotonicArena
+                {
+                public:
+                    /// <summary>
+                    /// Size at which blocks stop growing. Allocations larger than the next block get a block of their own
+                    /// and don't change the size of the following blocks.
+                    /// </summary>
+                    static const std::size_t MaximumBlockSize = 1 << 20;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="initialBlockSize">Size of the first block in bytes, next blocks double in size up to MaximumBlockSize.</param>
+                    explicit MonotonicArena(std::size_t initialBlockSize = 4096)
+                        : _blocks(nullptr)
+                        , _cursor(nullptr)
+                        , _end(nullptr)
+                        , _initialBlockSize(initialBlockSize > 0 ? initialBlockSize : 1)
+                        , _nextBlockSize(_initialBlockSize)
+                        , _allocatedBytes(0)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Arena owns its blocks and can't be copied.
+                    /// </summary>
+                    MonotonicArena(const MonotonicArena & other) = delete;
+
+                    /// <summary>
+                    /// Arena owns its blocks and can't be copied.
+                    /// </summary>
+                    MonotonicArena & operator=(const MonotonicArena & other) = delete;
+
+                    /// <summary>
+                    /// Destructs the instance of this class, releases all blocks.
+                    /// </summary>
+                    ~MonotonicArena()
+                    {
+                        Release();
+                    }
+
+                    /// <summary>
+                    /// Allocates memory.
+                    /// </summary>
+                    /// <param name="size">Size in bytes.</param>
+                    /// <param name="alignment">Alignment, a power of two up to alignment of std::max_align_t.</param>
+                    /// <returns>Pointer to the memory.</returns>
+                    void * Allocate(std::size_t size, std::size_t alignment)
+                    {
+                        if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > alignof(std::max_align_t))
+                        {
+                            throw std::exception("Unsupported alignment.");
+                        }
+
+                        char * result = Align(_cursor, alignment);
+
+                        if (_cursor == nullptr || result > _end || size > static_cast<std::size_t>(_end - result))
+                        {
+                            if (size > _nextBlockSize)
+                            {
+                                result = AddOwnBlock(size);
+                                _allocatedBytes += size;
+
+                                return result;
+                            }
+
+                            AddBlock();
+                            result = _cursor;
+                        }
+
+                        _cursor = result + size;
+                        _allocatedBytes += size;
+
+                        return result;
+                    }
+
+                    /// <summary>
+                    /// Releases all blocks. Memory allocated from the arena can't be used afterwards.
+                    /// </summary>
+                    void Release() noexcept
+                    {
+                        while (_blocks != nullptr)
+                        {
+                            Block * next = _blocks->Next;
+                            ::operator delete(_blocks);
+                            _blocks = next;
+                        }
+
+                        _cursor = nullptr;
+                        _end = nullptr;
+                        _nextBlockSize = _initialBlockSize;
+                        _allocatedBytes = 0;
+                    }
+
+                    /// <summary>
+                    /// Gets number of bytes allocated since creation or the last release.
+                    /// </summary>
+                    /// <returns>Number of bytes.</returns>
+                    std::size_t AllocatedBytes() const noexcept
+                    {
+                        return _allocatedBytes;
+                    }
+
+                private:
+                    /// <summary>
+                    /// Header of a block, the memory follows it.
+                    /// </summary>
+                    struct alignas(std::max_align_t) Block
+                    {
+                        Block * Next;
+                    };
+
+                    /// <summary>
+                    /// Rounds pointer up to alignment.
+                    /// </summary>
+                    static char * Align(char * pointer, std::size_t alignment) noexcept
+                    {
+                        return reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(pointer) + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1));
+                    }
+
+                    /// <summary>
+                    /// Allocates the next block, following allocations are served from it.
+                    /// </summary>
+                    void AddBlock()
+                    {
+                        Block * block = NewBlock(_nextBlockSize);
+                        block->Next = _blocks;
+                        _blocks = block;
+
+                        _cursor = reinterpret_cast<char *>(block + 1);
+                        _end = _cursor + _nextBlockSize;
+
+                        if (_nextBlockSize < MaximumBlockSize)
+                        {
+                            _nextBlockSize = _nextBlockSize < MaximumBlockSize / 2 ? _nextBlockSize * 2 : MaximumBlockSize;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Allocates a block for one allocation. The block goes behind the newest one, so the free memory
+                    /// of the newest block can still be used.
+                    /// </summary>
+                    /// <param name="size">Number of bytes.</param>
+                    /// <returns>Memory of the block.</returns>
+                    char * AddOwnBlock(std::size_t size)
+                    {
+                        Block * block = NewBlock(size);
+
+                        if (_blocks == nullptr)
+                        {
+                            block->Next = nullptr;
+                            _blocks = block;
+                        }
+                        else
+                        {
+                            block->Next = _blocks->Next;
+                            _blocks->Next = block;
+                        }
+
+                        return reinterpret_cast<char *>(block + 1);
+                    }
+
+                    /// <summary>
+                    /// Allocates memory of a block.
+                    /// </summary>
+                    /// <param name="size">Number of bytes after the header.</param>
+                    /// <returns>The block.</returns>
+                    static Block * NewBlock(std::size_t size)
+                    {
+                        if (size > static_cast<std::size_t>(-1) - sizeof(Block))
+                        {
+                            throw std::bad_alloc();
+                        }
+
+                        return static_cast<Block *>(::operator new(sizeof(Block) + size));
+                    }
+
+                    /// <summary>
+                    /// Allocated blocks, the newest first.
+                    /// </summary>
+                    Block * _blocks;
+
+                    /// <summary>
+                    /// Free memory of the newest block.
+                    /// </summary>
+                    char * _cursor;
+
+                    /// <summary>
+                    /// End of the newest block.
+                    /// </summary>
+                    char * _end;
+
+                    /// <summary>
+                    /// Size of the first block.
+                    /// </summary>
+                    std::size_t _initialBlockSize;
+
+                    /// <summary>
+                    /// Size of the next block.
+                    /// </summary>
+                    std::size_t _nextBlockSize;
+
+                    /// <summary>
+                    /// Number of allocated bytes.
+                    /// </summary>
+                    std::size_t _allocatedBytes;
+                };
+            }
+        }
+    }
+}
+
+#endif
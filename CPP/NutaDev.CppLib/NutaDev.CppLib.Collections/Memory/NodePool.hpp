@@ -0,0 +1,282 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_MEMORY_NODEPOOL_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_MEMORY_NODEPOOL_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Memory
+            {
+                /// <summary>
+                /// Pool of fixed-size memory blocks shared by all containers whose nodes have the same size.
+                /// Each thread keeps its own free list, so allocation and deallocation take no lock. When a thread
+                /// frees much more than it allocates, e.g. a consumer, it hands batches of blocks over to the shared
+                /// list where threads that allocate more, e.g. producers, pick them up. Blocks are never returned
+                /// to the system before the process ends, in steady state the pool does no allocation at all.
+                /// </summary>
+                template<std::size_t TSize, std::size_t TAlignment = alignof(std::max_align_t)>
+                class NodePool
+                {
+                public:
+                    static_assert(TAlignment <= alignof(std::max_align_t), "NodePool supports only default alignment.");
+
+                    /// <summary>
+                    /// Allocates a block of TSize bytes.
+                    /// </summary>
+                    /// <returns>Pointer to the block.</returns>
+                    static void * Allocate()
+                    {
+                        if (Released())
+                        {
+                            return ::operator new(BlockSize);
+                        }
+
+                        LocalCache & local = Local();
+
+                        if (local.Head == nullptr && !Shared().TakeBatch(local))
+                        {
+                            return ::operator new(BlockSize);
+                        }
+
+                        FreeBlock * block = local.Head;
+                        local.Head = block->Next;
+                        local.Count--;
+
+                        return block;
+                    }
+
+                    /// <summary>
+                    /// Returns a block to the pool. The block may be allocated by any thread.
+                    /// </summary>
+                    /// <param name="pointer">Pointer to the block.</param>
+                    static void Deallocate(void * pointer) noexcept
+                    {
+                        if (Released())
+                        {
+                            ::operator delete(pointer);
+                            return;
+                        }
+
+                        LocalCache & local = Local();
+
+                        FreeBlock * block = static_cast<FreeBlock *>(pointer);
+                        block->Next = local.Head;
+                        local.Head = block;
+                        local.Count++;
+
+                        if (local.Count >= 2 * BatchSize)
+                        {
+                            Shared().GiveBatch(local, BatchSize);
+                        }
+                    }
+
+                    /// <summary>
+                    /// Number of blocks moved between a thread and the shared list at once.
+                    /// </summary>
+                    static const std::size_t BatchSize = 64;
+
+                private:
+                    /// <summary>
+                    /// Free block, the link is stored in the block itself.
+                    /// </summary>
+                    struct FreeBlock
+                    {
+                        FreeBlock * Next;
+                    };
+
+                    /// <summary>
+                    /// Size of a block, large enough for the link and a multiple of alignment.
+                    /// </summary>
+                    static const std::size_t BlockSize = ((TSize > sizeof(FreeBlock) ? TSize : sizeof(FreeBlock)) + TAlignment - 1) / TAlignment * TAlignment;
+
+                    /// <summary>
+                    /// Free list of one thread.
+                    /// </summary>
+                    struct LocalCache
+                    {
+                        LocalCache()
+                            : Head(nullptr)
+                            , Count(0)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Hands the blocks over to the shared list when the thread ends.
+                        /// </summary>
+                        ~LocalCache()
+                        {
+                            if (Count > 0)
+                            {
+                                Shared().GiveBatch(*this, Count);
+                            }
+
+                            Released() = true;
+                        }
+
+                        FreeBlock * Head;
+
+                        std::size_t Count;
+                    };
+
+                    /// <summary>
+                    /// Batches of free blocks exchanged between threads.
+                    /// </summary>
+                    class SharedList
+                    {
+                    public:
+                        /// <summary>
+                        /// Moves a batch to the thread, if there is any.
+                        /// </summary>
+                        /// <param name="local">Empty free list of the thread.</param>
+                        /// <returns>True if the thread got a batch.</returns>
+                        bool TakeBatch(LocalCache & local)
+                        {
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            if (_batches.empty())
+                            {
+                                return false;
+                            }
+
+                            local.Head = _batches.back().Head;
+                            local.Count = _batches.back().Count;
+                            _batches.pop_back();
+
+                            return true;
+                        }
+
+                        /// <summary>
+                        /// Moves blocks from the head of the thread free list into a new batch.
+                        /// </summary>
+                        /// <param name="local">Free list of the thread.</param>
+                        /// <param name="count">Number of blocks to move.</param>
+                        void GiveBatch(LocalCache & local, std::size_t count) noexcept
+                        {
+                            Batch batch;
+                            batch.Head = local.Head;
+                            batch.Count = count;
+
+                            FreeBlock * last = local.Head;
+                            for (std::size_t i = 1; i < count; ++i)
+                            {
+                                last = last->Next;
+                            }
+
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            try
+                            {
+                                _batches.push_back(batch);
+                            }
+                            catch (...)
+                            {
+                                // The thread keeps its blocks when there is no memory to register the batch.
+                                return;
+                            }
+
+                            local.Head = last->Next;
+                            local.Count -= count;
+                            last->Next = nullptr;
+                        }
+
+                        /// <summary>
+                        /// Releases blocks when the process ends.
+                        /// </summary>
+                        ~SharedList()
+                        {
+                            for (Batch & batch : _batches)
+                            {
+                                while (batch.Head != nullptr)
+                                {
+                                    FreeBlock * next = batch.Head->Next;
+                                    ::operator delete(batch.Head);
+                                    batch.Head = next;
+                                }
+                            }
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Chain of free blocks.
+                        /// </summary>
+                        struct Batch
+                        {
+                            FreeBlock * Head;
+
+                            std::size_t Count;
+                        };
+
+                        /// <summary>
+                        /// Synchronization context.
+                        /// </summary>
+                        std::mutex _synch;
+
+                        /// <summary>
+                        /// Available batches.
+                        /// </summary>
+                        std::vector<Batch> _batches;
+                    };
+
+                    /// <summary>
+                    /// Gets free list of the calling thread.
+                    /// </summary>
+                    static LocalCache & Local()
+                    {
+                        static thread_local LocalCache cache;
+                        return cache;
+                    }
+
+                    /// <summary>
+                    /// Indicates whether free list of the calling thread has been destroyed, blocks released later,
+                    /// e.g. by destructors of static objects, go straight to the system.
+                    /// </summary>
+                    static bool & Released()
+                    {
+                        static thread_local bool released = false;
+                        return released;
+                    }
+
+                    /// <summary>
+                    /// Gets the shared list.
+                    /// </summary>
+                    static SharedList & Shared()
+                    {
+                        static SharedList shared;
+                        return shared;
+                    }
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,132 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_MEMORY_POOLALLOCATOR_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_MEMORY_POOLALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+#include "NodePool.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Memory
+            {
+                /// <summary>
+                /// Allocator that takes single objects from NodePool, so nodes of containers are recycled through
+                /// thread local free lists instead of the global allocator. Arrays go to global new, so over-aligned
+                /// types are not supported. The allocator has no state, all instances are interchangeable.
+                /// </summary>
+                template<typename T>
+                class PoolAllocator
+                {
+                    static_assert(alignof(T) <= alignof(std::max_align_t), "PoolAllocator supports only default alignment.");
+
+                public:
+                    typedef T value_type;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    PoolAllocator() noexcept
+                    {
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class from allocator of another type.
+                    /// </summary>
+                    template<typename TOther>
+                    PoolAllocator(const PoolAllocator<TOther> &) noexcept
+                    {
+                    }
+
+                    /// <summary>
+                    /// Allocates memory for specified number of objects.
+                    /// </summary>
+                    /// <param name="count">Number of objects.</param>
+                    /// <returns>Pointer to the memory.</returns>
+                    T * allocate(std::size_t count)
+                    {
+                        if (count == 1)
+                        {
+                            return static_cast<T *>(Pool::Allocate());
+                        }
+
+                        if (count > static_cast<std::size_t>(-1) / sizeof(T))
+                        {
+                            throw std::bad_alloc();
+                        }
+
+                        return static_cast<T *>(::operator new(count * sizeof(T)));
+                    }
+
+                    /// <summary>
+                    /// Releases memory.
+                    /// </summary>
+                    /// <param name="pointer">Pointer to the memory.</param>
+                    /// <param name="count">Number of objects it has been allocated for.</param>
+                    void deallocate(T * pointer, std::size_t count) noexcept
+                    {
+                        if (count == 1)
+                        {
+                            Pool::Deallocate(pointer);
+                            return;
+                        }
+
+                        ::operator delete(pointer);
+                    }
+
+                private:
+                    /// <summary>
+                    /// Pool of single objects.
+                    /// </summary>
+                    typedef NodePool<sizeof(T), alignof(T)> Pool;
+                };
+
+                /// <summary>
+                /// Compares allocators, memory of any of them can be released by any other.
+                /// </summary>
+                template<typename T, typename TOther>
+                bool operator==(const PoolAllocator<T> &, const PoolAllocator<TOther> &) noexcept
+                {
+                    return true;
+                }
+
+                /// <summary>
+                /// Compares allocators, memory of any of them can be released by any other.
+                /// </summary>
+                template<typename T, typename TOther>
+                bool operator!=(const PoolAllocator<T> &, const PoolAllocator<TOther> &) noexcept
+                {
+                    return false;
+                }
+            }
+        }
+    }
+}
+
+#endif
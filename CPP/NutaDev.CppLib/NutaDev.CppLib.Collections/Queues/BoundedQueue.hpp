@@ -0,0 +1,357 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_BOUNDEDQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_BOUNDEDQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../Memory/CacheLine.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                /// <summary>
+                /// Bounded lock-free multi-producer multi-consumer queue. Items are stored in a power-of-two ring
+                /// of cache line sized cells, each cell carries a sequence number that tells producers and
+                /// consumers whether it is free or holds an item (D. Vyukov's algorithm). Enqueue and dequeue
+                /// never allocate and never fail because of another thread, only because the queue is full or empty.
+                /// T has to be nothrow movable: a claimed cell must be filled or emptied, otherwise the ring stalls.
+                /// </summary>
+                template<typename T>
+                class BoundedQueue
+                {
+                    static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+                        "BoundedQueue requires nothrow move construction and assignment.");
+
+                public:
+                    /// <summary>
+                    /// Tries to enqueue element.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True if item has been enqueued, false if queue is full.</returns>
+                    bool TryEnqueue(T && item)
+                    {
+                        return TryEmplace(std::move(item));
+                    }
+
+                    /// <summary>
+                    /// Tries to enqueue element.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True if item has been enqueued, false if queue is full.</returns>
+                    bool TryEnqueue(T & item)
+                    {
+                        return TryEmplace(item);
+                    }
+
+                    /// <summary>
+                    /// Tries to enqueue element.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True if item has been enqueued, false if queue is full.</returns>
+                    bool TryEnqueue(const T & item)
+                    {
+                        return TryEmplace(item);
+                    }
+
+                    /// <summary>
+                    /// Tries to construct element in place at the end of queue.
+                    /// </summary>
+                    /// <param name="args">Arguments of the element constructor.</param>
+                    /// <returns>True if item has been enqueued, false if queue is full.</returns>
+                    template<typename... TArgs>
+                    bool TryEmplace(TArgs &&... args)
+                    {
+                        return Emplace(std::is_nothrow_constructible<T, TArgs &&...>(), std::forward<TArgs>(args)...);
+                    }
+
+                    /// <summary>
+                    /// Tries to dequeue element from queue.
+                    /// </summary>
+                    /// <param name="item">Item to dequeue.</param>
+                    /// <returns>True if item has been dequeued, false if queue is empty.</returns>
+                    bool TryDequeue(T & item)
+                    {
+                        std::size_t position = _dequeuePosition.load(std::memory_order_relaxed);
+                        Cell * cell;
+
+                        for (;;)
+                        {
+                            cell = &_cells[position & _mask];
+                            std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+                            std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+
+                            if (difference == 0)
+                            {
+                                if (_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                                {
+                                    break;
+                                }
+                            }
+                            else if (difference < 0)
+                            {
+                                return false;
+                            }
+                            else
+                            {
+                                position = _dequeuePosition.load(std::memory_order_relaxed);
+                            }
+                        }
+
+                        T * stored = cell->Item();
+                        item = std::move(*stored);
+                        stored->~T();
+
+                        cell->Sequence.store(position + _mask + 1, std::memory_order_release);
+
+                        return true;
+                    }
+
+                    /// <summary>
+                    /// Gets number of elements. The value is a snapshot and may be stale when other threads
+                    /// use the queue.
+                    /// </summary>
+                    /// <returns>Size of queue.</returns>
+                    unsigned Size() const noexcept
+                    {
+                        std::size_t dequeued = _dequeuePosition.load(std::memory_order_acquire);
+                        std::size_t enqueued = _enqueuePosition.load(std::memory_order_acquire);
+
+                        return enqueued > dequeued ? static_cast<unsigned>(enqueued - dequeued) : 0;
+                    }
+
+                    /// <summary>
+                    /// Gets maximum number of elements.
+                    /// </summary>
+                    /// <returns>Capacity of queue.</returns>
+                    unsigned Capacity() const noexcept
+                    {
+                        return static_cast<unsigned>(_mask + 1);
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="capacity">Maximum number of elements, rounded up to a power of two.</param>
+                    explicit BoundedQueue(unsigned capacity)
+                        : _memory(nullptr)
+                        , _cells(nullptr)
+                        , _mask(0)
+                        , _enqueuePosition(0)
+                        , _dequeuePosition(0)
+                    {
+                        if (capacity == 0 || capacity > (1u << 31))
+                        {
+                            throw std::exception("Capacity of bounded queue must be between 1 and 2^31.");
+                        }
+
+                        // A single cell cannot tell full from free, a ring has at least two cells.
+                        std::size_t size = 2;
+                        while (size < capacity)
+                        {
+                            size <<= 1;
+                        }
+
+                        _memory = ::operator new(size * sizeof(Cell) + alignof(Cell));
+                        _cells = reinterpret_cast<Cell *>((reinterpret_cast<std::uintptr_t>(_memory) + alignof(Cell) - 1) & ~static_cast<std::uintptr_t>(alignof(Cell) - 1));
+                        _mask = size - 1;
+
+                        for (std::size_t i = 0; i < size; ++i)
+                        {
+                            new (&_cells[i]) Cell(i);
+                        }
+                    }
+
+                    /// <summary>
+                    /// Cells are shared by concurrent threads, queue can't be copied.
+                    /// </summary>
+                    BoundedQueue(const BoundedQueue<T> & other) = delete;
+
+                    /// <summary>
+                    /// Cells are shared by concurrent threads, queue can't be copied.
+                    /// </summary>
+                    BoundedQueue<T> & operator=(const BoundedQueue<T> & other) = delete;
+
+                    /// <summary>
+                    /// Destructs instance of this class.
+                    /// </summary>
+                    virtual ~BoundedQueue()
+                    {
+                        std::size_t end = _enqueuePosition.load(std::memory_order_relaxed);
+
+                        for (std::size_t position = _dequeuePosition.load(std::memory_order_relaxed); position != end; ++position)
+                        {
+                            _cells[position & _mask].Item()->~T();
+                        }
+
+                        for (std::size_t i = 0; i <= _mask; ++i)
+                        {
+                            _cells[i].~Cell();
+                        }
+
+                        ::operator delete(_memory);
+                    }
+
+                private:
+                    /// <summary>
+                    /// Slot of the ring, occupies whole cache lines so neighbouring slots are not falsely shared.
+                    /// </summary>
+                    struct alignas(Memory::CacheLineSize) Cell
+                    {
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="sequence">Position of the first enqueue that may use the cell.</param>
+                        explicit Cell(std::size_t sequence)
+                            : Sequence(sequence)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Gets stored item.
+                        /// </summary>
+                        /// <returns>Pointer to the item.</returns>
+                        T * Item() noexcept
+                        {
+                            return reinterpret_cast<T *>(&Storage);
+                        }
+
+                        /// <summary>
+                        /// Equal to enqueue position when the cell is free and to that position + 1 when it holds an item.
+                        /// </summary>
+                        std::atomic<std::size_t> Sequence;
+
+                        /// <summary>
+                        /// Storage of the item.
+                        /// </summary>
+                        typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+                    };
+
+                    /// <summary>
+                    /// Claims a free cell and constructs the item in it. The constructor cannot throw, so a claimed cell is always filled.
+                    /// </summary>
+                    template<typename... TArgs>
+                    bool Emplace(std::true_type, TArgs &&... args)
+                    {
+                        std::size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+                        Cell * cell;
+
+                        for (;;)
+                        {
+                            cell = &_cells[position & _mask];
+                            std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+                            std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+                            if (difference == 0)
+                            {
+                                if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                                {
+                                    break;
+                                }
+                            }
+                            else if (difference < 0)
+                            {
+                                return false;
+                            }
+                            else
+                            {
+                                position = _enqueuePosition.load(std::memory_order_relaxed);
+                            }
+                        }
+
+                        new (&cell->Storage) T(std::forward<TArgs>(args)...);
+
+                        cell->Sequence.store(position + 1, std::memory_order_release);
+
+                        return true;
+                    }
+
+                    /// <summary>
+                    /// Constructs the item before claiming a cell, so an exception leaves the queue untouched.
+                    /// Only the nothrow move into the cell happens after the claim.
+                    /// </summary>
+                    template<typename... TArgs>
+                    bool Emplace(std::false_type, TArgs &&... args)
+                    {
+                        T item(std::forward<TArgs>(args)...);
+
+                        return Emplace(std::true_type(), std::move(item));
+                    }
+
+                    /// <summary>
+                    /// Memory of the ring.
+                    /// </summary>
+                    void * _memory;
+
+                    /// <summary>
+                    /// Cells of the ring, aligned to cache line.
+                    /// </summary>
+                    Cell * _cells;
+
+                    /// <summary>
+                    /// Capacity - 1, maps positions to cells.
+                    /// </summary>
+                    std::size_t _mask;
+
+                    /// <summary>
+                    /// Keeps positions away from the read-only members and from each other.
+                    /// </summary>
+                    char _padding0[Memory::CacheLineSize];
+
+                    /// <summary>
+                    /// Position of the next enqueue.
+                    /// </summary>
+                    std::atomic<std::size_t> _enqueuePosition;
+
+                    /// <summary>
+                    /// Keeps positions on separate cache lines.
+                    /// </summary>
+                    char _padding1[Memory::CacheLineSize];
+
+                    /// <summary>
+                    /// Position of the next dequeue.
+                    /// </summary>
+                    std::atomic<std::size_t> _dequeuePosition;
+
+                    /// <summary>
+                    /// Keeps dequeue position away from whatever follows the queue.
+                    /// </summary>
+                    char _padding2[Memory::CacheLineSize];
+                };
+            }
+        }
+    }
+}
+
+#endif
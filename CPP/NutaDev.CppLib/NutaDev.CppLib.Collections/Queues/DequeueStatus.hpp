@@ -0,0 +1,61 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_DEQUEUESTATUS_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_DEQUEUESTATUS_HPP
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                /// <summary>
+                /// Result of blocking and polling dequeue.
+                /// </summary>
+                enum DequeueStatus
+                {
+                    /// <summary>
+                    /// Item has been dequeued.
+                    /// </summary>
+                    Dequeued = 0,
+                    /// <summary>
+                    /// Queue is empty.
+                    /// </summary>
+                    Empty = 1,
+                    /// <summary>
+                    /// Queue stayed empty until the timeout.
+                    /// </summary>
+                    Timeout = 2,
+                    /// <summary>
+                    /// Queue has been closed and all items have been dequeued.
+                    /// </summary>
+                    Closed = 3
+                };
+            }
+        }
+    }
+}
+
+#endif
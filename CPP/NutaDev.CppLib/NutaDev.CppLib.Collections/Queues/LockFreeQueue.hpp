@@ -0,0 +1,314 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_LOCKFREEQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_LOCKFREEQUEUE_HPP
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../Memory/EpochReclamation.hpp"
+#include "../Memory/NodePool.hpp"
+#include "../Memory/CacheLine.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                /// <summary>
+                /// Unbounded lock-free multi-producer multi-consumer queue (M. Michael and M. Scott's algorithm).
+                /// Dequeued nodes are reclaimed with Memory::EpochReclamation and recycled through Memory::NodePool,
+                /// so in steady state neither enqueue nor dequeue allocates. Use instead of Queue when producers
+                /// can't be bounded by BoundedQueue's capacity.
+                /// </summary>
+                template<typename T>
+                class LockFreeQueue
+                {
+                public:
+                    /// <summary>
+                    /// Tries to enqueue element.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True, queue is never full.</returns>
+                    bool TryEnqueue(T && item)
+                    {
+                        return TryEmplace(std::move(item));
+                    }
+
+                    /// <summary>
+                    /// Tries to enqueue element.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True, queue is never full.</returns>
+                    bool TryEnqueue(T & item)
+                    {
+                        return TryEmplace(item);
+                    }
+
+                    /// <summary>
+                    /// Tries to enqueue element.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True, queue is never full.</returns>
+                    bool TryEnqueue(const T & item)
+                    {
+                        return TryEmplace(item);
+                    }
+
+                    /// <summary>
+                    /// Tries to construct element in place at the end of queue.
+                    /// </summary>
+                    /// <param name="args">Arguments of the element constructor.</param>
+                    /// <returns>True, queue is never full.</returns>
+                    template<typename... TArgs>
+                    bool TryEmplace(TArgs &&... args)
+                    {
+                        Node * node = CreateNode();
+
+                        try
+                        {
+                            new (&node->Storage) T(std::forward<TArgs>(args)...);
+                        }
+                        catch (...)
+                        {
+                            DestroyNode(node);
+                            throw;
+                        }
+
+                        Memory::EpochReclamation::Guard guard;
+
+                        for (;;)
+                        {
+                            Node * tail = _tail.load(std::memory_order_acquire);
+                            Node * next = tail->Next.load(std::memory_order_acquire);
+
+                            if (tail != _tail.load(std::memory_order_acquire))
+                            {
+                                continue;
+                            }
+
+                            if (next != nullptr)
+                            {
+                                // Tail lags behind, help the enqueue that has linked the next node.
+                                _tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                                continue;
+                            }
+
+                            if (tail->Next.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed))
+                            {
+                                _tail.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+                                return true;
+                            }
+                        }
+                    }
+
+                    /// <summary>
+                    /// Tries to dequeue element from queue.
+                    /// </summary>
+                    /// <param name="item">Item to dequeue.</param>
+                    /// <returns>True if item has been dequeued, false if queue is empty.</returns>
+                    bool TryDequeue(T & item)
+                    {
+                        Memory::EpochReclamation::Guard guard;
+
+                        for (;;)
+                        {
+                            Node * head = _head.load(std::memory_order_acquire);
+                            Node * tail = _tail.load(std::memory_order_acquire);
+                            Node * next = head->Next.load(std::memory_order_acquire);
+
+                            if (head != _head.load(std::memory_order_acquire))
+                            {
+                                continue;
+                            }
+
+                            if (next == nullptr)
+                            {
+                                return false;
+                            }
+
+                            if (head == tail)
+                            {
+                                _tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                                continue;
+                            }
+
+                            if (_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_relaxed))
+                            {
+                                // Next is the new dummy node, its item belongs to the thread that moved the head.
+                                T * stored = next->Item();
+                                item = std::move(*stored);
+                                stored->~T();
+
+                                Memory::EpochReclamation::Retire(head, &ReclaimNode);
+                                return true;
+                            }
+                        }
+                    }
+
+                    /// <summary>
+                    /// Indicates whether queue is empty. The value is a snapshot and may be stale when other threads use the queue.
+                    /// </summary>
+                    /// <returns>True if queue is empty.</returns>
+                    bool IsEmpty() const
+                    {
+                        Memory::EpochReclamation::Guard guard;
+
+                        return _head.load(std::memory_order_acquire)->Next.load(std::memory_order_acquire) == nullptr;
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    LockFreeQueue()
+                    {
+                        Node * dummy = CreateNode();
+
+                        _head.store(dummy, std::memory_order_relaxed);
+                        _tail.store(dummy, std::memory_order_relaxed);
+                    }
+
+                    /// <summary>
+                    /// Nodes are shared by concurrent threads, queue can't be copied.
+                    /// </summary>
+                    LockFreeQueue(const LockFreeQueue<T> & other) = delete;
+
+                    /// <summary>
+                    /// Nodes are shared by concurrent threads, queue can't be copied.
+                    /// </summary>
+                    LockFreeQueue<T> & operator=(const LockFreeQueue<T> & other) = delete;
+
+                    /// <summary>
+                    /// Destructs instance of this class. No other thread may use the queue.
+                    /// </summary>
+                    virtual ~LockFreeQueue()
+                    {
+                        Node * node = _head.load(std::memory_order_relaxed);
+                        Node * next = node->Next.load(std::memory_order_relaxed);
+
+                        DestroyNode(node);
+
+                        for (node = next; node != nullptr; node = next)
+                        {
+                            next = node->Next.load(std::memory_order_relaxed);
+
+                            node->Item()->~T();
+                            DestroyNode(node);
+                        }
+                    }
+
+                private:
+                    /// <summary>
+                    /// Node of the list. The first node is a dummy whose item has been dequeued or never existed.
+                    /// </summary>
+                    struct Node
+                    {
+                        Node()
+                            : Next(nullptr)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Gets stored item.
+                        /// </summary>
+                        /// <returns>Pointer to the item.</returns>
+                        T * Item() noexcept
+                        {
+                            return reinterpret_cast<T *>(&Storage);
+                        }
+
+                        /// <summary>
+                        /// Next node.
+                        /// </summary>
+                        std::atomic<Node *> Next;
+
+                        /// <summary>
+                        /// Storage of the item.
+                        /// </summary>
+                        typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+                    };
+
+                    /// <summary>
+                    /// Pool of node memory.
+                    /// </summary>
+                    typedef Memory::NodePool<sizeof(Node), alignof(Node)> Pool;
+
+                    /// <summary>
+                    /// Creates node without item.
+                    /// </summary>
+                    /// <returns>The node.</returns>
+                    static Node * CreateNode()
+                    {
+                        return new (Pool::Allocate()) Node();
+                    }
+
+                    /// <summary>
+                    /// Destroys node without item.
+                    /// </summary>
+                    /// <param name="node">The node.</param>
+                    static void DestroyNode(Node * node) noexcept
+                    {
+                        node->~Node();
+                        Pool::Deallocate(node);
+                    }
+
+                    /// <summary>
+                    /// Destroys retired dummy node.
+                    /// </summary>
+                    /// <param name="node">The node.</param>
+                    static void ReclaimNode(void * node)
+                    {
+                        DestroyNode(static_cast<Node *>(node));
+                    }
+
+                    /// <summary>
+                    /// Dummy node, dequeue reads its successor.
+                    /// </summary>
+                    std::atomic<Node *> _head;
+
+                    /// <summary>
+                    /// Keeps head and tail on separate cache lines.
+                    /// </summary>
+                    char _padding0[Memory::CacheLineSize];
+
+                    /// <summary>
+                    /// The last or the second to last node.
+                    /// </summary>
+                    std::atomic<Node *> _tail;
+
+                    /// <summary>
+                    /// Keeps tail away from whatever follows the queue.
+                    /// </summary>
+                    char _padding1[Memory::CacheLineSize];
+                };
+            }
+        }
+    }
+}
+
+#endif
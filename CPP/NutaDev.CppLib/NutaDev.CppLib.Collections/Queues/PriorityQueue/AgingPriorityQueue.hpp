@@ -0,0 +1,424 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_AGINGPRIORITYQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_AGINGPRIORITYQUEUE_HPP
+
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../../Heaps/Storage/SlabNodeStorage.hpp"
+#include "SchedulingStatistics.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    /// <summary>
+                    /// Priority queue with aging. Effective priority of an item is its priority decreased by one for every
+                    /// aging interval it has waited, so low priority items can't starve. Effective priority is never stored:
+                    /// priority - waited / interval orders items the same way as enqueue time + priority * interval, which doesn't
+                    /// change while the items wait. Every priority has its own FIFO whose head is its oldest item, so dequeue
+                    /// compares only heads of the non-empty priorities and nothing has to be re-heapified. Dequeue is O(priorities).
+                    /// </summary>
+                    template<typename T, typename TClock = std::chrono::steady_clock>
+                    class AgingPriorityQueue
+                    {
+                    public:
+                        /// <summary>
+                        /// Point in time of the queue clock.
+                        /// </summary>
+                        typedef typename TClock::time_point TimePoint;
+
+                        /// <summary>
+                        /// Duration of the queue clock.
+                        /// </summary>
+                        typedef typename TClock::duration Duration;
+
+                        /// <summary>
+                        /// Tries to enqueue element to queue.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority, lower is more important.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(const T & value, unsigned priority)
+                        {
+                            return TryEnqueue(T(value), priority, TClock::now());
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element to queue.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority, lower is more important.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T && value, unsigned priority)
+                        {
+                            return TryEnqueue(std::move(value), priority, TClock::now());
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element to queue.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority, lower is more important.</param>
+                        /// <param name="now">Current time, must not be earlier than the time of the previous enqueue.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T && value, unsigned priority, TimePoint now)
+                        {
+                            if (priority >= _buckets.size())
+                            {
+                                throw std::exception("Priority is out of range.");
+                            }
+
+                            if (_synch.try_lock())
+                            {
+                                BucketNode * node = _nodes.Create(std::move(value), now);
+                                Bucket & bucket = _buckets[priority];
+
+                                if (bucket.Tail == nullptr)
+                                {
+                                    bucket.Head = node;
+                                }
+                                else
+                                {
+                                    bucket.Tail->Next = node;
+                                }
+
+                                bucket.Tail = node;
+
+                                _size++;
+
+                                _synch.unlock();
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element from queue.
+                        /// </summary>
+                        /// <param name="value">Item to dequeue.</param>
+                        /// <returns>True if item has been dequeued.</returns>
+                        bool TryDequeue(T & value)
+                        {
+                            return TryDequeue(value, TClock::now());
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element from queue.
+                        /// </summary>
+                        /// <param name="value">Item to dequeue.</param>
+                        /// <param name="now">Current time, used for wait statistics.</param>
+                        /// <returns>True if item has been dequeued.</returns>
+                        bool TryDequeue(T & value, TimePoint now)
+                        {
+                            bool result = false;
+
+                            if (_synch.try_lock())
+                            {
+                                if (_size > 0)
+                                {
+                                    unsigned priority = FirstBucket();
+                                    Bucket & bucket = _buckets[priority];
+                                    BucketNode * node = bucket.Head;
+
+                                    bucket.Head = node->Next;
+
+                                    if (bucket.Head == nullptr)
+                                    {
+                                        bucket.Tail = nullptr;
+                                    }
+
+                                    _statistics[priority].Record(now - node->EnqueuedAt, false);
+
+                                    value = std::move(node->Item);
+                                    _nodes.Destroy(node);
+
+                                    _size--;
+                                    result = true;
+                                }
+
+                                _synch.unlock();
+                            }
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Clears the collection. Statistics are kept.
+                        /// </summary>
+                        void Clear()
+                        {
+                            _synch.lock();
+
+                            Release();
+
+                            _synch.unlock();
+                        }
+
+                        /// <summary>
+                        /// Gets size of queue.
+                        /// </summary>
+                        /// <returns>Size of queue.</returns>
+                        unsigned Size() const noexcept
+                        {
+                            return _size;
+                        }
+
+                        /// <summary>
+                        /// Peeks at top element of the queue.
+                        /// </summary>
+                        /// <returns>Top element of queue.</returns>
+                        const T & Peek() const
+                        {
+                            if (Size() > 0)
+                            {
+                                return _buckets[FirstBucket()].Head->Item;
+                            }
+
+                            throw std::exception("You can't peek empty queue.");
+                        }
+
+                        /// <summary>
+                        /// Gets statistics of the priority.
+                        /// </summary>
+                        /// <param name="priority">The priority.</param>
+                        /// <returns>Copy of the statistics.</returns>
+                        SchedulingStatistics<TClock> Statistics(unsigned priority)
+                        {
+                            if (priority >= _statistics.size())
+                            {
+                                throw std::exception("Priority is out of range.");
+                            }
+
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            return _statistics[priority];
+                        }
+
+                        /// <summary>
+                        /// Gets the aging interval.
+                        /// </summary>
+                        /// <returns>Time after which effective priority improves by one.</returns>
+                        Duration AgingInterval() const noexcept
+                        {
+                            return _agingInterval;
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="agingInterval">Time after which effective priority improves by one.</param>
+                        /// <param name="priorities">Number of priorities.</param>
+                        AgingPriorityQueue(Duration agingInterval, unsigned priorities)
+                            : _buckets(priorities)
+                            , _statistics(priorities)
+                            , _agingInterval(agingInterval)
+                            , _size(0)
+                        {
+                            if (priorities == 0)
+                            {
+                                throw std::exception("Queue needs at least one priority.");
+                            }
+
+                            if (agingInterval <= Duration::zero())
+                            {
+                                throw std::exception("Aging interval must be positive.");
+                            }
+                        }
+
+                        /// <summary>
+                        /// Queue owns its nodes and can't be copied.
+                        /// </summary>
+                        AgingPriorityQueue(const AgingPriorityQueue<T, TClock> & other) = delete;
+
+                        /// <summary>
+                        /// Queue owns its nodes and can't be copied.
+                        /// </summary>
+                        AgingPriorityQueue<T, TClock> & operator=(const AgingPriorityQueue<T, TClock> & other) = delete;
+
+                        /// <summary>
+                        /// Destructs an instance of this class.
+                        /// </summary>
+                        ~AgingPriorityQueue()
+                        {
+                            Release();
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Element of a bucket.
+                        /// </summary>
+                        struct BucketNode
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="item">The item.</param>
+                            /// <param name="enqueuedAt">Time of enqueue.</param>
+                            BucketNode(T && item, TimePoint enqueuedAt)
+                                : Item(std::move(item))
+                                , EnqueuedAt(enqueuedAt)
+                                , Next(nullptr)
+                            {
+                            }
+
+                            /// <summary>
+                            /// The item.
+                            /// </summary>
+                            T Item;
+
+                            /// <summary>
+                            /// Time of enqueue.
+                            /// </summary>
+                            TimePoint EnqueuedAt;
+
+                            /// <summary>
+                            /// Next node of the bucket.
+                            /// </summary>
+                            BucketNode * Next;
+                        };
+
+                        /// <summary>
+                        /// FIFO list of items of one priority.
+                        /// </summary>
+                        struct Bucket
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            Bucket()
+                                : Head(nullptr)
+                                , Tail(nullptr)
+                            {
+                            }
+
+                            /// <summary>
+                            /// The oldest node.
+                            /// </summary>
+                            BucketNode * Head;
+
+                            /// <summary>
+                            /// The newest node.
+                            /// </summary>
+                            BucketNode * Tail;
+                        };
+
+                        /// <summary>
+                        /// FIFO bucket for every priority.
+                        /// </summary>
+                        std::vector<Bucket> _buckets;
+
+                        /// <summary>
+                        /// Statistics of every priority.
+                        /// </summary>
+                        std::vector<SchedulingStatistics<TClock>> _statistics;
+
+                        /// <summary>
+                        /// Owner of the nodes of all buckets.
+                        /// </summary>
+                        Heaps::Storage::SlabNodeStorage<BucketNode> _nodes;
+
+                        /// <summary>
+                        /// Time after which effective priority improves by one.
+                        /// </summary>
+                        Duration _agingInterval;
+
+                        /// <summary>
+                        /// Synchronization context.
+                        /// </summary>
+                        std::mutex _synch;
+
+                        /// <summary>
+                        /// Size of queue.
+                        /// </summary>
+                        unsigned _size;
+
+                        /// <summary>
+                        /// Gets index of the bucket whose head has the best effective priority. Queue can't be empty.
+                        /// Ties go to the lower priority.
+                        /// </summary>
+                        /// <returns>Index of the bucket.</returns>
+                        unsigned FirstBucket() const
+                        {
+                            unsigned best = static_cast<unsigned>(_buckets.size());
+                            TimePoint bestKey;
+
+                            for (unsigned i = 0; i < _buckets.size(); ++i)
+                            {
+                                const BucketNode * head = _buckets[i].Head;
+
+                                if (head != nullptr)
+                                {
+                                    TimePoint key = head->EnqueuedAt + _agingInterval * i;
+
+                                    if (best == _buckets.size() || key < bestKey)
+                                    {
+                                        best = i;
+                                        bestKey = key;
+                                    }
+                                }
+                            }
+
+                            return best;
+                        }
+
+                        /// <summary>
+                        /// Destroys all nodes and marks all buckets as empty.
+                        /// </summary>
+                        void Release()
+                        {
+                            for (Bucket & bucket : _buckets)
+                            {
+                                BucketNode * node = bucket.Head;
+
+                                while (node != nullptr)
+                                {
+                                    BucketNode * next = node->Next;
+                                    _nodes.Destroy(node);
+                                    node = next;
+                                }
+
+                                bucket = Bucket();
+                            }
+
+                            _size = 0;
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
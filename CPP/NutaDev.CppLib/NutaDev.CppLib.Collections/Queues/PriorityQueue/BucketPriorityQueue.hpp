@@ -0,0 +1,394 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_BUCKETPRIORITYQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_BUCKETPRIORITYQUEUE_HPP
+
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+#include "../../../NutaDev.CppLib.Binary/BitOperations.hpp"
+#include "../../Heaps/Storage/SlabNodeStorage.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    /// <summary>
+                    /// Priority queue for priorities from the small range [0, TPriorities).
+                    /// Every priority has its own FIFO bucket and non-empty buckets are tracked in a two level bitmap,
+                    /// so both enqueue and dequeue are O(1). Items of equal priority are dequeued in FIFO order.
+                    /// </summary>
+                    template<typename T, unsigned TPriorities = 256>
+                    class BucketPriorityQueue
+                    {
+                        static_assert(TPriorities > 0 && TPriorities <= 4096, "Bucket queue supports from 1 to 4096 priorities.");
+
+                    public:
+                        /// <summary>
+                        /// Tries to enqueue element from queue.
+                        /// </summary>
+                        /// <param name="item">Item to enqueue.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T && value, unsigned priority)
+                        {
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                Enqueue(std::move(value), priority);
+
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element from queue.
+                        /// </summary>
+                        /// <param name="item">Item to enqueue.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T & value, unsigned priority)
+                        {
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                Enqueue(value, priority);
+
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element from queue.
+                        /// </summary>
+                        /// <param name="item">Item to enqueue.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(const T & value, unsigned priority)
+                        {
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                Enqueue(value, priority);
+
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element from queue.
+                        /// </summary>
+                        /// <param name="item">Item to dequeue.</param>
+                        /// <returns>True if item has been dequeued.</returns>
+                        bool TryDequeue(T & value)
+                        {
+                            bool result = false;
+
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                if (_size > 0)
+                                {
+                                    unsigned priority = FirstBucket();
+                                    Bucket & bucket = _buckets[priority];
+                                    BucketNode * node = bucket.Head;
+
+                                    bucket.Head = node->Next;
+
+                                    if (bucket.Head == nullptr)
+                                    {
+                                        bucket.Tail = nullptr;
+                                        MarkEmpty(priority);
+                                    }
+
+                                    value = std::move(node->Item);
+                                    _nodes.Destroy(node);
+
+                                    _size--;
+                                    result = true;
+                                }
+                            }
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Clears the collection.
+                        /// </summary>
+                        void Clear()
+                        {
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            Release();
+                        }
+
+                        /// <summary>
+                        /// Gets size of queue.
+                        /// </summary>
+                        /// <returns>Size of queue.</returns>
+                        unsigned Size() const noexcept
+                        {
+                            return _size;
+                        }
+
+                        /// <summary>
+                        /// Peeks at top element of the queue.
+                        /// </summary>
+                        /// <returns>Top element of queue.</returns>
+                        const T & Peek() const
+                        {
+                            if (Size() > 0)
+                            {
+                                return _buckets[FirstBucket()].Head->Item;
+                            }
+
+                            throw std::exception("You can't peek empty queue.");
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        BucketPriorityQueue()
+                            : _summary(0)
+                            , _size(0)
+                        {
+                            for (unsigned i = 0; i < WordCount; ++i)
+                            {
+                                _words[i] = 0;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Queue owns its nodes and can't be copied.
+                        /// </summary>
+                        BucketPriorityQueue(const BucketPriorityQueue<T, TPriorities> & other) = delete;
+
+                        /// <summary>
+                        /// Queue owns its nodes and can't be copied.
+                        /// </summary>
+                        BucketPriorityQueue<T, TPriorities> & operator=(const BucketPriorityQueue<T, TPriorities> & other) = delete;
+
+                        /// <summary>
+                        /// Destructs an instance of this class.
+                        /// </summary>
+                        ~BucketPriorityQueue()
+                        {
+                            Release();
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Element of a bucket.
+                        /// </summary>
+                        struct BucketNode
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="item">The item.</param>
+                            template<typename TValue>
+                            explicit BucketNode(TValue && item)
+                                : Item(std::forward<TValue>(item))
+                                , Next(nullptr)
+                            {
+                            }
+
+                            /// <summary>
+                            /// The item.
+                            /// </summary>
+                            T Item;
+
+                            /// <summary>
+                            /// Next node of the bucket.
+                            /// </summary>
+                            BucketNode * Next;
+                        };
+
+                        /// <summary>
+                        /// FIFO list of items of one priority.
+                        /// </summary>
+                        struct Bucket
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            Bucket()
+                                : Head(nullptr)
+                                , Tail(nullptr)
+                            {
+                            }
+
+                            /// <summary>
+                            /// The oldest node.
+                            /// </summary>
+                            BucketNode * Head;
+
+                            /// <summary>
+                            /// The newest node.
+                            /// </summary>
+                            BucketNode * Tail;
+                        };
+
+                        /// <summary>
+                        /// Number of bitmap words.
+                        /// </summary>
+                        static const unsigned WordCount = (TPriorities + 63) / 64;
+
+                        /// <summary>
+                        /// FIFO bucket for every priority.
+                        /// </summary>
+                        Bucket _buckets[TPriorities];
+
+                        /// <summary>
+                        /// Owner of the nodes of all buckets.
+                        /// </summary>
+                        Heaps::Storage::SlabNodeStorage<BucketNode> _nodes;
+
+                        /// <summary>
+                        /// Bit for every non-empty bucket.
+                        /// </summary>
+                        std::uint64_t _words[WordCount];
+
+                        /// <summary>
+                        /// Bit for every non-zero word.
+                        /// </summary>
+                        std::uint64_t _summary;
+
+                        /// <summary>
+                        /// Synchronization context.
+                        /// </summary>
+                        std::mutex _synch;
+
+                        /// <summary>
+                        /// Size of queue.
+                        /// </summary>
+                        unsigned _size;
+
+                        /// <summary>
+                        /// Enqueue new element.
+                        /// </summary>
+                        /// <param name="value">The value.</param>
+                        /// <param name="priority">Element priority.</param>
+                        template<typename TValue>
+                        void Enqueue(TValue && value, unsigned priority)
+                        {
+                            if (priority >= TPriorities)
+                            {
+                                throw std::exception("Priority is out of range.");
+                            }
+
+                            BucketNode * node = _nodes.Create(std::forward<TValue>(value));
+                            Bucket & bucket = _buckets[priority];
+
+                            if (bucket.Tail == nullptr)
+                            {
+                                bucket.Head = node;
+                            }
+                            else
+                            {
+                                bucket.Tail->Next = node;
+                            }
+
+                            bucket.Tail = node;
+
+                            _words[priority / 64] |= std::uint64_t(1) << (priority % 64);
+                            _summary |= std::uint64_t(1) << (priority / 64);
+
+                            _size++;
+                        }
+
+                        /// <summary>
+                        /// Gets index of the first non-empty bucket. Queue can't be empty.
+                        /// </summary>
+                        /// <returns>Index of the bucket.</returns>
+                        unsigned FirstBucket() const
+                        {
+                            unsigned word = static_cast<unsigned>(Binary::lowestSetBit(_summary));
+
+                            return word * 64 + static_cast<unsigned>(Binary::lowestSetBit(_words[word]));
+                        }
+
+                        /// <summary>
+                        /// Destroys all nodes and marks all buckets as empty.
+                        /// </summary>
+                        void Release()
+                        {
+                            for (unsigned i = 0; i < TPriorities; ++i)
+                            {
+                                BucketNode * node = _buckets[i].Head;
+
+                                while (node != nullptr)
+                                {
+                                    BucketNode * next = node->Next;
+                                    _nodes.Destroy(node);
+                                    node = next;
+                                }
+
+                                _buckets[i] = Bucket();
+                            }
+
+                            for (unsigned i = 0; i < WordCount; ++i)
+                            {
+                                _words[i] = 0;
+                            }
+
+                            _summary = 0;
+                            _size = 0;
+                        }
+
+                        /// <summary>
+                        /// Marks the bucket as empty.
+                        /// </summary>
+                        /// <param name="priority">Index of the bucket.</param>
+                        void MarkEmpty(unsigned priority)
+                        {
+                            _words[priority / 64] &= ~(std::uint64_t(1) << (priority % 64));
+
+                            if (_words[priority / 64] == 0)
+                            {
+                                _summary &= ~(std::uint64_t(1) << (priority / 64));
+                            }
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
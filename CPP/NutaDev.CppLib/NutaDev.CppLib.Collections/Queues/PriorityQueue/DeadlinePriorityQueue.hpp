@@ -0,0 +1,340 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_DEADLINEPRIORITYQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_DEADLINEPRIORITYQUEUE_HPP
+
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../../Heaps/HeapEngines.hpp"
+#include "SchedulingStatistics.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    /// <summary>
+                    /// Earliest deadline first queue. Items are keyed by their absolute deadline, so the key never changes
+                    /// while the item waits and no re-heapify is needed. Items of equal deadline are dequeued in FIFO order.
+                    /// Every item belongs to a class in [0, classes) for which deadline misses and maximum wait are counted.
+                    /// </summary>
+                    template<typename T, typename TClock = std::chrono::steady_clock, typename TEngine = Heaps::QuaternaryHeapEngine>
+                    class DeadlinePriorityQueue
+                    {
+                    public:
+                        /// <summary>
+                        /// Point in time of the queue clock.
+                        /// </summary>
+                        typedef typename TClock::time_point TimePoint;
+
+                        /// <summary>
+                        /// Tries to enqueue element to queue.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="deadline">Point in time the item should be dequeued by.</param>
+                        /// <param name="itemClass">Class of the item.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(const T & value, TimePoint deadline, unsigned itemClass = 0)
+                        {
+                            return TryEnqueue(T(value), deadline, itemClass, TClock::now());
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element to queue.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="deadline">Point in time the item should be dequeued by.</param>
+                        /// <param name="itemClass">Class of the item.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T && value, TimePoint deadline, unsigned itemClass = 0)
+                        {
+                            return TryEnqueue(std::move(value), deadline, itemClass, TClock::now());
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element to queue.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="deadline">Point in time the item should be dequeued by.</param>
+                        /// <param name="itemClass">Class of the item.</param>
+                        /// <param name="now">Current time.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T && value, TimePoint deadline, unsigned itemClass, TimePoint now)
+                        {
+                            if (itemClass >= _statistics.size())
+                            {
+                                throw std::exception("Class is out of range.");
+                            }
+
+                            if (_synch.try_lock())
+                            {
+                                _heap.Push(Entry(std::move(value), deadline, now, itemClass, _sequence++));
+
+                                _synch.unlock();
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element from queue.
+                        /// </summary>
+                        /// <param name="value">Item to dequeue.</param>
+                        /// <returns>True if item has been dequeued.</returns>
+                        bool TryDequeue(T & value)
+                        {
+                            return TryDequeue(value, TClock::now());
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element from queue.
+                        /// </summary>
+                        /// <param name="value">Item to dequeue.</param>
+                        /// <param name="now">Current time, items dequeued after their deadline are counted as misses.</param>
+                        /// <returns>True if item has been dequeued.</returns>
+                        bool TryDequeue(T & value, TimePoint now)
+                        {
+                            bool result = false;
+
+                            if (_synch.try_lock())
+                            {
+                                if (_heap.Size() > 0)
+                                {
+                                    Entry entry = _heap.EraseMinimum();
+
+                                    _statistics[entry.Class].Record(now - entry.EnqueuedAt, now > entry.Deadline);
+
+                                    value = std::move(entry.Item);
+                                    result = true;
+                                }
+
+                                _synch.unlock();
+                            }
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Clears the collection. Statistics are kept.
+                        /// </summary>
+                        void Clear()
+                        {
+                            _synch.lock();
+
+                            _heap.Clear();
+
+                            _synch.unlock();
+                        }
+
+                        /// <summary>
+                        /// Gets size of queue.
+                        /// </summary>
+                        /// <returns>Size of queue.</returns>
+                        unsigned Size() const noexcept
+                        {
+                            return static_cast<unsigned>(_heap.Size());
+                        }
+
+                        /// <summary>
+                        /// Peeks at top element of the queue.
+                        /// </summary>
+                        /// <returns>Top element of queue.</returns>
+                        const T & Peek() const
+                        {
+                            if (Size() > 0)
+                            {
+                                return _heap.Top().Item;
+                            }
+
+                            throw std::exception("You can't peek empty queue.");
+                        }
+
+                        /// <summary>
+                        /// Gets deadline of the top element of the queue.
+                        /// </summary>
+                        /// <returns>Deadline of the top element.</returns>
+                        TimePoint NextDeadline() const
+                        {
+                            if (Size() > 0)
+                            {
+                                return _heap.Top().Deadline;
+                            }
+
+                            throw std::exception("You can't peek empty queue.");
+                        }
+
+                        /// <summary>
+                        /// Gets statistics of the class.
+                        /// </summary>
+                        /// <param name="itemClass">The class.</param>
+                        /// <returns>Copy of the statistics.</returns>
+                        SchedulingStatistics<TClock> Statistics(unsigned itemClass)
+                        {
+                            if (itemClass >= _statistics.size())
+                            {
+                                throw std::exception("Class is out of range.");
+                            }
+
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            return _statistics[itemClass];
+                        }
+
+                        /// <summary>
+                        /// Gets number of classes.
+                        /// </summary>
+                        /// <returns>Number of classes.</returns>
+                        unsigned ClassCount() const noexcept
+                        {
+                            return static_cast<unsigned>(_statistics.size());
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="classes">Number of item classes.</param>
+                        explicit DeadlinePriorityQueue(unsigned classes = 1)
+                            : _statistics(classes)
+                            , _sequence(0)
+                        {
+                            if (classes == 0)
+                            {
+                                throw std::exception("Queue needs at least one class.");
+                            }
+                        }
+
+                        /// <summary>
+                        /// Queue owns its synchronization context and can't be copied.
+                        /// </summary>
+                        DeadlinePriorityQueue(const DeadlinePriorityQueue<T, TClock, TEngine> & other) = delete;
+
+                        /// <summary>
+                        /// Queue owns its synchronization context and can't be copied.
+                        /// </summary>
+                        DeadlinePriorityQueue<T, TClock, TEngine> & operator=(const DeadlinePriorityQueue<T, TClock, TEngine> & other) = delete;
+
+                    private:
+                        /// <summary>
+                        /// Element of the queue.
+                        /// </summary>
+                        struct Entry
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            Entry()
+                                : Class(0)
+                                , Sequence(0)
+                            {
+                            }
+
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="item">The item.</param>
+                            /// <param name="deadline">The deadline.</param>
+                            /// <param name="enqueuedAt">Time of enqueue.</param>
+                            /// <param name="itemClass">Class of the item.</param>
+                            /// <param name="sequence">Enqueue order.</param>
+                            Entry(T && item, TimePoint deadline, TimePoint enqueuedAt, unsigned itemClass, unsigned long long sequence)
+                                : Item(std::move(item))
+                                , Deadline(deadline)
+                                , EnqueuedAt(enqueuedAt)
+                                , Class(itemClass)
+                                , Sequence(sequence)
+                            {
+                            }
+
+                            /// <summary>
+                            /// Compares element to this instance.
+                            /// </summary>
+                            /// <param name="right">Another element.</param>
+                            /// <returns>True if element is due before another.</returns>
+                            bool operator < (const Entry & right) const
+                            {
+                                return Deadline < right.Deadline || (Deadline == right.Deadline && Sequence < right.Sequence);
+                            }
+
+                            /// <summary>
+                            /// The item.
+                            /// </summary>
+                            T Item;
+
+                            /// <summary>
+                            /// The deadline.
+                            /// </summary>
+                            TimePoint Deadline;
+
+                            /// <summary>
+                            /// Time of enqueue.
+                            /// </summary>
+                            TimePoint EnqueuedAt;
+
+                            /// <summary>
+                            /// Class of the item.
+                            /// </summary>
+                            unsigned Class;
+
+                            /// <summary>
+                            /// Enqueue order, breaks ties between equal deadlines.
+                            /// </summary>
+                            unsigned long long Sequence;
+                        };
+
+                        /// <summary>
+                        /// Heap of entries ordered by deadline.
+                        /// </summary>
+                        typename TEngine::template Heap<Entry> _heap;
+
+                        /// <summary>
+                        /// Statistics of every class.
+                        /// </summary>
+                        std::vector<SchedulingStatistics<TClock>> _statistics;
+
+                        /// <summary>
+                        /// Synchronization context.
+                        /// </summary>
+                        std::mutex _synch;
+
+                        /// <summary>
+                        /// Number of enqueued items so far.
+                        /// </summary>
+                        unsigned long long _sequence;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,257 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_EXTERNAL_MAPPEDFILE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_EXTERNAL_MAPPEDFILE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    namespace External
+                    {
+                        /// <summary>
+                        /// Read only memory mapping of a whole file.
+                        /// </summary>
+                        class MappedFile
+                        {
+                        public:
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="path">Path of the file.</param>
+                            explicit MappedFile(const std::string & path)
+                                : _data(nullptr)
+                                , _size(0)
+#if defined(_WIN32)
+                                , _mapping(nullptr)
+#endif
+                            {
+#if defined(_WIN32)
+                                HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+                                if (file == INVALID_HANDLE_VALUE)
+                                {
+                                    throw std::exception("Can't open mapped file.");
+                                }
+
+                                LARGE_INTEGER size;
+
+                                if (!GetFileSizeEx(file, &size))
+                                {
+                                    CloseHandle(file);
+                                    throw std::exception("Can't get size of mapped file.");
+                                }
+
+                                _size = static_cast<std::size_t>(size.QuadPart);
+
+                                if (_size > 0)
+                                {
+                                    _mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+                                    if (_mapping != nullptr)
+                                    {
+                                        _data = static_cast<const char *>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+                                    }
+                                }
+
+                                CloseHandle(file);
+#else
+                                int file = open(path.c_str(), O_RDONLY);
+
+                                if (file < 0)
+                                {
+                                    throw std::exception("Can't open mapped file.");
+                                }
+
+                                struct stat status;
+
+                                if (fstat(file, &status) != 0)
+                                {
+                                    close(file);
+                                    throw std::exception("Can't get size of mapped file.");
+                                }
+
+                                _size = static_cast<std::size_t>(status.st_size);
+
+                                if (_size > 0)
+                                {
+                                    void * data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+
+                                    if (data != MAP_FAILED)
+                                    {
+                                        madvise(data, _size, MADV_SEQUENTIAL);
+                                        _data = static_cast<const char *>(data);
+                                    }
+                                }
+
+                                close(file);
+#endif
+
+                                if (_size > 0 && _data == nullptr)
+                                {
+                                    Close();
+                                    throw std::exception("Can't map file.");
+                                }
+                            }
+
+                            /// <summary>
+                            /// Mapping can't be copied.
+                            /// </summary>
+                            MappedFile(const MappedFile & other) = delete;
+
+                            /// <summary>
+                            /// Mapping can't be copied.
+                            /// </summary>
+                            MappedFile & operator=(const MappedFile & other) = delete;
+
+                            /// <summary>
+                            /// Destructs an instance of this class.
+                            /// </summary>
+                            ~MappedFile()
+                            {
+                                Close();
+                            }
+
+                            /// <summary>
+                            /// Gets the mapped content.
+                            /// </summary>
+                            /// <returns>Pointer to the first byte of the file.</returns>
+                            const char * Data() const noexcept
+                            {
+                                return _data;
+                            }
+
+                            /// <summary>
+                            /// Gets size of the file.
+                            /// </summary>
+                            /// <returns>Size in bytes.</returns>
+                            std::size_t Size() const noexcept
+                            {
+                                return _size;
+                            }
+
+                            /// <summary>
+                            /// Unmaps the file.
+                            /// </summary>
+                            void Close()
+                            {
+#if defined(_WIN32)
+                                if (_data != nullptr)
+                                {
+                                    UnmapViewOfFile(_data);
+                                }
+
+                                if (_mapping != nullptr)
+                                {
+                                    CloseHandle(_mapping);
+                                    _mapping = nullptr;
+                                }
+#else
+                                if (_data != nullptr)
+                                {
+                                    munmap(const_cast<char *>(_data), _size);
+                                }
+#endif
+
+                                _data = nullptr;
+                                _size = 0;
+                            }
+
+                            /// <summary>
+                            /// Creates path of a new temporary file that is unique among processes.
+                            /// </summary>
+                            /// <param name="directory">Directory of the file, current directory if empty.</param>
+                            /// <param name="extension">Extension of the file.</param>
+                            /// <returns>Path of the file.</returns>
+                            static std::string TemporaryPath(const std::string & directory, const std::string & extension)
+                            {
+                                static std::atomic<unsigned long long> serial(0);
+
+#if defined(_WIN32)
+                                unsigned long process = static_cast<unsigned long>(GetCurrentProcessId());
+#else
+                                unsigned long process = static_cast<unsigned long>(getpid());
+#endif
+
+                                std::string path = directory;
+
+                                if (!path.empty() && path.back() != '/' && path.back() != '\\')
+                                {
+                                    path += '/';
+                                }
+
+                                return path + "nutadev-" + std::to_string(process) + "-" + std::to_string(serial++) + extension;
+                            }
+
+                        private:
+                            /// <summary>
+                            /// The mapped content.
+                            /// </summary>
+                            const char * _data;
+
+                            /// <summary>
+                            /// Size of the file.
+                            /// </summary>
+                            std::size_t _size;
+
+#if defined(_WIN32)
+                            /// <summary>
+                            /// Handle of the mapping.
+                            /// </summary>
+                            HANDLE _mapping;
+#endif
+                        };
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
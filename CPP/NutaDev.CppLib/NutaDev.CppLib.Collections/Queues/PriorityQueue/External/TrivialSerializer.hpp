@@ -0,0 +1,92 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_EXTERNAL_TRIVIALSERIALIZER_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_EXTERNAL_TRIVIALSERIALIZER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <type_traits>
+#include <vector>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    namespace External
+                    {
+                        /// <summary>
+                        /// Serializer of trivially copyable types, writes the object representation.
+                        /// Serializer of other types has to provide the same two methods.
+                        /// </summary>
+                        template<typename T>
+                        class TrivialSerializer
+                        {
+                            static_assert(std::is_trivially_copyable<T>::value, "Trivial serializer requires trivially copyable type.");
+
+                        public:
+                            /// <summary>
+                            /// Appends bytes of the value to the output.
+                            /// </summary>
+                            /// <param name="value">The value.</param>
+                            /// <param name="output">The output.</param>
+                            void Serialize(const T & value, std::vector<char> & output) const
+                            {
+                                const char * bytes = reinterpret_cast<const char *>(&value);
+
+                                output.insert(output.end(), bytes, bytes + sizeof(T));
+                            }
+
+                            /// <summary>
+                            /// Reads the value from bytes written by Serialize.
+                            /// </summary>
+                            /// <param name="data">The bytes.</param>
+                            /// <param name="size">Number of bytes.</param>
+                            /// <returns>The value.</returns>
+                            T Deserialize(const char * data, std::size_t size) const
+                            {
+                                if (size != sizeof(T))
+                                {
+                                    throw std::exception("Serialized value has wrong size.");
+                                }
+
+                                T value;
+                                std::memcpy(&value, data, sizeof(T));
+
+                                return value;
+                            }
+                        };
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,798 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_EXTERNALPRIORITYQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_EXTERNALPRIORITYQUEUE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../Heaps/DaryHeap/DaryHeap.hpp"
+#include "External/MappedFile.hpp"
+#include "External/TrivialSerializer.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    /// <summary>
+                    /// Priority queue that holds more items than fit in memory. New items go to an in-memory insertion heap,
+                    /// full insertion heap is written as a sorted run to a spill file that is read back through a memory mapping.
+                    /// Runs are merged lazily on dequeue, every run keeps a small block of decoded items and a heap of
+                    /// run heads picks the smallest one. Runs are merged level by level: maxRuns runs of one level are merged
+                    /// into a single run of the next level, so every item is rewritten O(log n) times. A run is written
+                    /// completely before items are taken from the insertion heap or merged runs are removed.
+                    /// Items of equal priority are dequeued in FIFO order. TSerializer converts items to bytes and back,
+                    /// see External/TrivialSerializer.hpp.
+                    /// </summary>
+                    template<typename T, typename TSerializer = External::TrivialSerializer<T>>
+                    class ExternalPriorityQueue
+                    {
+                    public:
+                        /// <summary>
+                        /// Tries to enqueue element to queue.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(const T & value, unsigned priority)
+                        {
+                            return TryEnqueue(T(value), priority);
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element to queue.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T && value, unsigned priority)
+                        {
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                if (_insertion.Size() >= _insertionCapacity)
+                                {
+                                    Spill();
+                                }
+
+                                _insertion.Push(Entry(priority, _sequence++, std::move(value)));
+                                _size++;
+
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element from queue.
+                        /// </summary>
+                        /// <param name="value">Item to dequeue.</param>
+                        /// <returns>True if item has been dequeued.</returns>
+                        bool TryDequeue(T & value)
+                        {
+                            bool result = false;
+
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                if (_size > 0)
+                                {
+                                    if (_heads.empty() || (!_insertion.Empty() && _insertion.Top() < Head(_heads.front())))
+                                    {
+                                        value = std::move(_insertion.EraseMinimum().Item);
+                                    }
+                                    else
+                                    {
+                                        value = std::move(TakeFromRuns().Item);
+                                    }
+
+                                    _size--;
+                                    result = true;
+                                }
+                            }
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Clears the collection and removes all spill files.
+                        /// </summary>
+                        void Clear()
+                        {
+                            _synch.lock();
+
+                            _insertion.Clear();
+                            _heads.clear();
+                            _runs.clear();
+                            _size = 0;
+
+                            _synch.unlock();
+                        }
+
+                        /// <summary>
+                        /// Gets size of queue.
+                        /// </summary>
+                        /// <returns>Size of queue.</returns>
+                        std::size_t Size() const noexcept
+                        {
+                            return _size;
+                        }
+
+                        /// <summary>
+                        /// Peeks at top element of the queue.
+                        /// </summary>
+                        /// <returns>Top element of queue.</returns>
+                        const T & Peek() const
+                        {
+                            if (Size() > 0)
+                            {
+                                if (_heads.empty() || (!_insertion.Empty() && _insertion.Top() < Head(_heads.front())))
+                                {
+                                    return _insertion.Top().Item;
+                                }
+
+                                return Head(_heads.front()).Item;
+                            }
+
+                            throw std::exception("You can't peek empty queue.");
+                        }
+
+                        /// <summary>
+                        /// Gets number of spilled runs.
+                        /// </summary>
+                        /// <returns>Number of runs.</returns>
+                        std::size_t RunCount() const noexcept
+                        {
+                            return _runs.size();
+                        }
+
+                        /// <summary>
+                        /// Gets number of items written to spill files so far, including rewrites by run merges.
+                        /// </summary>
+                        /// <returns>Number of items.</returns>
+                        unsigned long long SpilledCount() const noexcept
+                        {
+                            return _spilled;
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="directory">Directory of spill files, current directory if empty.</param>
+                        /// <param name="memoryLimit">Approximate number of bytes the queue may keep in memory, counts only sizeof(T).</param>
+                        /// <param name="maxRuns">Number of runs of one level that are merged into a run of the next level.</param>
+                        /// <param name="serializer">Converts items to bytes and back.</param>
+                        explicit ExternalPriorityQueue(const std::string & directory = std::string(), std::size_t memoryLimit = 64 * 1024 * 1024,
+                            std::size_t maxRuns = 64, const TSerializer & serializer = TSerializer())
+                            : _serializer(serializer)
+                            , _directory(directory)
+                            , _maxRuns(maxRuns < 2 ? 2 : maxRuns)
+                            , _sequence(0)
+                            , _spilled(0)
+                            , _size(0)
+                        {
+                            std::size_t heapEntry = sizeof(Entry) + 2 * sizeof(std::size_t);
+
+                            _insertionCapacity = std::max<std::size_t>(memoryLimit / 2 / heapEntry, 1);
+                            _blockCapacity = std::max<std::size_t>(memoryLimit / 4 / _maxRuns / sizeof(Entry), 16);
+                        }
+
+                        /// <summary>
+                        /// Queue owns its spill files and can't be copied.
+                        /// </summary>
+                        ExternalPriorityQueue(const ExternalPriorityQueue<T, TSerializer> & other) = delete;
+
+                        /// <summary>
+                        /// Queue owns its spill files and can't be copied.
+                        /// </summary>
+                        ExternalPriorityQueue<T, TSerializer> & operator=(const ExternalPriorityQueue<T, TSerializer> & other) = delete;
+
+                    private:
+                        /// <summary>
+                        /// Element of the queue.
+                        /// </summary>
+                        struct Entry
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="priority">The priority.</param>
+                            /// <param name="sequence">Enqueue order.</param>
+                            /// <param name="item">The item.</param>
+                            Entry(unsigned priority, unsigned long long sequence, T && item)
+                                : Priority(priority)
+                                , Sequence(sequence)
+                                , Item(std::move(item))
+                            {
+                            }
+
+                            /// <summary>
+                            /// Compares element to this instance.
+                            /// </summary>
+                            /// <param name="right">Another element.</param>
+                            /// <returns>True if element goes before another.</returns>
+                            bool operator < (const Entry & right) const
+                            {
+                                return Priority < right.Priority || (Priority == right.Priority && Sequence < right.Sequence);
+                            }
+
+                            /// <summary>
+                            /// The priority.
+                            /// </summary>
+                            unsigned Priority;
+
+                            /// <summary>
+                            /// Enqueue order, breaks ties between equal priorities.
+                            /// </summary>
+                            unsigned long long Sequence;
+
+                            /// <summary>
+                            /// The item.
+                            /// </summary>
+                            T Item;
+                        };
+
+                        /// <summary>
+                        /// Sorted spill file.
+                        /// </summary>
+                        struct Run
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="path">Path of the file.</param>
+                            /// <param name="count">Number of records.</param>
+                            /// <param name="level">Number of merges the records went through.</param>
+                            Run(const std::string & path, std::size_t count, unsigned level)
+                                : File(path)
+                                , Path(path)
+                                , Offset(0)
+                                , Position(0)
+                                , Remaining(count)
+                                , Level(level)
+                            {
+                            }
+
+                            /// <summary>
+                            /// Destructs an instance of this class, removes the file.
+                            /// </summary>
+                            ~Run()
+                            {
+                                File.Close();
+                                std::remove(Path.c_str());
+                            }
+
+                            /// <summary>
+                            /// Mapping of the file.
+                            /// </summary>
+                            External::MappedFile File;
+
+                            /// <summary>
+                            /// Path of the file.
+                            /// </summary>
+                            std::string Path;
+
+                            /// <summary>
+                            /// Offset of the first record that hasn't been decoded.
+                            /// </summary>
+                            std::size_t Offset;
+
+                            /// <summary>
+                            /// Decoded records.
+                            /// </summary>
+                            std::vector<Entry> Block;
+
+                            /// <summary>
+                            /// Position of the head in the block.
+                            /// </summary>
+                            std::size_t Position;
+
+                            /// <summary>
+                            /// Number of records that haven't been taken.
+                            /// </summary>
+                            std::size_t Remaining;
+
+                            /// <summary>
+                            /// Number of merges the records went through, spilled runs are on level zero.
+                            /// </summary>
+                            unsigned Level;
+                        };
+
+                        /// <summary>
+                        /// Reads records of a run for a merge without taking them from the run.
+                        /// </summary>
+                        struct MergeCursor
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="source">The run.</param>
+                            explicit MergeCursor(Run * source)
+                                : Source(source)
+                                , Position(source->Position)
+                                , Offset(source->Offset)
+                                , Priority(0)
+                                , Sequence(0)
+                            {
+                            }
+
+                            /// <summary>
+                            /// The run.
+                            /// </summary>
+                            Run * Source;
+
+                            /// <summary>
+                            /// Position of the next decoded record in the block of the run.
+                            /// </summary>
+                            std::size_t Position;
+
+                            /// <summary>
+                            /// Offset of the next record in the file, used after the decoded ones.
+                            /// </summary>
+                            std::size_t Offset;
+
+                            /// <summary>
+                            /// Priority of the next record.
+                            /// </summary>
+                            std::uint32_t Priority;
+
+                            /// <summary>
+                            /// Sequence of the next record.
+                            /// </summary>
+                            std::uint64_t Sequence;
+                        };
+
+                        /// <summary>
+                        /// Size of record header: priority, sequence and size of the item.
+                        /// </summary>
+                        static const std::size_t HeaderSize = sizeof(std::uint32_t) + sizeof(std::uint64_t) + sizeof(std::uint32_t);
+
+                        /// <summary>
+                        /// Heap of items that haven't been spilled.
+                        /// </summary>
+                        Heaps::DaryHeap::DaryHeap<Entry, 4> _insertion;
+
+                        /// <summary>
+                        /// All runs.
+                        /// </summary>
+                        std::vector<std::unique_ptr<Run>> _runs;
+
+                        /// <summary>
+                        /// Heap of runs ordered by their heads, the smallest head is first.
+                        /// </summary>
+                        std::vector<Run *> _heads;
+
+                        /// <summary>
+                        /// Converts items to bytes and back.
+                        /// </summary>
+                        TSerializer _serializer;
+
+                        /// <summary>
+                        /// Directory of spill files.
+                        /// </summary>
+                        std::string _directory;
+
+                        /// <summary>
+                        /// Number of runs of one level that are merged into a run of the next level.
+                        /// </summary>
+                        std::size_t _maxRuns;
+
+                        /// <summary>
+                        /// Number of items after which insertion heap is spilled.
+                        /// </summary>
+                        std::size_t _insertionCapacity;
+
+                        /// <summary>
+                        /// Number of records decoded at once.
+                        /// </summary>
+                        std::size_t _blockCapacity;
+
+                        /// <summary>
+                        /// Number of enqueued items so far.
+                        /// </summary>
+                        unsigned long long _sequence;
+
+                        /// <summary>
+                        /// Number of items written to spill files so far.
+                        /// </summary>
+                        unsigned long long _spilled;
+
+                        /// <summary>
+                        /// Size of queue.
+                        /// </summary>
+                        std::size_t _size;
+
+                        /// <summary>
+                        /// Synchronization context.
+                        /// </summary>
+                        std::mutex _synch;
+
+                        /// <summary>
+                        /// Gets the head of the run.
+                        /// </summary>
+                        /// <param name="run">The run.</param>
+                        /// <returns>The head.</returns>
+                        static const Entry & Head(const Run * run)
+                        {
+                            return run->Block[run->Position];
+                        }
+
+                        /// <summary>
+                        /// Orders runs for the heap of heads.
+                        /// </summary>
+                        /// <param name="left">The run.</param>
+                        /// <param name="right">Another run.</param>
+                        /// <returns>True if head of the run goes after head of another run.</returns>
+                        static bool HeadAfter(const Run * left, const Run * right)
+                        {
+                            return Head(right) < Head(left);
+                        }
+
+                        /// <summary>
+                        /// Orders merge cursors for the heap of cursors.
+                        /// </summary>
+                        /// <param name="left">The cursor.</param>
+                        /// <param name="right">Another cursor.</param>
+                        /// <returns>True if record of the cursor goes after record of another cursor.</returns>
+                        static bool CursorAfter(const MergeCursor & left, const MergeCursor & right)
+                        {
+                            return right.Priority < left.Priority || (right.Priority == left.Priority && right.Sequence < left.Sequence);
+                        }
+
+                        /// <summary>
+                        /// Reads header of the record.
+                        /// </summary>
+                        /// <param name="data">The record.</param>
+                        /// <param name="priority">Receives the priority.</param>
+                        /// <param name="sequence">Receives the sequence.</param>
+                        /// <param name="size">Receives size of the item.</param>
+                        static void ReadHeader(const char * data, std::uint32_t & priority, std::uint64_t & sequence, std::uint32_t & size)
+                        {
+                            std::memcpy(&priority, data, sizeof(priority));
+                            std::memcpy(&sequence, data + sizeof(priority), sizeof(sequence));
+                            std::memcpy(&size, data + sizeof(priority) + sizeof(sequence), sizeof(size));
+                        }
+
+                        /// <summary>
+                        /// Writes the insertion heap as a new run, then merges full levels.
+                        /// </summary>
+                        void Spill()
+                        {
+                            std::string path = External::MappedFile::TemporaryPath(_directory, ".run");
+                            std::size_t count = _insertion.Size();
+                            std::vector<char> record;
+
+                            // The heap is written in order without being modified, items are dropped only after the run is in place.
+                            typename Heaps::DaryHeap::DaryHeap<Entry, 4>::OrderedIterator entry = _insertion.OrderedBegin();
+
+                            WriteRun(path, count, [this, &entry, &record](std::ofstream & output)
+                            {
+                                WriteEntry(output, *entry, record);
+                                ++entry;
+                            });
+
+                            AddRun(path, count, 0);
+                            _insertion.Clear();
+
+                            for (unsigned level = 0; MergeRuns(level); ++level)
+                            {
+                            }
+                        }
+
+                        /// <summary>
+                        /// Merges runs of the level into a single run of the next level if the level is full.
+                        /// Merged runs are read without taking records and removed only after the new run is in place.
+                        /// </summary>
+                        /// <param name="level">The level.</param>
+                        /// <returns>True if runs have been merged.</returns>
+                        bool MergeRuns(unsigned level)
+                        {
+                            std::vector<MergeCursor> cursors;
+                            std::size_t count = 0;
+
+                            for (const std::unique_ptr<Run> & run : _runs)
+                            {
+                                if (run->Level == level)
+                                {
+                                    cursors.push_back(MergeCursor(run.get()));
+                                    count += run->Remaining;
+                                }
+                            }
+
+                            if (cursors.size() < _maxRuns)
+                            {
+                                return false;
+                            }
+
+                            for (MergeCursor & cursor : cursors)
+                            {
+                                LoadKey(cursor);
+                            }
+
+                            std::make_heap(cursors.begin(), cursors.end(), CursorAfter);
+
+                            std::string path = External::MappedFile::TemporaryPath(_directory, ".run");
+                            std::vector<char> record;
+
+                            WriteRun(path, count, [this, &cursors, &record](std::ofstream & output)
+                            {
+                                std::pop_heap(cursors.begin(), cursors.end(), CursorAfter);
+
+                                MergeCursor & cursor = cursors.back();
+
+                                if (cursor.Position < cursor.Source->Block.size())
+                                {
+                                    WriteEntry(output, cursor.Source->Block[cursor.Position++], record);
+                                }
+                                else
+                                {
+                                    // Records that haven't been decoded are copied as they are.
+                                    const char * data = cursor.Source->File.Data() + cursor.Offset;
+                                    std::uint32_t priority;
+                                    std::uint64_t sequence;
+                                    std::uint32_t size;
+
+                                    ReadHeader(data, priority, sequence, size);
+                                    output.write(data, HeaderSize + size);
+                                    cursor.Offset += HeaderSize + size;
+                                }
+
+                                if (LoadKey(cursor))
+                                {
+                                    std::push_heap(cursors.begin(), cursors.end(), CursorAfter);
+                                }
+                                else
+                                {
+                                    cursors.pop_back();
+                                }
+                            });
+
+                            AddRun(path, count, level + 1);
+
+                            _runs.erase(std::remove_if(_runs.begin(), _runs.end(), [level](const std::unique_ptr<Run> & run) { return run->Level == level; }), _runs.end());
+
+                            _heads.clear();
+
+                            for (const std::unique_ptr<Run> & run : _runs)
+                            {
+                                _heads.push_back(run.get());
+                            }
+
+                            std::make_heap(_heads.begin(), _heads.end(), HeadAfter);
+
+                            return true;
+                        }
+
+                        /// <summary>
+                        /// Reads key of the next record of the cursor.
+                        /// </summary>
+                        /// <param name="cursor">The cursor.</param>
+                        /// <returns>False if the cursor has no more records.</returns>
+                        static bool LoadKey(MergeCursor & cursor)
+                        {
+                            const Run * run = cursor.Source;
+
+                            if (cursor.Position < run->Block.size())
+                            {
+                                cursor.Priority = run->Block[cursor.Position].Priority;
+                                cursor.Sequence = run->Block[cursor.Position].Sequence;
+
+                                return true;
+                            }
+
+                            if (cursor.Offset < run->File.Size())
+                            {
+                                std::uint32_t size;
+
+                                ReadHeader(run->File.Data() + cursor.Offset, cursor.Priority, cursor.Sequence, size);
+
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Writes a run. The file is removed if it can't be written completely.
+                        /// </summary>
+                        /// <param name="path">Path of the file.</param>
+                        /// <param name="count">Number of records.</param>
+                        /// <param name="write">Writes the next record to the stream.</param>
+                        template<typename TWrite>
+                        void WriteRun(const std::string & path, std::size_t count, TWrite write)
+                        {
+                            std::ofstream output(path, std::ios::binary | std::ios::trunc);
+
+                            if (!output)
+                            {
+                                throw std::exception("Can't create spill file.");
+                            }
+
+                            try
+                            {
+                                for (std::size_t i = 0; i < count && output; ++i)
+                                {
+                                    write(output);
+                                }
+                            }
+                            catch (...)
+                            {
+                                output.close();
+                                std::remove(path.c_str());
+                                throw;
+                            }
+
+                            output.close();
+
+                            if (!output)
+                            {
+                                std::remove(path.c_str());
+                                throw std::exception("Can't write spill file.");
+                            }
+
+                            _spilled += count;
+                        }
+
+                        /// <summary>
+                        /// Writes the entry as a record.
+                        /// </summary>
+                        /// <param name="output">The stream.</param>
+                        /// <param name="entry">The entry.</param>
+                        /// <param name="record">Buffer of the record.</param>
+                        void WriteEntry(std::ofstream & output, const Entry & entry, std::vector<char> & record) const
+                        {
+                            std::uint32_t priority = entry.Priority;
+                            std::uint64_t sequence = entry.Sequence;
+
+                            record.resize(HeaderSize);
+                            _serializer.Serialize(entry.Item, record);
+
+                            std::uint32_t size = static_cast<std::uint32_t>(record.size() - HeaderSize);
+
+                            std::memcpy(record.data(), &priority, sizeof(priority));
+                            std::memcpy(record.data() + sizeof(priority), &sequence, sizeof(sequence));
+                            std::memcpy(record.data() + sizeof(priority) + sizeof(sequence), &size, sizeof(size));
+
+                            output.write(record.data(), record.size());
+                        }
+
+                        /// <summary>
+                        /// Maps the file and adds it to the heap of heads. The file is removed if it can't be added.
+                        /// </summary>
+                        /// <param name="path">Path of the file.</param>
+                        /// <param name="count">Number of records.</param>
+                        /// <param name="level">Number of merges the records went through.</param>
+                        void AddRun(const std::string & path, std::size_t count, unsigned level)
+                        {
+                            _runs.reserve(_runs.size() + 1);
+                            _heads.reserve(_heads.size() + 1);
+
+                            std::unique_ptr<Run> run;
+
+                            try
+                            {
+                                run.reset(new Run(path, count, level));
+                            }
+                            catch (...)
+                            {
+                                std::remove(path.c_str());
+                                throw;
+                            }
+
+                            if (!Decode(*run))
+                            {
+                                return;
+                            }
+
+                            _heads.push_back(run.get());
+                            std::push_heap(_heads.begin(), _heads.end(), HeadAfter);
+
+                            _runs.push_back(std::move(run));
+                        }
+
+                        /// <summary>
+                        /// Removes the smallest head of all runs.
+                        /// </summary>
+                        /// <returns>The head.</returns>
+                        Entry TakeFromRuns()
+                        {
+                            std::pop_heap(_heads.begin(), _heads.end(), HeadAfter);
+
+                            Run * run = _heads.back();
+                            Entry entry = std::move(run->Block[run->Position++]);
+                            run->Remaining--;
+
+                            if (run->Position < run->Block.size() || Decode(*run))
+                            {
+                                std::push_heap(_heads.begin(), _heads.end(), HeadAfter);
+                            }
+                            else
+                            {
+                                _heads.pop_back();
+
+                                for (std::size_t i = 0; i < _runs.size(); ++i)
+                                {
+                                    if (_runs[i].get() == run)
+                                    {
+                                        _runs.erase(_runs.begin() + i);
+                                        break;
+                                    }
+                                }
+                            }
+
+                            return entry;
+                        }
+
+                        /// <summary>
+                        /// Decodes the next block of records of the run.
+                        /// </summary>
+                        /// <param name="run">The run.</param>
+                        /// <returns>False if the run has no more records.</returns>
+                        bool Decode(Run & run)
+                        {
+                            const char * data = run.File.Data();
+
+                            run.Block.clear();
+                            run.Position = 0;
+
+                            while (run.Block.size() < _blockCapacity && run.Offset < run.File.Size())
+                            {
+                                std::uint32_t priority;
+                                std::uint64_t sequence;
+                                std::uint32_t size;
+
+                                ReadHeader(data + run.Offset, priority, sequence, size);
+
+                                run.Block.push_back(Entry(priority, sequence, _serializer.Deserialize(data + run.Offset + HeaderSize, size)));
+                                run.Offset += HeaderSize + size;
+                            }
+
+                            return !run.Block.empty();
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
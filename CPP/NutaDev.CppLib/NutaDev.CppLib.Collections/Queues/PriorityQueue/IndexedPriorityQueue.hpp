@@ -0,0 +1,566 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_INDEXEDPRIORITYQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_INDEXEDPRIORITYQUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../../Heaps/HeapEngines.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    /// <summary>
+                    /// Priority queue whose items are identified by unique keys, so they can be found, cancelled and
+                    /// reprioritized without scanning the queue or leaving tombstones in it. Index is an open addressing
+                    /// hash table with linear probing from key to heap handle. Handles of all heap engines stay valid while
+                    /// the heap links and cuts its nodes, so only enqueue, dequeue, cancel and reprioritize touch the index.
+                    /// Removed keys are deleted by backward shift, the table never contains tombstones either.
+                    /// Items of equal priority are dequeued in FIFO order.
+                    /// </summary>
+                    template<typename TKey, typename T, typename THash = std::hash<TKey>, typename TEngine = Heaps::FibonacciHeapEngine>
+                    class IndexedPriorityQueue
+                    {
+                    public:
+                        /// <summary>
+                        /// Tries to enqueue element to queue.
+                        /// </summary>
+                        /// <param name="key">Unique key of the item.</param>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(const TKey & key, const T & value, unsigned priority)
+                        {
+                            return TryEnqueue(key, T(value), priority);
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element to queue. Key can't be already in the queue.
+                        /// </summary>
+                        /// <param name="key">Unique key of the item.</param>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(const TKey & key, T && value, unsigned priority)
+                        {
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                std::size_t hash = _hash(key);
+
+                                if (Find(key, hash) != NotFound)
+                                {
+                                    throw std::exception("Key is already in the queue.");
+                                }
+
+                                if ((_heap.Size() + 1) * 2 > _slots.size())
+                                {
+                                    Grow();
+                                }
+
+                                Place(hash, _heap.Push(Entry(key, std::move(value), priority, _sequence++, hash)));
+
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element from queue.
+                        /// </summary>
+                        /// <param name="value">Item to dequeue.</param>
+                        /// <returns>True if item has been dequeued.</returns>
+                        bool TryDequeue(T & value)
+                        {
+                            bool result = false;
+
+                            if (_synch.try_lock())
+                            {
+                                if (_heap.Size() > 0)
+                                {
+                                    std::size_t slot = Find(_heap.Top().Key, _heap.Top().Hash);
+                                    Entry entry = _heap.EraseMinimum();
+                                    RemoveSlot(slot);
+
+                                    value = std::move(entry.Item);
+                                    result = true;
+                                }
+
+                                _synch.unlock();
+                            }
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element from queue.
+                        /// </summary>
+                        /// <param name="key">Key of dequeued item.</param>
+                        /// <param name="value">Item to dequeue.</param>
+                        /// <returns>True if item has been dequeued.</returns>
+                        bool TryDequeue(TKey & key, T & value)
+                        {
+                            bool result = false;
+
+                            if (_synch.try_lock())
+                            {
+                                if (_heap.Size() > 0)
+                                {
+                                    std::size_t slot = Find(_heap.Top().Key, _heap.Top().Hash);
+                                    Entry entry = _heap.EraseMinimum();
+                                    RemoveSlot(slot);
+
+                                    key = std::move(entry.Key);
+                                    value = std::move(entry.Item);
+                                    result = true;
+                                }
+
+                                _synch.unlock();
+                            }
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Removes the item from the queue.
+                        /// </summary>
+                        /// <param name="key">Key of the item.</param>
+                        /// <returns>True if item has been in the queue.</returns>
+                        bool Cancel(const TKey & key)
+                        {
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            std::size_t slot = Find(key, _hash(key));
+
+                            if (slot == NotFound)
+                            {
+                                return false;
+                            }
+
+                            _heap.Erase(_slots[slot].Node);
+                            RemoveSlot(slot);
+
+                            return true;
+                        }
+
+                        /// <summary>
+                        /// Changes priority of the item in place, the handle of the item stays the same.
+                        /// Item keeps its place among items of the new priority.
+                        /// </summary>
+                        /// <param name="key">Key of the item.</param>
+                        /// <param name="priority">The new priority.</param>
+                        /// <returns>True if item has been in the queue.</returns>
+                        bool Reprioritize(const TKey & key, unsigned priority)
+                        {
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            std::size_t slot = Find(key, _hash(key));
+
+                            if (slot == NotFound)
+                            {
+                                return false;
+                            }
+
+                            // Heap orders entries only by priority and sequence, so the item can be moved out of the stored entry.
+                            Entry & stored = const_cast<Entry &>(_heap.Get(_slots[slot].Node));
+                            Entry entry(stored.Key, std::move(stored.Item), priority, stored.Sequence, stored.Hash);
+
+                            _heap.Update(_slots[slot].Node, std::move(entry));
+
+                            return true;
+                        }
+
+                        /// <summary>
+                        /// Indicates whether the item is in the queue.
+                        /// </summary>
+                        /// <param name="key">Key of the item.</param>
+                        /// <returns>True if item is in the queue.</returns>
+                        bool Contains(const TKey & key) const
+                        {
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            return Find(key, _hash(key)) != NotFound;
+                        }
+
+                        /// <summary>
+                        /// Gets priority of the item.
+                        /// </summary>
+                        /// <param name="key">Key of the item.</param>
+                        /// <param name="priority">Priority of the item.</param>
+                        /// <returns>True if item is in the queue.</returns>
+                        bool TryGetPriority(const TKey & key, unsigned & priority) const
+                        {
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            std::size_t slot = Find(key, _hash(key));
+
+                            if (slot == NotFound)
+                            {
+                                return false;
+                            }
+
+                            priority = _heap.Get(_slots[slot].Node).Priority;
+
+                            return true;
+                        }
+
+                        /// <summary>
+                        /// Clears the collection.
+                        /// </summary>
+                        void Clear()
+                        {
+                            _synch.lock();
+
+                            _heap.Clear();
+
+                            for (Slot & slot : _slots)
+                            {
+                                slot.Used = false;
+                            }
+
+                            _synch.unlock();
+                        }
+
+                        /// <summary>
+                        /// Gets size of queue.
+                        /// </summary>
+                        /// <returns>Size of queue.</returns>
+                        unsigned Size() const noexcept
+                        {
+                            return static_cast<unsigned>(_heap.Size());
+                        }
+
+                        /// <summary>
+                        /// Peeks at top element of the queue.
+                        /// </summary>
+                        /// <returns>Top element of queue.</returns>
+                        const T & Peek() const
+                        {
+                            if (Size() > 0)
+                            {
+                                return _heap.Top().Item;
+                            }
+
+                            throw std::exception("You can't peek empty queue.");
+                        }
+
+                        /// <summary>
+                        /// Peeks at key of top element of the queue.
+                        /// </summary>
+                        /// <returns>Key of top element of queue.</returns>
+                        const TKey & PeekKey() const
+                        {
+                            if (Size() > 0)
+                            {
+                                return _heap.Top().Key;
+                            }
+
+                            throw std::exception("You can't peek empty queue.");
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="hash">Hash of keys.</param>
+                        explicit IndexedPriorityQueue(const THash & hash = THash())
+                            : _hash(hash)
+                            , _shift(64)
+                            , _sequence(0)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Queue owns its synchronization context and can't be copied.
+                        /// </summary>
+                        IndexedPriorityQueue(const IndexedPriorityQueue<TKey, T, THash, TEngine> & other) = delete;
+
+                        /// <summary>
+                        /// Queue owns its synchronization context and can't be copied.
+                        /// </summary>
+                        IndexedPriorityQueue<TKey, T, THash, TEngine> & operator=(const IndexedPriorityQueue<TKey, T, THash, TEngine> & other) = delete;
+
+                    private:
+                        /// <summary>
+                        /// Element of the heap.
+                        /// </summary>
+                        struct Entry
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="key">Key of the item.</param>
+                            /// <param name="item">The item.</param>
+                            /// <param name="priority">The priority.</param>
+                            /// <param name="sequence">Enqueue order.</param>
+                            /// <param name="hash">Hash of the key.</param>
+                            Entry(const TKey & key, T && item, unsigned priority, unsigned long long sequence, std::size_t hash)
+                                : Key(key)
+                                , Item(std::move(item))
+                                , Priority(priority)
+                                , Sequence(sequence)
+                                , Hash(hash)
+                            {
+                            }
+
+                            /// <summary>
+                            /// Compares element to this instance.
+                            /// </summary>
+                            /// <param name="right">Another element.</param>
+                            /// <returns>True if element goes before another.</returns>
+                            bool operator < (const Entry & right) const
+                            {
+                                return Priority < right.Priority || (Priority == right.Priority && Sequence < right.Sequence);
+                            }
+
+                            /// <summary>
+                            /// Key of the item.
+                            /// </summary>
+                            TKey Key;
+
+                            /// <summary>
+                            /// The item.
+                            /// </summary>
+                            T Item;
+
+                            /// <summary>
+                            /// The priority.
+                            /// </summary>
+                            unsigned Priority;
+
+                            /// <summary>
+                            /// Enqueue order, breaks ties between equal priorities.
+                            /// </summary>
+                            unsigned long long Sequence;
+
+                            /// <summary>
+                            /// Hash of the key.
+                            /// </summary>
+                            std::size_t Hash;
+                        };
+
+                        /// <summary>
+                        /// Heap of entries.
+                        /// </summary>
+                        typedef typename TEngine::template Heap<Entry> EntryHeap;
+
+                        /// <summary>
+                        /// Handle of heap entry.
+                        /// </summary>
+                        typedef typename EntryHeap::Handle Handle;
+
+                        /// <summary>
+                        /// Element of the index.
+                        /// </summary>
+                        struct Slot
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            Slot()
+                                : Hash(0)
+                                , Node()
+                                , Used(false)
+                            {
+                            }
+
+                            /// <summary>
+                            /// Hash of the key, compared before the key itself.
+                            /// </summary>
+                            std::size_t Hash;
+
+                            /// <summary>
+                            /// Handle of the entry.
+                            /// </summary>
+                            Handle Node;
+
+                            /// <summary>
+                            /// Indicates whether the slot holds an entry.
+                            /// </summary>
+                            bool Used;
+                        };
+
+                        /// <summary>
+                        /// Index of missing key.
+                        /// </summary>
+                        static const std::size_t NotFound = static_cast<std::size_t>(-1);
+
+                        /// <summary>
+                        /// Minimal number of slots.
+                        /// </summary>
+                        static const std::size_t MinimalCapacity = 16;
+
+                        /// <summary>
+                        /// Heap of entries.
+                        /// </summary>
+                        EntryHeap _heap;
+
+                        /// <summary>
+                        /// Index from key to heap handle, power of two sized and at most half full.
+                        /// </summary>
+                        std::vector<Slot> _slots;
+
+                        /// <summary>
+                        /// Hash of keys.
+                        /// </summary>
+                        THash _hash;
+
+                        /// <summary>
+                        /// Shift that maps 64 bit hash to slot index.
+                        /// </summary>
+                        unsigned _shift;
+
+                        /// <summary>
+                        /// Number of enqueued items so far.
+                        /// </summary>
+                        unsigned long long _sequence;
+
+                        /// <summary>
+                        /// Synchronization context.
+                        /// </summary>
+                        mutable std::mutex _synch;
+
+                        /// <summary>
+                        /// Gets the first slot to probe for the hash. Hash is scrambled, so weak hashes like identity don't cluster.
+                        /// </summary>
+                        /// <param name="hash">The hash.</param>
+                        /// <returns>Index of the slot.</returns>
+                        std::size_t Home(std::size_t hash) const
+                        {
+                            return static_cast<std::size_t>((std::uint64_t(hash) * 0x9E3779B97F4A7C15ull) >> _shift);
+                        }
+
+                        /// <summary>
+                        /// Finds slot of the key.
+                        /// </summary>
+                        /// <param name="key">The key.</param>
+                        /// <param name="hash">Hash of the key.</param>
+                        /// <returns>Index of the slot or NotFound.</returns>
+                        std::size_t Find(const TKey & key, std::size_t hash) const
+                        {
+                            if (_slots.empty())
+                            {
+                                return NotFound;
+                            }
+
+                            std::size_t mask = _slots.size() - 1;
+
+                            for (std::size_t i = Home(hash); _slots[i].Used; i = (i + 1) & mask)
+                            {
+                                if (_slots[i].Hash == hash && _heap.Get(_slots[i].Node).Key == key)
+                                {
+                                    return i;
+                                }
+                            }
+
+                            return NotFound;
+                        }
+
+                        /// <summary>
+                        /// Stores the handle in the first free slot. Index can't be full.
+                        /// </summary>
+                        /// <param name="hash">Hash of the key.</param>
+                        /// <param name="node">Handle of the entry.</param>
+                        void Place(std::size_t hash, Handle node)
+                        {
+                            std::size_t mask = _slots.size() - 1;
+                            std::size_t i = Home(hash);
+
+                            while (_slots[i].Used)
+                            {
+                                i = (i + 1) & mask;
+                            }
+
+                            _slots[i].Hash = hash;
+                            _slots[i].Node = node;
+                            _slots[i].Used = true;
+                        }
+
+                        /// <summary>
+                        /// Frees the slot and shifts back the following slots of the probe sequence.
+                        /// </summary>
+                        /// <param name="slot">Index of the slot.</param>
+                        void RemoveSlot(std::size_t slot)
+                        {
+                            std::size_t mask = _slots.size() - 1;
+                            std::size_t hole = slot;
+
+                            for (std::size_t next = (hole + 1) & mask; _slots[next].Used; next = (next + 1) & mask)
+                            {
+                                std::size_t home = Home(_slots[next].Hash);
+
+                                if (((next - home) & mask) >= ((next - hole) & mask))
+                                {
+                                    _slots[hole] = _slots[next];
+                                    hole = next;
+                                }
+                            }
+
+                            _slots[hole].Used = false;
+                        }
+
+                        /// <summary>
+                        /// Doubles the index and places all handles again.
+                        /// </summary>
+                        void Grow()
+                        {
+                            std::vector<Slot> slots(_slots.empty() ? MinimalCapacity : _slots.size() * 2);
+                            slots.swap(_slots);
+
+                            _shift = 64;
+
+                            for (std::size_t capacity = _slots.size(); capacity > 1; capacity /= 2)
+                            {
+                                --_shift;
+                            }
+
+                            for (const Slot & slot : slots)
+                            {
+                                if (slot.Used)
+                                {
+                                    Place(slot.Hash, slot.Node);
+                                }
+                            }
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
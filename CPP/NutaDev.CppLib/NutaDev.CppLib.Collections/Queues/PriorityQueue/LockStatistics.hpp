@@ -0,0 +1,270 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_LOCKSTATISTICS_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_LOCKSTATISTICS_HPP
+
+#include <atomic>
+#include <chrono>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    /// <summary>
+                    /// Counters of lock usage of a queue.
+                    /// </summary>
+                    struct LockStatisticsSnapshot
+                    {
+                        /// <summary>
+                        /// Number of times the lock has been taken.
+                        /// </summary>
+                        unsigned long long Acquisitions;
+
+                        /// <summary>
+                        /// Number of failed try_lock attempts.
+                        /// </summary>
+                        unsigned long long Contentions;
+
+                        /// <summary>
+                        /// Sum of times spent waiting for the lock.
+                        /// </summary>
+                        std::chrono::nanoseconds TotalWait;
+
+                        /// <summary>
+                        /// The longest time spent waiting for the lock.
+                        /// </summary>
+                        std::chrono::nanoseconds MaximumWait;
+
+                        /// <summary>
+                        /// Sum of times the lock has been held.
+                        /// </summary>
+                        std::chrono::nanoseconds TotalHold;
+
+                        /// <summary>
+                        /// The longest time the lock has been held.
+                        /// </summary>
+                        std::chrono::nanoseconds MaximumHold;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        LockStatisticsSnapshot()
+                            : Acquisitions(0)
+                            , Contentions(0)
+                            , TotalWait(0)
+                            , MaximumWait(0)
+                            , TotalHold(0)
+                            , MaximumHold(0)
+                        {
+                        }
+                    };
+
+                    /// <summary>
+                    /// Lock statistics policy that records nothing and never reads the clock.
+                    /// </summary>
+                    class NoLockStatistics
+                    {
+                    public:
+                        /// <summary>
+                        /// Point in time passed from BeginWait to OnAcquired.
+                        /// </summary>
+                        typedef std::chrono::steady_clock::time_point TimePoint;
+
+                        /// <summary>
+                        /// Indicates whether the policy records anything.
+                        /// </summary>
+                        static const bool Enabled = false;
+
+                        /// <summary>
+                        /// Gets a default time point, doesn't read the clock.
+                        /// </summary>
+                        /// <returns>Default time point.</returns>
+                        TimePoint BeginWait() const noexcept
+                        {
+                            return TimePoint();
+                        }
+
+                        /// <summary>
+                        /// Ignores taking the lock.
+                        /// </summary>
+                        void OnAcquired(TimePoint) noexcept
+                        {
+                        }
+
+                        /// <summary>
+                        /// Ignores taking the lock back after waiting on a condition variable.
+                        /// </summary>
+                        void OnResumed() noexcept
+                        {
+                        }
+
+                        /// <summary>
+                        /// Ignores releasing the lock.
+                        /// </summary>
+                        void OnReleased() noexcept
+                        {
+                        }
+
+                        /// <summary>
+                        /// Ignores failed try_lock.
+                        /// </summary>
+                        void OnContended() noexcept
+                        {
+                        }
+
+                        /// <summary>
+                        /// Gets the counters.
+                        /// </summary>
+                        /// <returns>Zeroed counters.</returns>
+                        LockStatisticsSnapshot Snapshot() const
+                        {
+                            return LockStatisticsSnapshot();
+                        }
+                    };
+
+                    /// <summary>
+                    /// Lock statistics policy that measures wait and hold times with steady_clock.
+                    /// All methods except OnContended and BeginWait are called with the lock held.
+                    /// </summary>
+                    class LockTimingStatistics
+                    {
+                    public:
+                        /// <summary>
+                        /// Point in time passed from BeginWait to OnAcquired.
+                        /// </summary>
+                        typedef std::chrono::steady_clock::time_point TimePoint;
+
+                        /// <summary>
+                        /// Indicates whether the policy records anything.
+                        /// </summary>
+                        static const bool Enabled = true;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        LockTimingStatistics()
+                            : _contentions(0)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Gets the time when waiting for the lock starts.
+                        /// </summary>
+                        /// <returns>Current time.</returns>
+                        TimePoint BeginWait() const noexcept
+                        {
+                            return std::chrono::steady_clock::now();
+                        }
+
+                        /// <summary>
+                        /// Records taking the lock.
+                        /// </summary>
+                        /// <param name="waitStart">Result of BeginWait called before waiting for the lock.</param>
+                        void OnAcquired(TimePoint waitStart) noexcept
+                        {
+                            _acquiredAt = std::chrono::steady_clock::now();
+
+                            std::chrono::nanoseconds wait = std::chrono::duration_cast<std::chrono::nanoseconds>(_acquiredAt - waitStart);
+
+                            ++_snapshot.Acquisitions;
+                            _snapshot.TotalWait += wait;
+
+                            if (wait > _snapshot.MaximumWait)
+                            {
+                                _snapshot.MaximumWait = wait;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Records taking the lock back after waiting on a condition variable, the waiting is not counted.
+                        /// </summary>
+                        void OnResumed() noexcept
+                        {
+                            _acquiredAt = std::chrono::steady_clock::now();
+                        }
+
+                        /// <summary>
+                        /// Records releasing the lock.
+                        /// </summary>
+                        void OnReleased() noexcept
+                        {
+                            std::chrono::nanoseconds hold = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _acquiredAt);
+
+                            _snapshot.TotalHold += hold;
+
+                            if (hold > _snapshot.MaximumHold)
+                            {
+                                _snapshot.MaximumHold = hold;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Records failed try_lock, may be called without the lock.
+                        /// </summary>
+                        void OnContended() noexcept
+                        {
+                            _contentions.fetch_add(1, std::memory_order_relaxed);
+                        }
+
+                        /// <summary>
+                        /// Gets the counters, has to be called with the lock held.
+                        /// </summary>
+                        /// <returns>Copy of the counters.</returns>
+                        LockStatisticsSnapshot Snapshot() const
+                        {
+                            LockStatisticsSnapshot result = _snapshot;
+
+                            result.Contentions = _contentions.load(std::memory_order_relaxed);
+
+                            return result;
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Counters updated with the lock held.
+                        /// </summary>
+                        LockStatisticsSnapshot _snapshot;
+
+                        /// <summary>
+                        /// Number of failed try_lock attempts.
+                        /// </summary>
+                        std::atomic<unsigned long long> _contentions;
+
+                        /// <summary>
+                        /// Time when the lock has been taken by the current holder.
+                        /// </summary>
+                        TimePoint _acquiredAt;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
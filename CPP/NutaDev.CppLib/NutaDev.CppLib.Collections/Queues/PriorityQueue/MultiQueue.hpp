@@ -0,0 +1,524 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_MULTIQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_MULTIQUEUE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <utility>
+
+#include "../../Heaps/HeapEngines.hpp"
+#include "../../Memory/CacheLine.hpp"
+#include "PriorityQueueItem.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    /// <summary>
+                    /// Relaxed concurrent priority queue made of several independently locked sub-queues.
+                    /// Enqueue goes to a random sub-queue, dequeue samples a few random sub-queues and takes the
+                    /// best of their tops. Dequeued item is not always the global minimum, the expected rank error
+                    /// grows with the number of sub-queues and shrinks with the number of choices.
+                    /// With threads * queuesPerThread sub-queues and two choices the expected rank error is O(number of sub-queues).
+                    /// </summary>
+                    template<typename T, typename TEngine = Heaps::QuaternaryHeapEngine>
+                    class MultiQueue
+                    {
+                    public:
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        /// <param name="threads">Expected number of threads, hardware concurrency if zero.</param>
+                        /// <param name="queuesPerThread">Number of sub-queues per thread.</param>
+                        /// <param name="choices">Number of sub-queues sampled by dequeue.</param>
+                        explicit MultiQueue(unsigned threads = 0, unsigned queuesPerThread = 2, unsigned choices = 2)
+                            : _memory(nullptr)
+                            , _queues(nullptr)
+                            , _choices(choices)
+                            , _size(0)
+                            , _waiters(0)
+                        {
+                            if (threads == 0)
+                            {
+                                threads = std::thread::hardware_concurrency();
+                            }
+
+                            if (threads == 0)
+                            {
+                                threads = 1;
+                            }
+
+                            if (queuesPerThread == 0 || choices == 0)
+                            {
+                                throw std::exception("Number of sub-queues and choices has to be positive.");
+                            }
+
+                            _queueCount = threads * queuesPerThread;
+                            _memory = ::operator new(_queueCount * sizeof(SubQueue) + alignof(SubQueue));
+                            _queues = reinterpret_cast<SubQueue *>((reinterpret_cast<std::uintptr_t>(_memory) + alignof(SubQueue) - 1) & ~static_cast<std::uintptr_t>(alignof(SubQueue) - 1));
+
+                            unsigned constructed = 0;
+
+                            try
+                            {
+                                for (; constructed < _queueCount; ++constructed)
+                                {
+                                    new (&_queues[constructed]) SubQueue();
+                                }
+                            }
+                            catch (...)
+                            {
+                                _queueCount = constructed;
+                                Destroy();
+                                throw;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Queue owns locks and can't be copied.
+                        /// </summary>
+                        MultiQueue(const MultiQueue<T, TEngine> & other) = delete;
+
+                        /// <summary>
+                        /// Queue owns locks and can't be copied.
+                        /// </summary>
+                        MultiQueue<T, TEngine> & operator=(const MultiQueue<T, TEngine> & other) = delete;
+
+                        /// <summary>
+                        /// Destructs instance of this class.
+                        /// </summary>
+                        ~MultiQueue()
+                        {
+                            Destroy();
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element. Doesn't block, gives up when every tried sub-queue is locked.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T && value, unsigned priority)
+                        {
+                            return TryEmplace(priority, std::move(value));
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element. Doesn't block, gives up when every tried sub-queue is locked.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(const T & value, unsigned priority)
+                        {
+                            return TryEmplace(priority, value);
+                        }
+
+                        /// <summary>
+                        /// Tries to construct element in place. Doesn't block, gives up when every tried sub-queue is locked.
+                        /// </summary>
+                        /// <param name="priority">Element priority.</param>
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        template<typename... TArgs>
+                        bool TryEmplace(unsigned priority, TArgs &&... args)
+                        {
+                            std::unique_lock<std::mutex> lock;
+                            SubQueue * queue = TryLockAny(lock);
+
+                            if (queue == nullptr)
+                            {
+                                return false;
+                            }
+
+                            Push(*queue, lock, priority, std::forward<TArgs>(args)...);
+                            return true;
+                        }
+
+                        /// <summary>
+                        /// Enqueues element, waits for a sub-queue if all tried ones are locked.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority.</param>
+                        void Enqueue(T && value, unsigned priority)
+                        {
+                            Emplace(priority, std::move(value));
+                        }
+
+                        /// <summary>
+                        /// Enqueues element, waits for a sub-queue if all tried ones are locked.
+                        /// </summary>
+                        /// <param name="value">Item to enqueue.</param>
+                        /// <param name="priority">Element priority.</param>
+                        void Enqueue(const T & value, unsigned priority)
+                        {
+                            Emplace(priority, value);
+                        }
+
+                        /// <summary>
+                        /// Constructs element in place, waits for a sub-queue if all tried ones are locked.
+                        /// </summary>
+                        /// <param name="priority">Element priority.</param>
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        template<typename... TArgs>
+                        void Emplace(unsigned priority, TArgs &&... args)
+                        {
+                            std::unique_lock<std::mutex> lock;
+                            SubQueue * queue = TryLockAny(lock);
+
+                            if (queue == nullptr)
+                            {
+                                queue = &_queues[RandomIndex()];
+                                lock = std::unique_lock<std::mutex>(queue->Synch);
+                            }
+
+                            Push(*queue, lock, priority, std::forward<TArgs>(args)...);
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element. Doesn't block.
+                        /// </summary>
+                        /// <param name="value">Dequeued item.</param>
+                        /// <returns>True if item has been dequeued, false if queue is empty or all tried sub-queues are locked.</returns>
+                        bool TryDequeue(T & value)
+                        {
+                            for (unsigned attempt = 0; attempt < _queueCount && _size.load() > 0; ++attempt)
+                            {
+                                SubQueue * best = Sample();
+
+                                if (best == nullptr)
+                                {
+                                    best = FirstNonEmpty();
+
+                                    if (best == nullptr)
+                                    {
+                                        continue;
+                                    }
+                                }
+
+                                std::unique_lock<std::mutex> lock(best->Synch, std::try_to_lock);
+
+                                if (lock.owns_lock() && Pop(*best, value))
+                                {
+                                    return true;
+                                }
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Dequeues element, waits until one is available.
+                        /// </summary>
+                        /// <param name="value">Dequeued item.</param>
+                        void Dequeue(T & value)
+                        {
+                            while (!TryDequeue(value))
+                            {
+                                std::unique_lock<std::mutex> lock(_waitSynch);
+
+                                _waiters++;
+                                _available.wait(lock, [this]() { return _size.load() > 0; });
+                                _waiters--;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Clears the collection.
+                        /// </summary>
+                        void Clear()
+                        {
+                            for (unsigned i = 0; i < _queueCount; ++i)
+                            {
+                                SubQueue & queue = _queues[i];
+                                std::lock_guard<std::mutex> lock(queue.Synch);
+
+                                _size -= queue.Heap.Size();
+                                queue.Heap.Clear();
+                                queue.Top.store(EmptyTop);
+                            }
+                        }
+
+                        /// <summary>
+                        /// Gets size of queue.
+                        /// </summary>
+                        /// <returns>Size of queue.</returns>
+                        unsigned Size() const noexcept
+                        {
+                            return _size.load();
+                        }
+
+                        /// <summary>
+                        /// Gets number of sub-queues.
+                        /// </summary>
+                        /// <returns>Number of sub-queues.</returns>
+                        unsigned QueueCount() const noexcept
+                        {
+                            return _queueCount;
+                        }
+
+                        /// <summary>
+                        /// Gets number of sub-queues sampled by dequeue.
+                        /// </summary>
+                        /// <returns>Number of choices.</returns>
+                        unsigned Choices() const noexcept
+                        {
+                            return _choices;
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Value of Top of an empty sub-queue.
+                        /// </summary>
+                        static const std::uint64_t EmptyTop = std::numeric_limits<std::uint64_t>::max();
+
+                        /// <summary>
+                        /// Sub-queue, occupies whole cache lines so locks of neighbouring sub-queues are not falsely shared.
+                        /// </summary>
+                        struct alignas(Memory::CacheLineSize) SubQueue
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            SubQueue()
+                                : Top(EmptyTop)
+                            {
+                            }
+
+                            /// <summary>
+                            /// Synchronization context.
+                            /// </summary>
+                            std::mutex Synch;
+
+                            /// <summary>
+                            /// Priority of the top item, readable without the lock.
+                            /// </summary>
+                            std::atomic<std::uint64_t> Top;
+
+                            /// <summary>
+                            /// Items of the sub-queue.
+                            /// </summary>
+                            typename TEngine::template Heap<PriorityQueueItem<T>> Heap;
+                        };
+
+                        /// <summary>
+                        /// Memory of the sub-queues, over-allocated by one alignment.
+                        /// </summary>
+                        void * _memory;
+
+                        /// <summary>
+                        /// Sub-queues, aligned to cache line.
+                        /// </summary>
+                        SubQueue * _queues;
+
+                        /// <summary>
+                        /// Number of sub-queues.
+                        /// </summary>
+                        unsigned _queueCount;
+
+                        /// <summary>
+                        /// Number of sub-queues sampled by dequeue.
+                        /// </summary>
+                        unsigned _choices;
+
+                        /// <summary>
+                        /// Size of queue.
+                        /// </summary>
+                        std::atomic<unsigned> _size;
+
+                        /// <summary>
+                        /// Number of threads waiting in Dequeue.
+                        /// </summary>
+                        std::atomic<unsigned> _waiters;
+
+                        /// <summary>
+                        /// Synchronization context of waiting threads.
+                        /// </summary>
+                        std::mutex _waitSynch;
+
+                        /// <summary>
+                        /// Signalled when an item has been enqueued.
+                        /// </summary>
+                        std::condition_variable _available;
+
+                        /// <summary>
+                        /// Destructs the sub-queues and releases their memory.
+                        /// </summary>
+                        void Destroy()
+                        {
+                            for (unsigned i = 0; i < _queueCount; ++i)
+                            {
+                                _queues[i].~SubQueue();
+                            }
+
+                            ::operator delete(_memory);
+                        }
+
+                        /// <summary>
+                        /// Gets random sub-queue index from the generator of the calling thread.
+                        /// </summary>
+                        /// <returns>The index.</returns>
+                        unsigned RandomIndex() const
+                        {
+                            thread_local std::minstd_rand random(static_cast<std::minstd_rand::result_type>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+
+                            return static_cast<unsigned>(random() % _queueCount);
+                        }
+
+                        /// <summary>
+                        /// Tries to lock random sub-queues, gives up when every tried one is locked.
+                        /// </summary>
+                        /// <param name="lock">Receives the lock of the sub-queue.</param>
+                        /// <returns>The locked sub-queue, null if none could be locked.</returns>
+                        SubQueue * TryLockAny(std::unique_lock<std::mutex> & lock)
+                        {
+                            for (unsigned attempt = 0; attempt < _queueCount; ++attempt)
+                            {
+                                SubQueue & queue = _queues[RandomIndex()];
+                                std::unique_lock<std::mutex> attemptLock(queue.Synch, std::try_to_lock);
+
+                                if (attemptLock.owns_lock())
+                                {
+                                    lock = std::move(attemptLock);
+                                    return &queue;
+                                }
+                            }
+
+                            return nullptr;
+                        }
+
+                        /// <summary>
+                        /// Constructs new item in locked sub-queue, unlocks it and wakes up one waiting thread.
+                        /// </summary>
+                        /// <param name="queue">Locked sub-queue.</param>
+                        /// <param name="lock">Lock of the sub-queue.</param>
+                        /// <param name="priority">Item priority.</param>
+                        /// <param name="args">Arguments of the item constructor.</param>
+                        template<typename... TArgs>
+                        void Push(SubQueue & queue, std::unique_lock<std::mutex> & lock, unsigned priority, TArgs &&... args)
+                        {
+                            queue.Heap.Emplace(std::piecewise_construct, priority, std::forward<TArgs>(args)...);
+                            queue.Top.store(queue.Heap.Top().Priority);
+
+                            // Counted before unlocking, so no thread can pop the item before it is counted.
+                            _size++;
+
+                            lock.unlock();
+
+                            if (_waiters.load() > 0)
+                            {
+                                std::lock_guard<std::mutex> waitLock(_waitSynch);
+                                _available.notify_one();
+                            }
+                        }
+
+                        /// <summary>
+                        /// Pops the top item of locked sub-queue.
+                        /// </summary>
+                        /// <param name="queue">Locked sub-queue.</param>
+                        /// <param name="value">Popped item.</param>
+                        /// <returns>True if sub-queue wasn't empty.</returns>
+                        bool Pop(SubQueue & queue, T & value)
+                        {
+                            if (queue.Heap.Empty())
+                            {
+                                return false;
+                            }
+
+                            PriorityQueueItem<T> top = queue.Heap.EraseMinimum();
+
+                            queue.Top.store(queue.Heap.Empty() ? EmptyTop : queue.Heap.Top().Priority);
+                            _size--;
+
+                            std::swap(value, top.Item);
+                            return true;
+                        }
+
+                        /// <summary>
+                        /// Samples random sub-queues and picks the one with the best top.
+                        /// </summary>
+                        /// <returns>The sub-queue, null if all sampled sub-queues are empty.</returns>
+                        SubQueue * Sample()
+                        {
+                            SubQueue * best = nullptr;
+                            std::uint64_t bestTop = EmptyTop;
+
+                            for (unsigned i = 0; i < _choices; ++i)
+                            {
+                                SubQueue & queue = _queues[RandomIndex()];
+                                std::uint64_t top = queue.Top.load(std::memory_order_relaxed);
+
+                                if (top < bestTop)
+                                {
+                                    best = &queue;
+                                    bestTop = top;
+                                }
+                            }
+
+                            return best;
+                        }
+
+                        /// <summary>
+                        /// Finds any non-empty sub-queue, used when sampling keeps hitting empty ones.
+                        /// </summary>
+                        /// <returns>The sub-queue, null if all sub-queues are empty.</returns>
+                        SubQueue * FirstNonEmpty()
+                        {
+                            unsigned start = RandomIndex();
+
+                            for (unsigned i = 0; i < _queueCount; ++i)
+                            {
+                                SubQueue & queue = _queues[(start + i) % _queueCount];
+
+                                if (queue.Top.load(std::memory_order_relaxed) != EmptyTop)
+                                {
+                                    return &queue;
+                                }
+                            }
+
+                            return nullptr;
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -23,9 +23,17 @@
 #ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_PRIORITYQUEUE_HPP
 #define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_PRIORITYQUEUE_HPP
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
 
-#include "../../Heaps/FibonacciHeap/FibonacciHeap.hpp"
+#include "../../Heaps/HeapEngines.hpp"
+#include "../DequeueStatus.hpp"
+#include "LockStatistics.hpp"
 #include "PriorityQueueItem.hpp"
 
 namespace NutaDev
@@ -40,25 +48,24 @@ namespace NutaDev
                 {
                     /// <summary>
                     /// The structure of priority queue.
+                    /// TEngine selects the heap that stores the items, see Heaps/HeapEngines.hpp.
+                    /// TLockStatistics measures lock wait and hold times, see LockStatistics.hpp. The default records nothing.
                     /// </summary>
                     /// <returns></returns>
-                    template<typename T>
-                    class PriorityQueue
+                    template<typename T, typename TEngine = Heaps::FibonacciHeapEngine, typename TLockStatistics = NoLockStatistics>
+                    class PriorityQueue : private TLockStatistics
                     {
                     public:
                         /// <summary>
                         /// Tries to enqueue element from queue.
                         /// </summary>
                         /// <param name="item">Item to enqueue.</param>
-                        /// <returns>True if item has been enqueued.</returns>
+                        /// <returns>True if item has been enqueued, false if lock is taken or queue is closed.</returns>
                         bool TryEnqueue(T && value, unsigned priority)
                         {
-                            if (_synch.try_lock())
+                            if (TryLock())
                             {
-                                Enqueue(value, priority);
-
-                                _synch.unlock();
-                                return true;
+                                return EmplaceAndUnlock(priority, std::move(value));
                             }
 
                             return false;
@@ -68,15 +75,12 @@ namespace NutaDev
                         /// Tries to enqueue element from queue.
                         /// </summary>
                         /// <param name="item">Item to enqueue.</param>
-                        /// <returns>True if item has been enqueued.</returns>
+                        /// <returns>True if item has been enqueued, false if lock is taken or queue is closed.</returns>
                         bool TryEnqueue(T & value, unsigned priority)
                         {
-                            if (_synch.try_lock())
+                            if (TryLock())
                             {
-                                Enqueue(value, priority);
-
-                                _synch.unlock();
-                                return true;
+                                return EmplaceAndUnlock(priority, value);
                             }
 
                             return false;
@@ -86,20 +90,91 @@ namespace NutaDev
                         /// Tries to enqueue element from queue.
                         /// </summary>
                         /// <param name="item">Item to enqueue.</param>
-                        /// <returns>True if item has been enqueued.</returns>
+                        /// <returns>True if item has been enqueued, false if lock is taken or queue is closed.</returns>
                         bool TryEnqueue(const T & value, unsigned priority)
                         {
-                            if (_synch.try_lock())
+                            if (TryLock())
                             {
-                                Enqueue(value, priority);
+                                return EmplaceAndUnlock(priority, value);
+                            }
 
-                                _synch.unlock();
-                                return true;
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to construct element in place in the queue.
+                        /// </summary>
+                        /// <param name="priority">Element priority.</param>
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        /// <returns>True if item has been enqueued, false if lock is taken or queue is closed.</returns>
+                        template<typename... TArgs>
+                        bool TryEmplace(unsigned priority, TArgs &&... args)
+                        {
+                            if (TryLock())
+                            {
+                                return EmplaceAndUnlock(priority, std::forward<TArgs>(args)...);
                             }
 
                             return false;
                         }
 
+                        /// <summary>
+                        /// Constructs element in place in the queue, waits for the lock.
+                        /// </summary>
+                        /// <param name="priority">Element priority.</param>
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        /// <returns>True if item has been enqueued, false if queue is closed.</returns>
+                        template<typename... TArgs>
+                        bool Emplace(unsigned priority, TArgs &&... args)
+                        {
+                            Lock();
+
+                            return EmplaceAndUnlock(priority, std::forward<TArgs>(args)...);
+                        }
+
+                        /// <summary>
+                        /// Enqueues all items of the range under one lock acquisition.
+                        /// The heap is built in bulk, see PushRange of the engine heap.
+                        /// </summary>
+                        /// <param name="first">Beginning of the range of PriorityQueueItem.</param>
+                        /// <param name="last">End of the range.</param>
+                        /// <returns>True if items have been enqueued, false if queue is closed.</returns>
+                        template<typename TIterator>
+                        bool EnqueueRange(TIterator first, TIterator last)
+                        {
+                            Lock();
+
+                            if (_closed)
+                            {
+                                Unlock();
+                                return false;
+                            }
+
+                            try
+                            {
+                                _heap.PushRange(first, last);
+                            }
+                            catch (...)
+                            {
+                                _size = _heap.Size();
+                                Unlock();
+                                throw;
+                            }
+
+                            _size = _heap.Size();
+
+                            bool wake = _waiters > 0;
+
+                            Unlock();
+
+                            if (wake)
+                            {
+                                _available.notify_all();
+                            }
+
+                            return true;
+                        }
+
                         /// <summary>
                         /// Tries to dequeue element from queue.
                         /// </summary>
@@ -109,40 +184,151 @@ namespace NutaDev
                         {
                             bool result = false;
 
-                            if (_synch.try_lock())
+                            if (TryLock())
                             {
-                                if (Size() > 0)
+                                if (_size > 0)
                                 {
-                                    std::shared_ptr<Heaps::HeapItem<PriorityQueueItem<T>>> minItem = _heap.EraseMinimum();
-                                    std::swap(value, minItem->Key.Item);
+                                    Take(value);
                                     result = true;
-                                    _size--;
                                 }
 
-                                _synch.unlock();
+                                Unlock();
                             }
 
-                            if (Size() == 0)
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Dequeues element without waiting for an item, waits only for the lock.
+                        /// </summary>
+                        /// <param name="value">Dequeued item.</param>
+                        /// <returns>Dequeued, Empty or Closed when queue is closed and empty.</returns>
+                        DequeueStatus Poll(T & value)
+                        {
+                            return Wait(value, Empty, [](std::unique_lock<std::mutex> &, const Ready & ready) { return ready(); });
+                        }
+
+                        /// <summary>
+                        /// Dequeues element, waits until one is enqueued or the queue is closed.
+                        /// </summary>
+                        /// <param name="value">Dequeued item.</param>
+                        /// <returns>Dequeued or Closed when queue is closed and empty.</returns>
+                        DequeueStatus Dequeue(T & value)
+                        {
+                            return Wait(value, Closed, [this](std::unique_lock<std::mutex> & lock, const Ready & ready)
                             {
-                                result = false;
-                            }
+                                _available.wait(lock, ready);
+                                return true;
+                            });
+                        }
 
-                            return result;
+                        /// <summary>
+                        /// Dequeues element, waits at most the timeout.
+                        /// </summary>
+                        /// <param name="value">Dequeued item.</param>
+                        /// <param name="timeout">Maximum waiting time.</param>
+                        /// <returns>Dequeued, Timeout or Closed when queue is closed and empty.</returns>
+                        template<typename TRep, typename TPeriod>
+                        DequeueStatus DequeueFor(T & value, const std::chrono::duration<TRep, TPeriod> & timeout)
+                        {
+                            return Wait(value, Timeout, [this, &timeout](std::unique_lock<std::mutex> & lock, const Ready & ready)
+                            {
+                                return _available.wait_for(lock, timeout, ready);
+                            });
+                        }
+
+                        /// <summary>
+                        /// Dequeues element, waits at most until the deadline.
+                        /// </summary>
+                        /// <param name="value">Dequeued item.</param>
+                        /// <param name="deadline">Point in time when waiting ends.</param>
+                        /// <returns>Dequeued, Timeout or Closed when queue is closed and empty.</returns>
+                        template<typename TClock, typename TDuration>
+                        DequeueStatus DequeueUntil(T & value, const std::chrono::time_point<TClock, TDuration> & deadline)
+                        {
+                            return Wait(value, Timeout, [this, &deadline](std::unique_lock<std::mutex> & lock, const Ready & ready)
+                            {
+                                return _available.wait_until(lock, deadline, ready);
+                            });
+                        }
+
+                        /// <summary>
+                        /// Closes the queue. Enqueue fails afterwards, waiting consumers are woken up and
+                        /// remaining items can still be dequeued.
+                        /// </summary>
+                        void Close()
+                        {
+                            Lock();
+                            _closed = true;
+                            Unlock();
+
+                            _available.notify_all();
+                        }
+
+                        /// <summary>
+                        /// Indicates whether queue is closed.
+                        /// </summary>
+                        /// <returns>True if queue is closed.</returns>
+                        bool IsClosed()
+                        {
+                            Lock();
+
+                            bool closed = _closed;
+
+                            Unlock();
+                            return closed;
                         }
 
                         /// <summary>
-                        /// Joins another queue into this queue.
+                        /// Joins another queue into this queue. Heaps are spliced, items are not copied.
+                        /// Throws when the heaps allocate nodes with different allocators, see AllocatorNodeStorage,
+                        /// both queues are unlocked and unchanged then.
                         /// </summary>
                         /// <param name="other">Another queue to join.</param>
-                        /// <returns>True if queues have been joined.</returns>
-                        bool JoinWith(PriorityQueue<T> & other)
+                        /// <returns>True if queues have been joined, false if either lock is taken.</returns>
+                        bool JoinWith(PriorityQueue<T, TEngine, TLockStatistics> & other)
                         {
-                            if (_synch.try_lock())
+                            if (this == &other)
+                            {
+                                return false;
+                            }
+
+                            if (TryLock())
                             {
-                                _heap = Heaps::FibonacciHeap<PriorityQueueItem<T>>::JoinHeaps(_heap, other._heap);
+                                if (!other.TryLock())
+                                {
+                                    Unlock();
+                                    return false;
+                                }
+
+                                try
+                                {
+                                    _heap.Join(other._heap);
+                                }
+                                catch (...)
+                                {
+                                    _size = _heap.Size();
+                                    other._size = other._heap.Size();
+
+                                    other.Unlock();
+                                    Unlock();
+                                    throw;
+                                }
+
+                                other._size = 0;
                                 _size = _heap.Size();
 
-                                _synch.unlock();
+                                other.Unlock();
+
+                                bool wake = _waiters > 0;
+
+                                Unlock();
+
+                                if (wake)
+                                {
+                                    _available.notify_all();
+                                }
+
                                 return true;
                             }
 
@@ -154,33 +340,40 @@ namespace NutaDev
                         /// </summary>
                         void Clear()
                         {
-                            _synch.lock();
+                            Lock();
                             _heap.Clear();
-                            _synch.unlock();
+                            _size = 0;
+                            Unlock();
                         }
 
                         /// <summary>
-                        /// Splits the queue into two queues.
+                        /// Splits the queue into two queues. Whole subtrees of the heap are detached into the new queue,
+                        /// see Split of the engine heap.
                         /// </summary>
+                        /// <param name="mode">ByCount moves half of the items, Interleaved moves half of the items
+                        /// spread over the whole priority range.</param>
                         /// <returns>New queue with half of the elements.</returns>
-                        PriorityQueue<T> Split()
+                        PriorityQueue<T, TEngine, TLockStatistics> Split(Heaps::SplitMode mode = Heaps::ByCount)
                         {
-                            PriorityQueue<T> result;
+                            PriorityQueue<T, TEngine, TLockStatistics> result;
 
-                            _synch.lock();
+                            Lock();
 
-                            if (_size > 1)
+                            try
                             {
-                                for (unsigned i = 0, size = _size / 2; i < size; ++i)
-                                {
-                                    std::shared_ptr<Heaps::HeapItem<PriorityQueueItem<T>>> minItem = _heap.EraseMinimum();
-                                    _size--;
-
-                                    result.TryEnqueue(minItem->Key.Item, minItem->Key.Priority);
-                                }
+                                _heap.Split(result._heap, mode);
+                            }
+                            catch (...)
+                            {
+                                _size = _heap.Size();
+                                Unlock();
+                                throw;
                             }
 
-                            _synch.unlock();
+                            _size = _heap.Size();
+                            result._size = result._heap.Size();
+
+                            Unlock();
                             return result;
                         }
 
@@ -201,17 +394,81 @@ namespace NutaDev
                         {
                             if (Size() > 0)
                             {
-                                return _heap.Minimum();
+                                return _heap.Top().Item;
                             }
 
                             throw std::exception("You can't peek empty queue.");
                         }
 
+                        /// <summary>
+                        /// Copies up to count most urgent items in dequeue order without dequeuing them.
+                        /// The queue is not modified. Lock is held for the traversal of the engine heap, see OrderedHeapIterator:
+                        /// O(k log n) for DaryHeap, with Fibonacci or pairing engines up to O(n log n) after a bulk insert.
+                        /// </summary>
+                        /// <param name="count">Number of items.</param>
+                        /// <returns>The items with their priorities.</returns>
+                        std::vector<PriorityQueueItem<T>> PeekTopK(std::size_t count)
+                        {
+                            std::vector<PriorityQueueItem<T>> result;
+
+                            Lock();
+
+                            try
+                            {
+                                result = _heap.PeekTopK(count);
+                            }
+                            catch (...)
+                            {
+                                Unlock();
+                                throw;
+                            }
+
+                            Unlock();
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Gets lock wait and hold times, zeroed when TLockStatistics is NoLockStatistics.
+                        /// </summary>
+                        /// <returns>The counters.</returns>
+                        LockStatisticsSnapshot LockStatistics()
+                        {
+                            std::lock_guard<std::mutex> lock(_synch);
+                            return TLockStatistics::Snapshot();
+                        }
+
+                        /// <summary>
+                        /// Gets counters of structural work of the heap. Available when the engine heap provides Statistics,
+                        /// see Heaps::InstrumentedFibonacciHeapEngine.
+                        /// </summary>
+                        /// <returns>The counters.</returns>
+                        Heaps::HeapStatisticsSnapshot HeapStatistics()
+                        {
+                            std::lock_guard<std::mutex> lock(_synch);
+                            return _heap.Statistics();
+                        }
+
                         /// <summary>
                         /// Initializes a new instance of this class.
                         /// </summary>
                         PriorityQueue()
                             : _size(0)
+                            , _waiters(0)
+                            , _closed(false)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, passes the allocator to the heap, see
+                        /// Heaps::AllocatorFibonacciHeapEngine.
+                        /// </summary>
+                        /// <param name="allocator">Allocator of heap nodes.</param>
+                        template<typename TAllocator>
+                        PriorityQueue(std::allocator_arg_t, const TAllocator & allocator)
+                            : _heap(std::allocator_arg, allocator)
+                            , _size(0)
+                            , _waiters(0)
+                            , _closed(false)
                         {
                         }
 
@@ -219,9 +476,12 @@ namespace NutaDev
                         /// Initializes a new instance of this class.
                         /// </summary>
                         /// <param name="other">Another queue.</param>
-                        PriorityQueue(const PriorityQueue<T> & other)
-                            : _heap(other._heap)
+                        PriorityQueue(const PriorityQueue<T, TEngine, TLockStatistics> & other)
+                            : TLockStatistics()
+                            , _heap(other._heap)
                             , _size(other._size)
+                            , _waiters(0)
+                            , _closed(false)
                         {
 
                         }
@@ -230,9 +490,12 @@ namespace NutaDev
                         /// Initializes a new instance of this class.
                         /// </summary>
                         /// <param name="other">Another queue.</param>
-                        PriorityQueue(PriorityQueue<T> && other) noexcept
-                            : _heap(std::move(other._heap))
+                        PriorityQueue(PriorityQueue<T, TEngine, TLockStatistics> && other) noexcept
+                            : TLockStatistics()
+                            , _heap(std::move(other._heap))
                             , _size(std::move(other._size))
+                            , _waiters(0)
+                            , _closed(false)
                         {
 
                         }
@@ -242,7 +505,7 @@ namespace NutaDev
                         /// </summary>
                         /// <param name="other">Another queue.</param>
                         /// <returns>Reference to itself.</returns>
-                        PriorityQueue<T> & operator=(const PriorityQueue<T> & other)
+                        PriorityQueue<T, TEngine, TLockStatistics> & operator=(const PriorityQueue<T, TEngine, TLockStatistics> & other)
                         {
                             this->_heap = other._heap;
                             this->_size = other._size;
@@ -255,7 +518,7 @@ namespace NutaDev
                         /// </summary>
                         /// <param name="other">Another queue.</param>
                         /// <returns>Reference to itself.</returns>
-                        PriorityQueue<T> & operator=(PriorityQueue<T> && other)
+                        PriorityQueue<T, TEngine, TLockStatistics> & operator=(PriorityQueue<T, TEngine, TLockStatistics> && other)
                         {
                             if (this != &other)
                             {
@@ -274,30 +537,177 @@ namespace NutaDev
                         }
 
                     private:
+                        /// <summary>
+                        /// Predicate of waiting consumers, holds when an item is available or queue is closed.
+                        /// </summary>
+                        struct Ready
+                        {
+                            explicit Ready(const PriorityQueue<T, TEngine, TLockStatistics> * queue)
+                                : Queue(queue)
+                            {
+                            }
+
+                            bool operator()() const
+                            {
+                                return Queue->_size > 0 || Queue->_closed;
+                            }
+
+                            const PriorityQueue<T, TEngine, TLockStatistics> * Queue;
+                        };
+
                         /// <summary>
                         /// Internal structure.
                         /// </summary>
-                        Heaps::FibonacciHeap<PriorityQueueItem<T>> _heap;
+                        typename TEngine::template Heap<PriorityQueueItem<T>> _heap;
 
                         /// <summary>
                         /// Synchronization context.
                         /// </summary>
                         std::mutex _synch;
 
+                        /// <summary>
+                        /// Signalled when items are enqueued or queue is closed.
+                        /// </summary>
+                        std::condition_variable _available;
+
                         /// <summary>
                         /// Size of queue.
                         /// </summary>
                         unsigned _size;
 
                         /// <summary>
-                        /// Enqueue new element.
+                        /// Number of consumers waiting for an item.
+                        /// </summary>
+                        unsigned _waiters;
+
+                        /// <summary>
+                        /// Indicates whether queue is closed.
+                        /// </summary>
+                        bool _closed;
+
+                        /// <summary>
+                        /// Takes the lock, waits if it is taken.
+                        /// </summary>
+                        void Lock()
+                        {
+                            typename TLockStatistics::TimePoint waitStart = TLockStatistics::BeginWait();
+
+                            _synch.lock();
+
+                            TLockStatistics::OnAcquired(waitStart);
+                        }
+
+                        /// <summary>
+                        /// Tries to take the lock.
+                        /// </summary>
+                        /// <returns>True if lock has been taken.</returns>
+                        bool TryLock()
+                        {
+                            typename TLockStatistics::TimePoint waitStart = TLockStatistics::BeginWait();
+
+                            if (_synch.try_lock())
+                            {
+                                TLockStatistics::OnAcquired(waitStart);
+                                return true;
+                            }
+
+                            TLockStatistics::OnContended();
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Releases the lock.
+                        /// </summary>
+                        void Unlock()
+                        {
+                            TLockStatistics::OnReleased();
+
+                            _synch.unlock();
+                        }
+
+                        /// <summary>
+                        /// Constructs new element in place in locked queue, unlocks it and wakes up one consumer.
                         /// </summary>
-                        /// <param name="value">The value.</param>
                         /// <param name="priority">Element priority.</param>
-                        void Enqueue(T value, unsigned priority)
+                        /// <param name="args">Arguments of the element constructor.</param>
+                        /// <returns>True if item has been enqueued, false if queue is closed.</returns>
+                        template<typename... TArgs>
+                        bool EmplaceAndUnlock(unsigned priority, TArgs &&... args)
                         {
-                            _heap.Push(PriorityQueueItem<T>(value, priority));
+                            if (_closed)
+                            {
+                                Unlock();
+                                return false;
+                            }
+
+                            try
+                            {
+                                _heap.Emplace(std::piecewise_construct, priority, std::forward<TArgs>(args)...);
+                            }
+                            catch (...)
+                            {
+                                Unlock();
+                                throw;
+                            }
+
                             _size++;
+
+                            bool wake = _waiters > 0;
+
+                            Unlock();
+
+                            if (wake)
+                            {
+                                _available.notify_one();
+                            }
+
+                            return true;
+                        }
+
+                        /// <summary>
+                        /// Removes the top element of non-empty locked queue.
+                        /// </summary>
+                        /// <param name="value">Dequeued item.</param>
+                        void Take(T & value)
+                        {
+                            value = std::move(_heap.EraseMinimum().Item);
+                            _size--;
+                        }
+
+                        /// <summary>
+                        /// Waits for an item or closing of the queue and dequeues the item.
+                        /// </summary>
+                        /// <param name="value">Dequeued item.</param>
+                        /// <param name="notReady">Status returned when waiting ends without item while queue is open.</param>
+                        /// <param name="wait">Waits on the lock until the predicate holds, returns the predicate.</param>
+                        /// <returns>The status.</returns>
+                        template<typename TWait>
+                        DequeueStatus Wait(T & value, DequeueStatus notReady, TWait wait)
+                        {
+                            Lock();
+
+                            std::unique_lock<std::mutex> lock(_synch, std::adopt_lock);
+
+                            // Time spent waiting for an item is not counted as holding the lock.
+                            TLockStatistics::OnReleased();
+
+                            _waiters++;
+                            wait(lock, Ready(this));
+                            _waiters--;
+
+                            TLockStatistics::OnResumed();
+
+                            DequeueStatus status = _closed ? Closed : notReady;
+
+                            if (_size > 0)
+                            {
+                                Take(value);
+                                status = Dequeued;
+                            }
+
+                            TLockStatistics::OnReleased();
+
+                            return status;
                         }
                     };
                 }
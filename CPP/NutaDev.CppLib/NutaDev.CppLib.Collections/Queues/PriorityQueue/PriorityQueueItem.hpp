@@ -23,6 +23,9 @@
 #ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_PRIORITYQUEUEITEM_HPP
 #define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_PRIORITYQUEUEITEM_HPP
 
+#include <type_traits>
+#include <utility>
+
 namespace NutaDev
 {
     namespace CppLib
@@ -55,7 +58,7 @@ namespace NutaDev
                         /// </summary>
                         /// <param name="right">Another element.</param>
                         /// <returns>True if item is lower than another.</returns>
-                        bool operator < (const PriorityQueueItem & right)
+                        bool operator < (const PriorityQueueItem & right) const
                         {
                             return Priority < right.Priority;
                         }
@@ -65,7 +68,7 @@ namespace NutaDev
                         /// </summary>
                         /// <param name="right">Another element.</param>
                         /// <returns>True if item is greater than another.</returns>
-                        bool operator > (const PriorityQueueItem & right)
+                        bool operator > (const PriorityQueueItem & right) const
                         {
                             return Priority > right.Priority;
                         }
@@ -82,10 +85,20 @@ namespace NutaDev
                         /// <summary>
                         /// Initializes a new instance of this class.
                         /// </summary>
-                        /// <param name="item">Item to copy.</param>
+                        /// <param name="item">Item to move.</param>
                         /// <param name="priority">The priority.</param>
                         PriorityQueueItem(T item, unsigned priority)
-                            : Priority(priority), Item(item)
+                            : Priority(priority), Item(std::move(item))
+                        { }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class, constructs the item in place.
+                        /// </summary>
+                        /// <param name="priority">The priority.</param>
+                        /// <param name="args">Arguments of the item constructor.</param>
+                        template<typename... TArgs>
+                        PriorityQueueItem(std::piecewise_construct_t, unsigned priority, TArgs &&... args)
+                            : Priority(priority), Item(std::forward<TArgs>(args)...)
                         { }
 
                         /// <summary>
@@ -100,8 +113,8 @@ namespace NutaDev
                         /// Initializes a new instance of this class.
                         /// </summary>
                         /// <param name="move">Item to move.</param>
-                        PriorityQueueItem(PriorityQueueItem && move)
-                            : Priority(move.Priority), Item(move.Item)
+                        PriorityQueueItem(PriorityQueueItem && move) noexcept(std::is_nothrow_move_constructible<T>::value)
+                            : Priority(move.Priority), Item(std::move(move.Item))
                         { }
 
                         /// <summary>
@@ -119,9 +132,9 @@ namespace NutaDev
                         /// Assigns another queue.
                         /// </summary>
                         /// <returns>Reference to itself.</returns>
-                        PriorityQueueItem & operator= (PriorityQueueItem && right) noexcept
+                        PriorityQueueItem & operator= (PriorityQueueItem && right) noexcept(std::is_nothrow_move_assignable<T>::value)
                         {
-                            Item = right.Item;
+                            Item = std::move(right.Item);
                             Priority = right.Priority;
                             return *this;
                         }
@@ -0,0 +1,467 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_RADIXPRIORITYQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_RADIXPRIORITYQUEUE_HPP
+
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+#include "../../../NutaDev.CppLib.Binary/BitOperations.hpp"
+#include "../../Heaps/Storage/SlabNodeStorage.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    /// <summary>
+                    /// Radix heap for monotone priorities, e.g. timestamps. Enqueued priority can't be lower than
+                    /// the priority of the last dequeued item. Item lands in the bucket of the highest bit in which its
+                    /// priority differs from the last dequeued one, so every item is moved at most once per bit.
+                    /// Items of equal priority are dequeued in FIFO order.
+                    /// </summary>
+                    template<typename T>
+                    class RadixPriorityQueue
+                    {
+                    public:
+                        /// <summary>
+                        /// Tries to enqueue element from queue.
+                        /// </summary>
+                        /// <param name="item">Item to enqueue.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T && value, unsigned priority)
+                        {
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                Enqueue(std::move(value), priority);
+
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element from queue.
+                        /// </summary>
+                        /// <param name="item">Item to enqueue.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(T & value, unsigned priority)
+                        {
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                Enqueue(value, priority);
+
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to enqueue element from queue.
+                        /// </summary>
+                        /// <param name="item">Item to enqueue.</param>
+                        /// <returns>True if item has been enqueued.</returns>
+                        bool TryEnqueue(const T & value, unsigned priority)
+                        {
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                Enqueue(value, priority);
+
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        /// <summary>
+                        /// Tries to dequeue element from queue.
+                        /// </summary>
+                        /// <param name="item">Item to dequeue.</param>
+                        /// <returns>True if item has been dequeued.</returns>
+                        bool TryDequeue(T & value)
+                        {
+                            bool result = false;
+
+                            if (_synch.try_lock())
+                            {
+                                std::lock_guard<std::mutex> lock(_synch, std::adopt_lock);
+
+                                if (_size > 0)
+                                {
+                                    if (_buckets[0].Head == nullptr)
+                                    {
+                                        Redistribute();
+                                    }
+
+                                    RadixNode * node = Unlink(0);
+
+                                    value = std::move(node->Item);
+                                    _nodes.Destroy(node);
+
+                                    _size--;
+                                    result = true;
+                                }
+                            }
+
+                            return result;
+                        }
+
+                        /// <summary>
+                        /// Clears the collection. Priorities start again from zero.
+                        /// </summary>
+                        void Clear()
+                        {
+                            std::lock_guard<std::mutex> lock(_synch);
+
+                            Release();
+                        }
+
+                        /// <summary>
+                        /// Gets size of queue.
+                        /// </summary>
+                        /// <returns>Size of queue.</returns>
+                        unsigned Size() const noexcept
+                        {
+                            return _size;
+                        }
+
+                        /// <summary>
+                        /// Gets priority of the last dequeued item.
+                        /// </summary>
+                        /// <returns>The lowest priority that can be enqueued.</returns>
+                        unsigned LastPriority() const noexcept
+                        {
+                            return _last;
+                        }
+
+                        /// <summary>
+                        /// Peeks at top element of the queue.
+                        /// </summary>
+                        /// <returns>Top element of queue.</returns>
+                        const T & Peek() const
+                        {
+                            if (Size() > 0)
+                            {
+                                return FindMinimum(FirstBucket())->Item;
+                            }
+
+                            throw std::exception("You can't peek empty queue.");
+                        }
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        RadixPriorityQueue()
+                            : _used(0)
+                            , _last(0)
+                            , _size(0)
+                        {
+                        }
+
+                        /// <summary>
+                        /// Queue owns its nodes and can't be copied.
+                        /// </summary>
+                        RadixPriorityQueue(const RadixPriorityQueue<T> & other) = delete;
+
+                        /// <summary>
+                        /// Queue owns its nodes and can't be copied.
+                        /// </summary>
+                        RadixPriorityQueue<T> & operator=(const RadixPriorityQueue<T> & other) = delete;
+
+                        /// <summary>
+                        /// Destructs an instance of this class.
+                        /// </summary>
+                        ~RadixPriorityQueue()
+                        {
+                            Release();
+                        }
+
+                    private:
+                        /// <summary>
+                        /// Element of a bucket.
+                        /// </summary>
+                        struct RadixNode
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            /// <param name="item">The item.</param>
+                            /// <param name="priority">Item priority.</param>
+                            template<typename TValue>
+                            RadixNode(TValue && item, unsigned priority)
+                                : Item(std::forward<TValue>(item))
+                                , Priority(priority)
+                                , Next(nullptr)
+                            {
+                            }
+
+                            /// <summary>
+                            /// The item.
+                            /// </summary>
+                            T Item;
+
+                            /// <summary>
+                            /// Item priority.
+                            /// </summary>
+                            unsigned Priority;
+
+                            /// <summary>
+                            /// Next node of the bucket.
+                            /// </summary>
+                            RadixNode * Next;
+                        };
+
+                        /// <summary>
+                        /// FIFO list of nodes.
+                        /// </summary>
+                        struct Bucket
+                        {
+                            /// <summary>
+                            /// Initializes a new instance of this class.
+                            /// </summary>
+                            Bucket()
+                                : Head(nullptr)
+                                , Tail(nullptr)
+                            {
+                            }
+
+                            /// <summary>
+                            /// The oldest node.
+                            /// </summary>
+                            RadixNode * Head;
+
+                            /// <summary>
+                            /// The newest node.
+                            /// </summary>
+                            RadixNode * Tail;
+                        };
+
+                        /// <summary>
+                        /// Bucket 0 holds priorities equal to the last one, bucket i + 1 those differing at bit i.
+                        /// </summary>
+                        static const unsigned BucketCount = std::numeric_limits<unsigned>::digits + 1;
+
+                        /// <summary>
+                        /// Buckets of nodes.
+                        /// </summary>
+                        Bucket _buckets[BucketCount];
+
+                        /// <summary>
+                        /// Owner of the nodes of all buckets.
+                        /// </summary>
+                        Heaps::Storage::SlabNodeStorage<RadixNode> _nodes;
+
+                        /// <summary>
+                        /// Bit for every non-empty bucket.
+                        /// </summary>
+                        std::uint64_t _used;
+
+                        /// <summary>
+                        /// Priority of the last dequeued item.
+                        /// </summary>
+                        unsigned _last;
+
+                        /// <summary>
+                        /// Synchronization context.
+                        /// </summary>
+                        std::mutex _synch;
+
+                        /// <summary>
+                        /// Size of queue.
+                        /// </summary>
+                        unsigned _size;
+
+                        /// <summary>
+                        /// Enqueue new element.
+                        /// </summary>
+                        /// <param name="value">The value.</param>
+                        /// <param name="priority">Element priority.</param>
+                        template<typename TValue>
+                        void Enqueue(TValue && value, unsigned priority)
+                        {
+                            if (priority < _last)
+                            {
+                                throw std::exception("Priority is lower than priority of the last dequeued item.");
+                            }
+
+                            Append(_nodes.Create(std::forward<TValue>(value), priority));
+
+                            _size++;
+                        }
+
+                        /// <summary>
+                        /// Gets bucket index of the priority.
+                        /// </summary>
+                        /// <param name="priority">The priority.</param>
+                        /// <returns>Index of the bucket.</returns>
+                        unsigned BucketOf(unsigned priority) const
+                        {
+                            unsigned diff = priority ^ _last;
+
+                            return diff == 0 ? 0 : static_cast<unsigned>(Binary::highestSetBit(diff)) + 1;
+                        }
+
+                        /// <summary>
+                        /// Appends the node to the tail of its bucket.
+                        /// </summary>
+                        /// <param name="node">The node.</param>
+                        void Append(RadixNode * node)
+                        {
+                            unsigned index = BucketOf(node->Priority);
+                            Bucket & bucket = _buckets[index];
+
+                            node->Next = nullptr;
+
+                            if (bucket.Tail == nullptr)
+                            {
+                                bucket.Head = node;
+                            }
+                            else
+                            {
+                                bucket.Tail->Next = node;
+                            }
+
+                            bucket.Tail = node;
+                            _used |= std::uint64_t(1) << index;
+                        }
+
+                        /// <summary>
+                        /// Removes the oldest node of non-empty bucket.
+                        /// </summary>
+                        /// <param name="index">Index of the bucket.</param>
+                        /// <returns>The node.</returns>
+                        RadixNode * Unlink(unsigned index)
+                        {
+                            Bucket & bucket = _buckets[index];
+                            RadixNode * node = bucket.Head;
+
+                            bucket.Head = node->Next;
+
+                            if (bucket.Head == nullptr)
+                            {
+                                bucket.Tail = nullptr;
+                                _used &= ~(std::uint64_t(1) << index);
+                            }
+
+                            return node;
+                        }
+
+                        /// <summary>
+                        /// Gets index of the first non-empty bucket. Queue can't be empty.
+                        /// </summary>
+                        /// <returns>Index of the bucket.</returns>
+                        unsigned FirstBucket() const
+                        {
+                            return static_cast<unsigned>(Binary::lowestSetBit(_used));
+                        }
+
+                        /// <summary>
+                        /// Finds the oldest node with the lowest priority in non-empty bucket.
+                        /// </summary>
+                        /// <param name="index">Index of the bucket.</param>
+                        /// <returns>The node.</returns>
+                        RadixNode * FindMinimum(unsigned index) const
+                        {
+                            RadixNode * min = _buckets[index].Head;
+
+                            for (RadixNode * node = min->Next; node != nullptr; node = node->Next)
+                            {
+                                if (node->Priority < min->Priority)
+                                {
+                                    min = node;
+                                }
+                            }
+
+                            return min;
+                        }
+
+                        /// <summary>
+                        /// Moves the lowest priority to the last priority and redistributes its bucket
+                        /// into the lower buckets. Queue can't be empty.
+                        /// </summary>
+                        void Redistribute()
+                        {
+                            unsigned index = FirstBucket();
+                            RadixNode * node = _buckets[index].Head;
+
+                            _last = FindMinimum(index)->Priority;
+                            _buckets[index] = Bucket();
+                            _used &= ~(std::uint64_t(1) << index);
+
+                            // All lower buckets are empty and nodes are visited in insertion order,
+                            // so equal priorities keep their FIFO order.
+                            while (node != nullptr)
+                            {
+                                RadixNode * next = node->Next;
+                                Append(node);
+                                node = next;
+                            }
+                        }
+
+                        /// <summary>
+                        /// Destroys all nodes and resets the last priority.
+                        /// </summary>
+                        void Release()
+                        {
+                            for (unsigned i = 0; i < BucketCount; ++i)
+                            {
+                                RadixNode * node = _buckets[i].Head;
+
+                                while (node != nullptr)
+                                {
+                                    RadixNode * next = node->Next;
+                                    _nodes.Destroy(node);
+                                    node = next;
+                                }
+
+                                _buckets[i] = Bucket();
+                            }
+
+                            _used = 0;
+                            _last = 0;
+                            _size = 0;
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,94 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_SCHEDULINGSTATISTICS_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_PRIORITYQUEUE_SCHEDULINGSTATISTICS_HPP
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                namespace PriorityQueue
+                {
+                    /// <summary>
+                    /// Counters of one class of items of a scheduling queue.
+                    /// </summary>
+                    template<typename TClock>
+                    class SchedulingStatistics
+                    {
+                    public:
+                        /// <summary>
+                        /// Number of dequeued items.
+                        /// </summary>
+                        unsigned long long Dequeued;
+
+                        /// <summary>
+                        /// Number of items dequeued after their deadline.
+                        /// </summary>
+                        unsigned long long DeadlineMisses;
+
+                        /// <summary>
+                        /// The longest time an item has waited in the queue.
+                        /// </summary>
+                        typename TClock::duration MaximumWait;
+
+                        /// <summary>
+                        /// Initializes a new instance of this class.
+                        /// </summary>
+                        SchedulingStatistics()
+                            : Dequeued(0)
+                            , DeadlineMisses(0)
+                            , MaximumWait(TClock::duration::zero())
+                        {
+                        }
+
+                        /// <summary>
+                        /// Records dequeued item.
+                        /// </summary>
+                        /// <param name="wait">Time the item has waited.</param>
+                        /// <param name="missed">Whether the item missed its deadline.</param>
+                        void Record(typename TClock::duration wait, bool missed)
+                        {
+                            ++Dequeued;
+
+                            if (missed)
+                            {
+                                ++DeadlineMisses;
+                            }
+
+                            if (wait > MaximumWait)
+                            {
+                                MaximumWait = wait;
+                            }
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -23,9 +23,14 @@
 #ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_QUEUE_HPP
 #define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_QUEUE_HPP
 
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
+#include <utility>
 
 #include "../Lists/DoubleLinkedList/DoubleLinkedList.hpp"
+#include "../Lists/UnrolledList/UnrolledList.hpp"
+#include "DequeueStatus.hpp"
 
 namespace NutaDev
 {
@@ -36,9 +41,10 @@ namespace NutaDev
             namespace Queues
             {
                 /// <summary>
-                /// Queue structure.
+                /// Queue structure. TContainer stores the elements, it needs Emplace, PopFront, Get, GetSize, Splice and GetAllocator.
+                /// DoubleLinkedList allocates a node per element, UnrolledList stores elements in chunks, see ChunkedQueue.
                 /// </summary>
-                template<typename T>
+                template<typename T, typename TContainer = Lists::DoubleLinkedList::DoubleLinkedList<T>>
                 class Queue
                 {
                 public:
@@ -46,15 +52,12 @@ namespace NutaDev
                     /// Tries to enqueue element from queue.
                     /// </summary>
                     /// <param name="item">Item to enqueue.</param>
-                    /// <returns>True if item has been enqueued.</returns>
+                    /// <returns>True if item has been enqueued, false if lock is taken or queue is closed.</returns>
                     bool TryEnqueue(T && item)
                     {
                         if (_synch.try_lock())
                         {
-                            _queue.Add(item);
-
-                            _synch.unlock();
-                            return true;
+                            return EmplaceAndUnlock(std::move(item));
                         }
 
                         return false;
@@ -64,15 +67,12 @@ namespace NutaDev
                     /// Tries to enqueue element from queue.
                     /// </summary>
                     /// <param name="item">Item to enqueue.</param>
-                    /// <returns>True if item has been enqueued.</returns>
+                    /// <returns>True if item has been enqueued, false if lock is taken or queue is closed.</returns>
                     bool TryEnqueue(T & item)
                     {
                         if (_synch.try_lock())
                         {
-                            _queue.Add(item);
-
-                            _synch.unlock();
-                            return true;
+                            return EmplaceAndUnlock(item);
                         }
 
                         return false;
@@ -82,20 +82,46 @@ namespace NutaDev
                     /// Tries to enqueue element from queue.
                     /// </summary>
                     /// <param name="item">Item to enqueue.</param>
-                    /// <returns>True if item has been enqueued.</returns>
+                    /// <returns>True if item has been enqueued, false if lock is taken or queue is closed.</returns>
                     bool TryEnqueue(const T & item)
                     {
                         if (_synch.try_lock())
                         {
-                            _queue.Add(item);
+                            return EmplaceAndUnlock(item);
+                        }
 
-                            _synch.unlock();
-                            return true;
+                        return false;
+                    }
+
+                    /// <summary>
+                    /// Tries to construct element in place at the end of queue.
+                    /// </summary>
+                    /// <param name="args">Arguments of the element constructor.</param>
+                    /// <returns>True if item has been enqueued, false if lock is taken or queue is closed.</returns>
+                    template<typename... TArgs>
+                    bool TryEmplace(TArgs &&... args)
+                    {
+                        if (_synch.try_lock())
+                        {
+                            return EmplaceAndUnlock(std::forward<TArgs>(args)...);
                         }
 
                         return false;
                     }
 
+                    /// <summary>
+                    /// Constructs element in place at the end of queue, waits for the lock.
+                    /// </summary>
+                    /// <param name="args">Arguments of the element constructor.</param>
+                    /// <returns>True if item has been enqueued, false if queue is closed.</returns>
+                    template<typename... TArgs>
+                    bool Emplace(TArgs &&... args)
+                    {
+                        _synch.lock();
+
+                        return EmplaceAndUnlock(std::forward<TArgs>(args)...);
+                    }
+
                     /// <summary>
                     /// Tries to dequeue element from queue.
                     /// </summary>
@@ -109,50 +135,135 @@ namespace NutaDev
                         {
                             if (Size() > 0)
                             {
-                                std::swap(item, _queue.Get(0));
-
-                                _queue.Remove(0);
-
+                                Take(item);
                                 result = true;
                             }
 
                             _synch.unlock();
                         }
 
-                        if (Size() == 0)
+                        return result;
+                    }
+
+                    /// <summary>
+                    /// Dequeues element without waiting for an item, waits only for the lock.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    /// <returns>Dequeued, Empty or Closed when queue is closed and empty.</returns>
+                    DequeueStatus Poll(T & item)
+                    {
+                        return Wait(item, Empty, [](std::unique_lock<std::mutex> &, const Ready & ready) { return ready(); });
+                    }
+
+                    /// <summary>
+                    /// Dequeues element, waits until one is enqueued or the queue is closed.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    /// <returns>Dequeued or Closed when queue is closed and empty.</returns>
+                    DequeueStatus Dequeue(T & item)
+                    {
+                        return Wait(item, Closed, [this](std::unique_lock<std::mutex> & lock, const Ready & ready)
+                        {
+                            _available.wait(lock, ready);
+                            return true;
+                        });
+                    }
+
+                    /// <summary>
+                    /// Dequeues element, waits at most the timeout.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    /// <param name="timeout">Maximum waiting time.</param>
+                    /// <returns>Dequeued, Timeout or Closed when queue is closed and empty.</returns>
+                    template<typename TRep, typename TPeriod>
+                    DequeueStatus DequeueFor(T & item, const std::chrono::duration<TRep, TPeriod> & timeout)
+                    {
+                        return Wait(item, Timeout, [this, &timeout](std::unique_lock<std::mutex> & lock, const Ready & ready)
                         {
-                            result = false;
-                        }
+                            return _available.wait_for(lock, timeout, ready);
+                        });
+                    }
 
-                        return result;
+                    /// <summary>
+                    /// Dequeues element, waits at most until the deadline.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    /// <param name="deadline">Point in time when waiting ends.</param>
+                    /// <returns>Dequeued, Timeout or Closed when queue is closed and empty.</returns>
+                    template<typename TClock, typename TDuration>
+                    DequeueStatus DequeueUntil(T & item, const std::chrono::time_point<TClock, TDuration> & deadline)
+                    {
+                        return Wait(item, Timeout, [this, &deadline](std::unique_lock<std::mutex> & lock, const Ready & ready)
+                        {
+                            return _available.wait_until(lock, deadline, ready);
+                        });
                     }
 
                     /// <summary>
-                    /// Joins another queue into this queue.
+                    /// Closes the queue. Enqueue fails afterwards, waiting consumers are woken up and
+                    /// remaining items can still be dequeued.
                     /// </summary>
-                    /// <param name="other">Another queue to join.</param>
-                    /// <returns>True if queues have been joined.</returns>
-                    bool JoinQueue(Queue<T> & other)
+                    void Close()
                     {
-                        if (_synch.try_lock())
+                        _synch.lock();
+                        _closed = true;
+                        _synch.unlock();
+
+                        _available.notify_all();
+                    }
+
+                    /// <summary>
+                    /// Indicates whether queue is closed.
+                    /// </summary>
+                    /// <returns>True if queue is closed.</returns>
+                    bool IsClosed()
+                    {
+                        std::lock_guard<std::mutex> lock(_synch);
+                        return _closed;
+                    }
+
+                    /// <summary>
+                    /// Moves all elements of another queue to the end of this queue without copying, O(1).
+                    /// </summary>
+                    /// <param name="other">Another queue to join, empty afterwards.</param>
+                    /// <returns>True if queues have been joined, false if either lock is taken.</returns>
+                    bool JoinQueue(Queue<T, TContainer> & other)
+                    {
+                        if (&other == this || !_synch.try_lock())
                         {
-                            _queue = Lists::List<T>::JoinLists(_queue, other._queue);
+                            return false;
+                        }
 
+                        if (!other._synch.try_lock())
+                        {
                             _synch.unlock();
-                            return true;
+                            return false;
                         }
 
-                        return false;
+                        _queue.Splice(other._queue);
+
+                        other._synch.unlock();
+
+                        bool wake = _waiters > 0;
+
+                        _synch.unlock();
+
+                        if (wake)
+                        {
+                            _available.notify_all();
+                        }
+
+                        return true;
                     }
 
                     /// <summary>
                     /// Splits the queue into two queues.
                     /// </summary>
                     /// <returns>New queue with half of the elements.</returns>
-                    Queue<T> Split()
+                    Queue<T, TContainer> Split()
                     {
                         _synch.lock();
-                        Queue<T> result;
+                        Queue<T, TContainer> result(_queue.GetAllocator());
 
                         if (_queue.GetSize() > 1)
                         {
@@ -160,7 +271,7 @@ namespace NutaDev
                             size = ((size % 2 == 0) ? (size / 2) : ((size - 1) / 2));
                             for (unsigned i = 0; i < size; ++i)
                             {
-                                result.TryEnqueue(_queue.Pop(0));
+                                result.TryEnqueue(_queue.PopFront());
                             }
                         }
 
@@ -195,6 +306,19 @@ namespace NutaDev
                     /// Initializes a new instance of this class.
                     /// </summary>
                     Queue()
+                        : _waiters(0)
+                        , _closed(false)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="allocator">Allocator of the internal collection.</param>
+                    explicit Queue(const typename TContainer::allocator_type & allocator)
+                        : _queue(allocator)
+                        , _waiters(0)
+                        , _closed(false)
                     {
                     }
 
@@ -202,8 +326,10 @@ namespace NutaDev
                     /// Initializes a new instance of this class.
                     /// </summary>
                     /// <param name="other"></param>
-                    Queue(const Queue<T> & other)
+                    Queue(const Queue<T, TContainer> & other)
                         : _queue(other._queue)
+                        , _waiters(0)
+                        , _closed(false)
                     {
 
                     }
@@ -212,8 +338,10 @@ namespace NutaDev
                     /// Initializes a new instance of this class.
                     /// </summary>
                     /// <param name="other"></param>
-                    Queue(Queue<T> && other) noexcept
+                    Queue(Queue<T, TContainer> && other) noexcept
                         : _queue(std::move(other._queue))
+                        , _waiters(0)
+                        , _closed(false)
                     {
 
                     }
@@ -223,7 +351,7 @@ namespace NutaDev
                     /// </summary>
                     /// <param name="other">Other queue.</param>
                     /// <returns>Reference to itself.</returns>
-                    Queue<T> & operator=(const Queue<T> & other)
+                    Queue<T, TContainer> & operator=(const Queue<T, TContainer> & other)
                     {
                         this->_queue = other._queue;
 
@@ -235,7 +363,7 @@ namespace NutaDev
                     /// </summary>
                     /// <param name="other">Other queue.</param>
                     /// <returns>Reference to itself.</returns>
-                    Queue<T> & operator=(Queue<T> && other)
+                    Queue<T, TContainer> & operator=(Queue<T, TContainer> && other)
                     {
                         if (this != &other)
                         {
@@ -258,12 +386,122 @@ namespace NutaDev
                     /// </summary>
                     std::mutex _synch;
 
+                    /// <summary>
+                    /// Signalled when items are enqueued or queue is closed.
+                    /// </summary>
+                    std::condition_variable _available;
+
                     /// <summary>
                     /// Internal collection.
                     /// </summary>
-                    Lists::List<T> _queue;
+                    TContainer _queue;
+
+                    /// <summary>
+                    /// Number of consumers waiting for an item.
+                    /// </summary>
+                    unsigned _waiters;
 
+                    /// <summary>
+                    /// Indicates whether queue is closed.
+                    /// </summary>
+                    bool _closed;
+
+                private:
+                    /// <summary>
+                    /// Predicate of waiting consumers, holds when an item is available or queue is closed.
+                    /// </summary>
+                    struct Ready
+                    {
+                        explicit Ready(const Queue<T, TContainer> * queue)
+                            : Owner(queue)
+                        {
+                        }
+
+                        bool operator()() const
+                        {
+                            return Owner->Size() > 0 || Owner->_closed;
+                        }
+
+                        const Queue<T, TContainer> * Owner;
+                    };
+
+                    /// <summary>
+                    /// Constructs new element in place in locked queue, unlocks it and wakes up one consumer.
+                    /// </summary>
+                    /// <param name="args">Arguments of the element constructor.</param>
+                    /// <returns>True if item has been enqueued, false if queue is closed.</returns>
+                    template<typename... TArgs>
+                    bool EmplaceAndUnlock(TArgs &&... args)
+                    {
+                        if (_closed)
+                        {
+                            _synch.unlock();
+                            return false;
+                        }
+
+                        try
+                        {
+                            _queue.Emplace(std::forward<TArgs>(args)...);
+                        }
+                        catch (...)
+                        {
+                            _synch.unlock();
+                            throw;
+                        }
+
+                        bool wake = _waiters > 0;
+
+                        _synch.unlock();
+
+                        if (wake)
+                        {
+                            _available.notify_one();
+                        }
+
+                        return true;
+                    }
+
+                    /// <summary>
+                    /// Removes the first element of non-empty locked queue.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    void Take(T & item)
+                    {
+                        item = _queue.PopFront();
+                    }
+
+                    /// <summary>
+                    /// Waits for an item or closing of the queue and dequeues the item.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    /// <param name="notReady">Status returned when waiting ends without item while queue is open.</param>
+                    /// <param name="wait">Waits on the lock until the predicate holds, returns the predicate.</param>
+                    /// <returns>The status.</returns>
+                    template<typename TWait>
+                    DequeueStatus Wait(T & item, DequeueStatus notReady, TWait wait)
+                    {
+                        std::unique_lock<std::mutex> lock(_synch);
+
+                        _waiters++;
+                        wait(lock, Ready(this));
+                        _waiters--;
+
+                        if (Size() > 0)
+                        {
+                            Take(item);
+                            return Dequeued;
+                        }
+
+                        return _closed ? Closed : notReady;
+                    }
                 };
+
+                /// <summary>
+                /// Queue that stores elements in cache-line-aligned chunks of an unrolled list. Costs about one
+                /// allocation per chunk instead of one per element, best for large queues of small items.
+                /// </summary>
+                template<typename T>
+                using ChunkedQueue = Queue<T, Lists::UnrolledList::UnrolledList<T>>;
             }
         }
     }
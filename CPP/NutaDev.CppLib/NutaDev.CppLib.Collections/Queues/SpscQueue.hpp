@@ -0,0 +1,551 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_SPSCQUEUE_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_SPSCQUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../Memory/CacheLine.hpp"
+#include "DequeueStatus.hpp"
+#include "WaitStrategies.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                /// <summary>
+                /// Bounded wait-free queue for exactly one producer thread and one consumer thread, e.g. a channel
+                /// between two Threading::Thread::Task instances. Items live in a power-of-two ring, the producer owns
+                /// the tail and the consumer owns the head, each side keeps a cached copy of the other index on its
+                /// own cache line and reads the shared one only when the cached copy says the ring is full or empty.
+                /// Blocking operations wait with TWait, see Queues/WaitStrategies.hpp.
+                /// </summary>
+                template<typename T, class TWait = SpinYieldParkWait>
+                class SpscQueue
+                {
+                public:
+                    /// <summary>
+                    /// Tries to enqueue element. Producer only.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True if item has been enqueued, false if queue is full or closed.</returns>
+                    bool TryEnqueue(T && item)
+                    {
+                        return TryEmplace(std::move(item));
+                    }
+
+                    /// <summary>
+                    /// Tries to enqueue element. Producer only.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True if item has been enqueued, false if queue is full or closed.</returns>
+                    bool TryEnqueue(T & item)
+                    {
+                        return TryEmplace(item);
+                    }
+
+                    /// <summary>
+                    /// Tries to enqueue element. Producer only.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True if item has been enqueued, false if queue is full or closed.</returns>
+                    bool TryEnqueue(const T & item)
+                    {
+                        return TryEmplace(item);
+                    }
+
+                    /// <summary>
+                    /// Tries to construct element in place at the end of queue. Producer only.
+                    /// </summary>
+                    /// <param name="args">Arguments of the element constructor.</param>
+                    /// <returns>True if item has been enqueued, false if queue is full or closed.</returns>
+                    template<typename... TArgs>
+                    bool TryEmplace(TArgs &&... args)
+                    {
+                        if (IsClosed() || Free() == 0)
+                        {
+                            return false;
+                        }
+
+                        Publish(std::forward<TArgs>(args)...);
+
+                        return true;
+                    }
+
+                    /// <summary>
+                    /// Enqueues element, waits while queue is full. Producer only.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True if item has been enqueued, false if queue is closed.</returns>
+                    bool Enqueue(T && item)
+                    {
+                        return Emplace(std::move(item));
+                    }
+
+                    /// <summary>
+                    /// Enqueues element, waits while queue is full. Producer only.
+                    /// </summary>
+                    /// <param name="item">Item to enqueue.</param>
+                    /// <returns>True if item has been enqueued, false if queue is closed.</returns>
+                    bool Enqueue(const T & item)
+                    {
+                        return Emplace(item);
+                    }
+
+                    /// <summary>
+                    /// Constructs element in place at the end of queue, waits while queue is full. Producer only.
+                    /// </summary>
+                    /// <param name="args">Arguments of the element constructor.</param>
+                    /// <returns>True if item has been enqueued, false if queue is closed.</returns>
+                    template<typename... TArgs>
+                    bool Emplace(TArgs &&... args)
+                    {
+                        if (Free() == 0)
+                        {
+                            _notFull.Wait([this]() { return IsClosed() || Free() > 0; });
+                        }
+
+                        if (IsClosed())
+                        {
+                            return false;
+                        }
+
+                        Publish(std::forward<TArgs>(args)...);
+
+                        return true;
+                    }
+
+                    /// <summary>
+                    /// Enqueues as many elements of the range as fit, all of them become visible to the consumer at once. Producer only.
+                    /// </summary>
+                    /// <param name="first">Beginning of the range, elements are constructed from *first, use std::make_move_iterator to move them.</param>
+                    /// <param name="last">End of the range.</param>
+                    /// <returns>Number of enqueued elements, 0 if queue is closed.</returns>
+                    template<typename TIterator>
+                    std::size_t EnqueueMany(TIterator first, TIterator last)
+                    {
+                        if (IsClosed())
+                        {
+                            return 0;
+                        }
+
+                        std::size_t tail = _tail.load(std::memory_order_relaxed);
+                        std::size_t free = Free();
+                        std::size_t count = 0;
+
+                        try
+                        {
+                            for (; count < free && first != last; ++count, ++first)
+                            {
+                                new (Slot(tail + count)) T(*first);
+                            }
+                        }
+                        catch (...)
+                        {
+                            Commit(tail, count);
+                            throw;
+                        }
+
+                        Commit(tail, count);
+
+                        return count;
+                    }
+
+                    /// <summary>
+                    /// Tries to dequeue element from queue. Consumer only.
+                    /// </summary>
+                    /// <param name="item">Item to dequeue.</param>
+                    /// <returns>True if item has been dequeued, false if queue is empty.</returns>
+                    bool TryDequeue(T & item)
+                    {
+                        if (Available() == 0)
+                        {
+                            return false;
+                        }
+
+                        Take(item);
+
+                        return true;
+                    }
+
+                    /// <summary>
+                    /// Dequeues element, waits until one is enqueued or the queue is closed. Consumer only.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    /// <returns>Dequeued or Closed when queue is closed and empty.</returns>
+                    DequeueStatus Dequeue(T & item)
+                    {
+                        if (Available() == 0)
+                        {
+                            _notEmpty.Wait([this]() { return Available() > 0 || IsClosed(); });
+                        }
+
+                        return Finish(item, Closed);
+                    }
+
+                    /// <summary>
+                    /// Dequeues element, waits at most the timeout. Consumer only.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    /// <param name="timeout">Maximum waiting time.</param>
+                    /// <returns>Dequeued, Timeout or Closed when queue is closed and empty.</returns>
+                    template<typename TRep, typename TPeriod>
+                    DequeueStatus DequeueFor(T & item, const std::chrono::duration<TRep, TPeriod> & timeout)
+                    {
+                        if (Available() == 0)
+                        {
+                            _notEmpty.WaitUntil([this]() { return Available() > 0 || IsClosed(); }, std::chrono::steady_clock::now() + timeout);
+                        }
+
+                        return Finish(item, Timeout);
+                    }
+
+                    /// <summary>
+                    /// Dequeues up to the specified number of elements at once. Consumer only.
+                    /// </summary>
+                    /// <param name="output">Output iterator that receives dequeued elements.</param>
+                    /// <param name="maximum">Maximum number of elements to dequeue.</param>
+                    /// <returns>Number of dequeued elements.</returns>
+                    template<typename TOutputIterator>
+                    std::size_t DequeueMany(TOutputIterator output, std::size_t maximum)
+                    {
+                        std::size_t head = _head.load(std::memory_order_relaxed);
+                        std::size_t available = Available();
+                        std::size_t count = 0;
+
+                        try
+                        {
+                            for (; count < available && count < maximum; ++count)
+                            {
+                                T * stored = Slot(head + count);
+                                *output = std::move(*stored);
+                                ++output;
+                                stored->~T();
+                            }
+                        }
+                        catch (...)
+                        {
+                            Release(head, count);
+                            throw;
+                        }
+
+                        Release(head, count);
+
+                        return count;
+                    }
+
+                    /// <summary>
+                    /// Closes the queue. Enqueue fails afterwards, waiting threads are woken up and
+                    /// remaining items can still be dequeued.
+                    /// </summary>
+                    void Close()
+                    {
+                        _closed.store(true, std::memory_order_release);
+
+                        _notEmpty.Notify();
+                        _notFull.Notify();
+                    }
+
+                    /// <summary>
+                    /// Indicates whether queue is closed.
+                    /// </summary>
+                    /// <returns>True if queue is closed.</returns>
+                    bool IsClosed() const noexcept
+                    {
+                        return _closed.load(std::memory_order_acquire);
+                    }
+
+                    /// <summary>
+                    /// Gets number of elements. The value is a snapshot and may be stale when the other thread uses the queue.
+                    /// </summary>
+                    /// <returns>Size of queue.</returns>
+                    unsigned Size() const noexcept
+                    {
+                        std::size_t head = _head.load(std::memory_order_acquire);
+                        std::size_t tail = _tail.load(std::memory_order_acquire);
+
+                        return tail > head ? static_cast<unsigned>(tail - head) : 0;
+                    }
+
+                    /// <summary>
+                    /// Gets maximum number of elements.
+                    /// </summary>
+                    /// <returns>Capacity of queue.</returns>
+                    unsigned Capacity() const noexcept
+                    {
+                        return static_cast<unsigned>(_mask + 1);
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="capacity">Maximum number of elements, rounded up to a power of two.</param>
+                    explicit SpscQueue(unsigned capacity)
+                        : _mask(0)
+                        , _closed(false)
+                        , _tail(0)
+                        , _cachedHead(0)
+                        , _head(0)
+                        , _cachedTail(0)
+                    {
+                        if (capacity == 0 || capacity > (1u << 31))
+                        {
+                            throw std::exception("Capacity of SPSC queue must be between 1 and 2^31.");
+                        }
+
+                        std::size_t size = 1;
+                        while (size < capacity)
+                        {
+                            size <<= 1;
+                        }
+
+                        _items.reset(new Storage[size]);
+                        _mask = size - 1;
+                    }
+
+                    /// <summary>
+                    /// Queue is shared by its producer and consumer, it can't be copied.
+                    /// </summary>
+                    SpscQueue(const SpscQueue<T, TWait> & other) = delete;
+
+                    /// <summary>
+                    /// Queue is shared by its producer and consumer, it can't be copied.
+                    /// </summary>
+                    SpscQueue<T, TWait> & operator=(const SpscQueue<T, TWait> & other) = delete;
+
+                    /// <summary>
+                    /// Destructs instance of this class.
+                    /// </summary>
+                    virtual ~SpscQueue()
+                    {
+                        std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+                        for (std::size_t head = _head.load(std::memory_order_relaxed); head != tail; ++head)
+                        {
+                            Slot(head)->~T();
+                        }
+                    }
+
+                private:
+                    /// <summary>
+                    /// Uninitialized storage of one item.
+                    /// </summary>
+                    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+                    /// <summary>
+                    /// Gets storage of the item at specified position.
+                    /// </summary>
+                    /// <param name="position">Position of the item.</param>
+                    /// <returns>Pointer to the item.</returns>
+                    T * Slot(std::size_t position) const noexcept
+                    {
+                        return reinterpret_cast<T *>(&_items[position & _mask]);
+                    }
+
+                    /// <summary>
+                    /// Gets number of free cells, refreshes the cached head only when the cached value shows no room. Producer only.
+                    /// </summary>
+                    /// <returns>Number of free cells.</returns>
+                    std::size_t Free() noexcept
+                    {
+                        std::size_t tail = _tail.load(std::memory_order_relaxed);
+                        std::size_t free = _mask + 1 - (tail - _cachedHead);
+
+                        if (free == 0)
+                        {
+                            _cachedHead = _head.load(std::memory_order_acquire);
+                            free = _mask + 1 - (tail - _cachedHead);
+                        }
+
+                        return free;
+                    }
+
+                    /// <summary>
+                    /// Gets number of items, refreshes the cached tail only when the cached value shows none. Consumer only.
+                    /// </summary>
+                    /// <returns>Number of items.</returns>
+                    std::size_t Available() noexcept
+                    {
+                        std::size_t head = _head.load(std::memory_order_relaxed);
+                        std::size_t available = _cachedTail - head;
+
+                        if (available == 0)
+                        {
+                            _cachedTail = _tail.load(std::memory_order_acquire);
+                            available = _cachedTail - head;
+                        }
+
+                        return available;
+                    }
+
+                    /// <summary>
+                    /// Constructs the item in the free cell at the tail and publishes it. Producer only.
+                    /// </summary>
+                    /// <param name="args">Arguments of the element constructor.</param>
+                    template<typename... TArgs>
+                    void Publish(TArgs &&... args)
+                    {
+                        std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+                        new (Slot(tail)) T(std::forward<TArgs>(args)...);
+
+                        Commit(tail, 1);
+                    }
+
+                    /// <summary>
+                    /// Publishes constructed items and wakes up the consumer. Producer only.
+                    /// </summary>
+                    /// <param name="tail">Tail before the items have been constructed.</param>
+                    /// <param name="count">Number of constructed items.</param>
+                    void Commit(std::size_t tail, std::size_t count)
+                    {
+                        if (count > 0)
+                        {
+                            _tail.store(tail + count, std::memory_order_release);
+                            _notEmpty.Notify();
+                        }
+                    }
+
+                    /// <summary>
+                    /// Moves the item at the head out and releases its cell. Consumer only.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    void Take(T & item)
+                    {
+                        std::size_t head = _head.load(std::memory_order_relaxed);
+                        T * stored = Slot(head);
+
+                        item = std::move(*stored);
+                        stored->~T();
+
+                        Release(head, 1);
+                    }
+
+                    /// <summary>
+                    /// Returns cells of dequeued items to the producer and wakes it up. Consumer only.
+                    /// </summary>
+                    /// <param name="head">Head before the items have been dequeued.</param>
+                    /// <param name="count">Number of dequeued items.</param>
+                    void Release(std::size_t head, std::size_t count)
+                    {
+                        if (count > 0)
+                        {
+                            _head.store(head + count, std::memory_order_release);
+                            _notFull.Notify();
+                        }
+                    }
+
+                    /// <summary>
+                    /// Dequeues an item after waiting.
+                    /// </summary>
+                    /// <param name="item">Dequeued item.</param>
+                    /// <param name="notReady">Status returned when there is no item while queue is open.</param>
+                    /// <returns>The status.</returns>
+                    DequeueStatus Finish(T & item, DequeueStatus notReady)
+                    {
+                        if (TryDequeue(item))
+                        {
+                            return Dequeued;
+                        }
+
+                        return IsClosed() ? Closed : notReady;
+                    }
+
+                    /// <summary>
+                    /// Cells of the ring.
+                    /// </summary>
+                    std::unique_ptr<Storage[]> _items;
+
+                    /// <summary>
+                    /// Capacity - 1, maps positions to cells.
+                    /// </summary>
+                    std::size_t _mask;
+
+                    /// <summary>
+                    /// Indicates whether queue is closed.
+                    /// </summary>
+                    std::atomic<bool> _closed;
+
+                    /// <summary>
+                    /// Wakes up the producer waiting for room. Waits change only when a thread goes to sleep,
+                    /// so they stay with the read-mostly members.
+                    /// </summary>
+                    TWait _notFull;
+
+                    /// <summary>
+                    /// Wakes up the consumer waiting for items.
+                    /// </summary>
+                    TWait _notEmpty;
+
+                    /// <summary>
+                    /// Keeps producer data away from the read-mostly members.
+                    /// </summary>
+                    char _padding0[Memory::CacheLineSize];
+
+                    /// <summary>
+                    /// Position of the next enqueue, written by the producer.
+                    /// </summary>
+                    std::atomic<std::size_t> _tail;
+
+                    /// <summary>
+                    /// Last head seen by the producer.
+                    /// </summary>
+                    std::size_t _cachedHead;
+
+                    /// <summary>
+                    /// Keeps producer and consumer data on separate cache lines.
+                    /// </summary>
+                    char _padding1[Memory::CacheLineSize];
+
+                    /// <summary>
+                    /// Position of the next dequeue, written by the consumer.
+                    /// </summary>
+                    std::atomic<std::size_t> _head;
+
+                    /// <summary>
+                    /// Last tail seen by the consumer.
+                    /// </summary>
+                    std::size_t _cachedTail;
+
+                    /// <summary>
+                    /// Keeps consumer data away from whatever follows the queue.
+                    /// </summary>
+                    char _padding2[Memory::CacheLineSize];
+                };
+            }
+        }
+    }
+}
+
+#endif
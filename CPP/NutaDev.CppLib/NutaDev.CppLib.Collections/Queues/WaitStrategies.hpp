@@ -0,0 +1,248 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_COLLECTIONS_QUEUES_WAITSTRATEGIES_HPP
+#define NUTADEV_CPPLIB_COLLECTIONS_QUEUES_WAITSTRATEGIES_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Collections
+        {
+            namespace Queues
+            {
+                /// <summary>
+                /// Waits by spinning, then by yielding the processor. Never sleeps, so Notify is free,
+                /// but a waiting thread keeps its core busy. Use when the other side is expected to answer quickly.
+                /// </summary>
+                class SpinYieldWait
+                {
+                public:
+                    /// <summary>
+                    /// Waits until the predicate holds.
+                    /// </summary>
+                    /// <param name="ready">Predicate checked by the waiting thread.</param>
+                    template<typename TReady>
+                    void Wait(TReady ready)
+                    {
+                        for (unsigned i = 0; !ready(); ++i)
+                        {
+                            if (i >= SpinCount)
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                    }
+
+                    /// <summary>
+                    /// Waits until the predicate holds or the deadline passes.
+                    /// </summary>
+                    /// <param name="ready">Predicate checked by the waiting thread.</param>
+                    /// <param name="deadline">Point in time when waiting ends.</param>
+                    /// <returns>Value of the predicate.</returns>
+                    template<typename TReady, typename TClock, typename TDuration>
+                    bool WaitUntil(TReady ready, const std::chrono::time_point<TClock, TDuration> & deadline)
+                    {
+                        for (unsigned i = 0; !ready(); ++i)
+                        {
+                            if (i >= SpinCount)
+                            {
+                                if (TClock::now() >= deadline)
+                                {
+                                    return ready();
+                                }
+
+                                std::this_thread::yield();
+                            }
+                        }
+
+                        return true;
+                    }
+
+                    /// <summary>
+                    /// Wakes up the waiting thread. Has nothing to do, waiting thread never sleeps.
+                    /// </summary>
+                    void Notify() noexcept
+                    {
+                    }
+
+                    /// <summary>
+                    /// Number of predicate checks before the waiting thread starts to yield.
+                    /// </summary>
+                    static const unsigned SpinCount = 1000;
+                };
+
+                /// <summary>
+                /// Waits by spinning, then by yielding the processor and finally sleeps on a condition variable.
+                /// Notify costs a full memory fence, and a mutex round trip only when the waiting thread sleeps.
+                /// Use when the waiting thread may stay idle for long.
+                /// </summary>
+                class SpinYieldParkWait
+                {
+                public:
+                    /// <summary>
+                    /// Waits until the predicate holds.
+                    /// </summary>
+                    /// <param name="ready">Predicate checked by the waiting thread.</param>
+                    template<typename TReady>
+                    void Wait(TReady ready)
+                    {
+                        if (Spin(ready))
+                        {
+                            return;
+                        }
+
+                        std::unique_lock<std::mutex> lock(_synch);
+
+                        Park();
+                        _parked.wait(lock, ready);
+                        Unpark();
+                    }
+
+                    /// <summary>
+                    /// Waits until the predicate holds or the deadline passes.
+                    /// </summary>
+                    /// <param name="ready">Predicate checked by the waiting thread.</param>
+                    /// <param name="deadline">Point in time when waiting ends.</param>
+                    /// <returns>Value of the predicate.</returns>
+                    template<typename TReady, typename TClock, typename TDuration>
+                    bool WaitUntil(TReady ready, const std::chrono::time_point<TClock, TDuration> & deadline)
+                    {
+                        if (Spin(ready))
+                        {
+                            return true;
+                        }
+
+                        std::unique_lock<std::mutex> lock(_synch);
+
+                        Park();
+                        bool result = _parked.wait_until(lock, deadline, ready);
+                        Unpark();
+
+                        return result;
+                    }
+
+                    /// <summary>
+                    /// Wakes up the waiting thread. Must be called after the change that makes its predicate hold.
+                    /// </summary>
+                    void Notify()
+                    {
+                        // Pairs with the fence in Park, either the waiting thread sees the change or we see it sleeping.
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                        if (_sleeping.load(std::memory_order_relaxed))
+                        {
+                            _synch.lock();
+                            _synch.unlock();
+
+                            _parked.notify_all();
+                        }
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    SpinYieldParkWait()
+                        : _sleeping(false)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Number of predicate checks before the waiting thread starts to yield.
+                    /// </summary>
+                    static const unsigned SpinCount = 1000;
+
+                    /// <summary>
+                    /// Number of yields before the waiting thread goes to sleep.
+                    /// </summary>
+                    static const unsigned YieldCount = 100;
+
+                private:
+                    /// <summary>
+                    /// Spins and yields until the predicate holds or the waiting thread should go to sleep.
+                    /// </summary>
+                    /// <param name="ready">Predicate checked by the waiting thread.</param>
+                    /// <returns>Value of the predicate.</returns>
+                    template<typename TReady>
+                    static bool Spin(TReady & ready)
+                    {
+                        for (unsigned i = 0; i < SpinCount + YieldCount; ++i)
+                        {
+                            if (ready())
+                            {
+                                return true;
+                            }
+
+                            if (i >= SpinCount)
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+
+                        return false;
+                    }
+
+                    /// <summary>
+                    /// Announces that the waiting thread is going to sleep, the predicate is checked afterwards.
+                    /// </summary>
+                    void Park()
+                    {
+                        _sleeping.store(true, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                    }
+
+                    /// <summary>
+                    /// Announces that the waiting thread is awake.
+                    /// </summary>
+                    void Unpark() noexcept
+                    {
+                        _sleeping.store(false, std::memory_order_relaxed);
+                    }
+
+                    /// <summary>
+                    /// Indicates whether the waiting thread sleeps or is about to.
+                    /// </summary>
+                    std::atomic<bool> _sleeping;
+
+                    /// <summary>
+                    /// Synchronization context of sleeping.
+                    /// </summary>
+                    std::mutex _synch;
+
+                    /// <summary>
+                    /// Signalled when the waiting thread should check its predicate.
+                    /// </summary>
+                    std::condition_variable _parked;
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -22,6 +22,7 @@
 
 #include "Uuid.hpp"
 
+#include <cstdint>
 #include <string>
 #include <sstream>
 #include <iomanip>
@@ -107,15 +108,15 @@ namespace NutaDev
                             intSS = std::stringstream();
                             intSS << std::hex << std::string(buff);
 
-                            int temp;
+                            unsigned int temp;
                             intSS >> temp;
 
                             switch (i)
                             {
-                            case 0: _data1 = 0 | temp; break;
-                            case 1: _data2 = 0 | temp; break;
-                            case 2: _data3 = 0 | temp; break;
-                            case 3: _data4 = 0 | temp; break;
+                            case 0: _data1 = static_cast<int>(temp); break;
+                            case 1: _data2 = static_cast<int>(temp); break;
+                            case 2: _data3 = static_cast<int>(temp); break;
+                            case 3: _data4 = static_cast<int>(temp); break;
                             }
                         }
                     }
@@ -144,6 +145,42 @@ namespace NutaDev
                         return _data4 < right._data4;
                     }
 
+                    /// <summary>
+                    /// Indicates whether this object is equal to another one.
+                    /// </summary>
+                    /// <param name="right">Another UUID.</param>
+                    /// <returns>True if it's equal, false otherwise.</returns>
+                    bool UUID::operator ==(const UUID & right) const
+                    {
+                        return _data1 == right._data1
+                            && _data2 == right._data2
+                            && _data3 == right._data3
+                            && _data4 == right._data4;
+                    }
+
+                    /// <summary>
+                    /// Indicates whether this object is not equal to another one.
+                    /// </summary>
+                    /// <param name="right">Another UUID.</param>
+                    /// <returns>True if it's not equal, false otherwise.</returns>
+                    bool UUID::operator !=(const UUID & right) const
+                    {
+                        return !(*this == right);
+                    }
+
+                    /// <summary>
+                    /// Computes hash of the UUID.
+                    /// </summary>
+                    /// <returns>The hash.</returns>
+                    std::size_t UUID::Hash() const
+                    {
+                        std::uint64_t high = (std::uint64_t(std::uint32_t(_data1)) << 32) | std::uint32_t(_data2);
+                        std::uint64_t low = (std::uint64_t(std::uint32_t(_data3)) << 32) | std::uint32_t(_data4);
+                        std::uint64_t hash = (high ^ (low * 0x9E3779B97F4A7C15ull)) * 0xC2B2AE3D27D4EB4Full;
+
+                        return static_cast<std::size_t>(hash ^ (hash >> 32));
+                    }
+
                     /// <summary>
                     /// Converts UUID into string.
                     /// </summary>
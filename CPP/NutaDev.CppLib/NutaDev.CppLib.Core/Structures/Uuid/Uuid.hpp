@@ -23,6 +23,8 @@
 #ifndef NUTADEV_CPPLIB_CORE_STRUCTURES_UUID_UUID_HPP
 #define NUTADEV_CPPLIB_CORE_STRUCTURES_UUID_UUID_HPP
 
+#include <cstddef>
+#include <functional>
 #include <string>
 
 namespace NutaDev
@@ -73,6 +75,26 @@ namespace NutaDev
                         /// <returns>True if it's smaller, false otherwise.</returns>
                         bool operator <(const UUID & right) const;
 
+                        /// <summary>
+                        /// Indicates whether this object is equal to another one.
+                        /// </summary>
+                        /// <param name="right">Another UUID.</param>
+                        /// <returns>True if it's equal, false otherwise.</returns>
+                        bool operator ==(const UUID & right) const;
+
+                        /// <summary>
+                        /// Indicates whether this object is not equal to another one.
+                        /// </summary>
+                        /// <param name="right">Another UUID.</param>
+                        /// <returns>True if it's not equal, false otherwise.</returns>
+                        bool operator !=(const UUID & right) const;
+
+                        /// <summary>
+                        /// Computes hash of the UUID.
+                        /// </summary>
+                        /// <returns>The hash.</returns>
+                        std::size_t Hash() const;
+
                         /// <summary>
                         /// Converts UUID into string.
                         /// </summary>
@@ -106,4 +128,24 @@ namespace NutaDev
     }
 }
 
+namespace std
+{
+    /// <summary>
+    /// Hash of UUID for unordered containers.
+    /// </summary>
+    template<>
+    struct hash<NutaDev::CppLib::Core::Structures::Uuid::UUID>
+    {
+        /// <summary>
+        /// Computes hash of the UUID.
+        /// </summary>
+        /// <param name="uuid">The UUID.</param>
+        /// <returns>The hash.</returns>
+        std::size_t operator()(const NutaDev::CppLib::Core::Structures::Uuid::UUID & uuid) const
+        {
+            return uuid.Hash();
+        }
+    };
+}
+
 #endif
@@ -0,0 +1,209 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_GRAPHS_CSR_CSRGRAPH_HPP
+#define NUTADEV_CPPLIB_GRAPHS_CSR_CSRGRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <vector>
+
+#include "WeightedEdge.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Graphs
+        {
+            namespace Csr
+            {
+                /// <summary>
+                /// Immutable directed graph in compressed sparse row layout. Outgoing edges of a vertex are stored
+                /// next to each other, so relaxing a vertex reads two contiguous arrays. Edges of vertex v are
+                /// indices from EdgesBegin(v) to EdgesEnd(v).
+                /// </summary>
+                template<typename TWeight>
+                class CsrGraph
+                {
+                public:
+                    /// <summary>
+                    /// Index of a vertex.
+                    /// </summary>
+                    typedef std::uint32_t Vertex;
+
+                    /// <summary>
+                    /// Index of an edge.
+                    /// </summary>
+                    typedef std::uint32_t EdgeIndex;
+
+                    /// <summary>
+                    /// Type of edge weights.
+                    /// </summary>
+                    typedef TWeight WeightType;
+
+                    /// <summary>
+                    /// Vertex that doesn't exist, used as missing predecessor.
+                    /// </summary>
+                    static const Vertex NoVertex = std::numeric_limits<Vertex>::max();
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    CsrGraph()
+                        : _offsets(1, 0)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Initializes a new instance of this class. Edges are bucketed by source in O(V + E),
+                    /// order of edges of one vertex is kept.
+                    /// </summary>
+                    /// <param name="vertexCount">Number of vertices.</param>
+                    /// <param name="edges">Edges of the graph, weights can't be negative.</param>
+                    CsrGraph(Vertex vertexCount, const std::vector<WeightedEdge<TWeight>> & edges)
+                    {
+                        if (vertexCount == NoVertex || edges.size() >= std::numeric_limits<EdgeIndex>::max())
+                        {
+                            throw std::exception("Graph is too large.");
+                        }
+
+                        _offsets.assign(static_cast<std::size_t>(vertexCount) + 1, 0);
+                        _targets.resize(edges.size());
+                        _weights.resize(edges.size());
+
+                        for (const WeightedEdge<TWeight> & edge : edges)
+                        {
+                            if (edge.Source >= vertexCount || edge.Target >= vertexCount)
+                            {
+                                throw std::exception("Edge vertex is out of range.");
+                            }
+
+                            if (edge.Weight < TWeight())
+                            {
+                                throw std::exception("Edge weight can't be negative.");
+                            }
+
+                            ++_offsets[edge.Source + 1];
+                        }
+
+                        for (std::size_t i = 1; i < _offsets.size(); ++i)
+                        {
+                            _offsets[i] += _offsets[i - 1];
+                        }
+
+                        std::vector<EdgeIndex> next(_offsets.begin(), _offsets.end() - 1);
+
+                        for (const WeightedEdge<TWeight> & edge : edges)
+                        {
+                            EdgeIndex index = next[edge.Source]++;
+
+                            _targets[index] = edge.Target;
+                            _weights[index] = edge.Weight;
+                        }
+                    }
+
+                    /// <summary>
+                    /// Gets number of vertices.
+                    /// </summary>
+                    /// <returns>Number of vertices.</returns>
+                    Vertex VertexCount() const noexcept
+                    {
+                        return static_cast<Vertex>(_offsets.size() - 1);
+                    }
+
+                    /// <summary>
+                    /// Gets number of edges.
+                    /// </summary>
+                    /// <returns>Number of edges.</returns>
+                    EdgeIndex EdgeCount() const noexcept
+                    {
+                        return static_cast<EdgeIndex>(_targets.size());
+                    }
+
+                    /// <summary>
+                    /// Gets index of the first outgoing edge of the vertex.
+                    /// </summary>
+                    /// <param name="vertex">The vertex.</param>
+                    /// <returns>Index of the edge.</returns>
+                    EdgeIndex EdgesBegin(Vertex vertex) const
+                    {
+                        return _offsets[vertex];
+                    }
+
+                    /// <summary>
+                    /// Gets index past the last outgoing edge of the vertex.
+                    /// </summary>
+                    /// <param name="vertex">The vertex.</param>
+                    /// <returns>Index of the edge.</returns>
+                    EdgeIndex EdgesEnd(Vertex vertex) const
+                    {
+                        return _offsets[vertex + 1];
+                    }
+
+                    /// <summary>
+                    /// Gets target vertex of the edge.
+                    /// </summary>
+                    /// <param name="edge">Index of the edge.</param>
+                    /// <returns>The vertex.</returns>
+                    Vertex Target(EdgeIndex edge) const
+                    {
+                        return _targets[edge];
+                    }
+
+                    /// <summary>
+                    /// Gets weight of the edge.
+                    /// </summary>
+                    /// <param name="edge">Index of the edge.</param>
+                    /// <returns>The weight.</returns>
+                    const TWeight & Weight(EdgeIndex edge) const
+                    {
+                        return _weights[edge];
+                    }
+
+                private:
+                    /// <summary>
+                    /// Index of the first edge of each vertex, followed by number of edges.
+                    /// </summary>
+                    std::vector<EdgeIndex> _offsets;
+
+                    /// <summary>
+                    /// Target vertices of edges.
+                    /// </summary>
+                    std::vector<Vertex> _targets;
+
+                    /// <summary>
+                    /// Weights of edges.
+                    /// </summary>
+                    std::vector<TWeight> _weights;
+                };
+
+                template<typename TWeight>
+                const typename CsrGraph<TWeight>::Vertex CsrGraph<TWeight>::NoVertex;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,75 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_GRAPHS_CSR_WEIGHTEDEDGE_HPP
+#define NUTADEV_CPPLIB_GRAPHS_CSR_WEIGHTEDEDGE_HPP
+
+#include <cstdint>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Graphs
+        {
+            namespace Csr
+            {
+                /// <summary>
+                /// Directed edge used to build CsrGraph.
+                /// </summary>
+                template<typename TWeight>
+                struct WeightedEdge
+                {
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="source">Source vertex.</param>
+                    /// <param name="target">Target vertex.</param>
+                    /// <param name="weight">Weight of the edge.</param>
+                    WeightedEdge(std::uint32_t source, std::uint32_t target, TWeight weight)
+                        : Source(source)
+                        , Target(target)
+                        , Weight(weight)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Source vertex.
+                    /// </summary>
+                    std::uint32_t Source;
+
+                    /// <summary>
+                    /// Target vertex.
+                    /// </summary>
+                    std::uint32_t Target;
+
+                    /// <summary>
+                    /// Weight of the edge.
+                    /// </summary>
+                    TWeight Weight;
+                };
+            }
+        }
+    }
+}
+
+#endif
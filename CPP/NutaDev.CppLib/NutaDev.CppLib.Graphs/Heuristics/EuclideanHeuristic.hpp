@@ -0,0 +1,86 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_GRAPHS_HEURISTICS_EUCLIDEANHEURISTIC_HPP
+#define NUTADEV_CPPLIB_GRAPHS_HEURISTICS_EUCLIDEANHEURISTIC_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "NutaDev.CppLib.Math/Models/Point/Point.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Graphs
+        {
+            namespace Heuristics
+            {
+                /// <summary>
+                /// Straight line distance between coordinates of the vertices multiplied by the scale.
+                /// Consistent when no edge is shorter than scale times the straight line distance of its ends.
+                /// Integer weights are rounded down, which keeps the heuristic consistent.
+                /// </summary>
+                template<typename TWeight>
+                class EuclideanHeuristic
+                {
+                public:
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="coordinates">Coordinates of vertices, have to outlive the heuristic.</param>
+                    /// <param name="scale">Weight per unit of distance.</param>
+                    EuclideanHeuristic(const std::vector<Math::Models::Point::Point2dInt> & coordinates, double scale)
+                        : _coordinates(&coordinates)
+                        , _scale(scale)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Estimates distance between two vertices.
+                    /// </summary>
+                    /// <param name="from">The first vertex.</param>
+                    /// <param name="to">The second vertex.</param>
+                    /// <returns>Lower bound of the distance.</returns>
+                    TWeight operator()(std::uint32_t from, std::uint32_t to) const
+                    {
+                        return static_cast<TWeight>(Math::Models::Point::distanceBetweenTwoPoints((*_coordinates)[from], (*_coordinates)[to]) * _scale);
+                    }
+
+                private:
+                    /// <summary>
+                    /// Coordinates of vertices.
+                    /// </summary>
+                    const std::vector<Math::Models::Point::Point2dInt> * _coordinates;
+
+                    /// <summary>
+                    /// Weight per unit of distance.
+                    /// </summary>
+                    double _scale;
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,101 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_ASTAR_HPP
+#define NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_ASTAR_HPP
+
+#include "DecreaseKeySearch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Graphs
+        {
+            namespace ShortestPaths
+            {
+                /// <summary>
+                /// A* search with decrease-key. THeuristic is called as heuristic(vertex, target) and has to return
+                /// a consistent lower bound of the distance, see Graphs/Heuristics.
+                /// </summary>
+                template<typename TWeight, typename THeuristic, typename TEngine = Collections::Heaps::FibonacciHeapEngine>
+                class AStar
+                    : public DecreaseKeySearch<TWeight, TEngine>
+                {
+                public:
+                    typedef typename DecreaseKeySearch<TWeight, TEngine>::Graph Graph;
+                    typedef typename DecreaseKeySearch<TWeight, TEngine>::Vertex Vertex;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="graph">Searched graph, has to outlive the search.</param>
+                    /// <param name="heuristic">Lower bound of distance between two vertices.</param>
+                    AStar(const Graph & graph, const THeuristic & heuristic)
+                        : DecreaseKeySearch<TWeight, TEngine>(graph)
+                        , _heuristic(heuristic)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Finds the shortest path from the source to the target.
+                    /// </summary>
+                    /// <param name="source">The first vertex.</param>
+                    /// <param name="target">The last vertex.</param>
+                    /// <returns>True if the target is reachable.</returns>
+                    bool Run(Vertex source, Vertex target)
+                    {
+                        return this->Search(source, target, TargetBound(_heuristic, target));
+                    }
+
+                private:
+                    /// <summary>
+                    /// Heuristic bound to the target of the query.
+                    /// </summary>
+                    struct TargetBound
+                    {
+                        TargetBound(const THeuristic & heuristic, Vertex target)
+                            : Heuristic(heuristic)
+                            , Target(target)
+                        {
+                        }
+
+                        TWeight operator()(Vertex vertex) const
+                        {
+                            return Heuristic(vertex, Target);
+                        }
+
+                        const THeuristic & Heuristic;
+                        Vertex Target;
+                    };
+
+                    /// <summary>
+                    /// Lower bound of distance between two vertices.
+                    /// </summary>
+                    THeuristic _heuristic;
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,170 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_DECREASEKEYSEARCH_HPP
+#define NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_DECREASEKEYSEARCH_HPP
+
+#include <exception>
+#include <vector>
+
+#include "NutaDev.CppLib.Collections/Heaps/HeapEngines.hpp"
+
+#include "SearchLabels.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Graphs
+        {
+            namespace ShortestPaths
+            {
+                /// <summary>
+                /// Label setting search that keeps every open vertex in the heap exactly once and lowers its key
+                /// through the handle returned by Push. TEngine selects the heap, see Collections/Heaps/HeapEngines.hpp.
+                /// </summary>
+                template<typename TWeight, typename TEngine>
+                class DecreaseKeySearch
+                    : public SearchLabels<TWeight>
+                {
+                public:
+                    typedef typename SearchLabels<TWeight>::Graph Graph;
+                    typedef typename SearchLabels<TWeight>::Vertex Vertex;
+
+                protected:
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="graph">Searched graph.</param>
+                    explicit DecreaseKeySearch(const Graph & graph)
+                        : SearchLabels<TWeight>(graph)
+                        , _handles(graph.VertexCount())
+                    {
+                    }
+
+                    /// <summary>
+                    /// Settles vertices in order of distance plus heuristic until the target is settled.
+                    /// The heuristic has to be consistent, otherwise settled distances may not be the shortest.
+                    /// </summary>
+                    /// <param name="source">The first vertex.</param>
+                    /// <param name="target">Vertex that ends the search, NoVertex to settle all reachable vertices.</param>
+                    /// <param name="heuristic">Lower bound of distance from the vertex to the target.</param>
+                    /// <returns>True if the target has been reached.</returns>
+                    template<typename THeuristic>
+                    bool Search(Vertex source, Vertex target, const THeuristic & heuristic)
+                    {
+                        const Graph & graph = this->_graph;
+
+                        if (source >= graph.VertexCount() || (target != Graph::NoVertex && target >= graph.VertexCount()))
+                        {
+                            throw std::exception("Vertex is out of range.");
+                        }
+
+                        _heap.Clear();
+
+                        this->BeginQuery();
+                        this->Label(source, TWeight(), Graph::NoVertex);
+
+                        _handles[source] = _heap.Push(Entry(heuristic(source), source));
+
+                        while (!_heap.Empty())
+                        {
+                            Vertex vertex = _heap.EraseMinimum().Id;
+
+                            this->Settle(vertex);
+
+                            if (vertex == target)
+                            {
+                                break;
+                            }
+
+                            TWeight distance = this->Tentative(vertex);
+
+                            for (typename Graph::EdgeIndex edge = graph.EdgesBegin(vertex), end = graph.EdgesEnd(vertex); edge < end; ++edge)
+                            {
+                                Vertex next = graph.Target(edge);
+
+                                if (this->IsSettled(next))
+                                {
+                                    continue;
+                                }
+
+                                TWeight candidate = distance + graph.Weight(edge);
+
+                                if (!this->IsLabeled(next))
+                                {
+                                    this->Label(next, candidate, vertex);
+                                    _handles[next] = _heap.Push(Entry(candidate + heuristic(next), next));
+                                }
+                                else if (candidate < this->Tentative(next))
+                                {
+                                    this->Label(next, candidate, vertex);
+                                    _heap.DecreaseKey(_handles[next], Entry(candidate + heuristic(next), next));
+                                }
+                            }
+                        }
+
+                        return target == Graph::NoVertex || this->IsSettled(target);
+                    }
+
+                private:
+                    /// <summary>
+                    /// Open vertex with its key.
+                    /// </summary>
+                    struct Entry
+                    {
+                        Entry(const TWeight & key, Vertex id)
+                            : Key(key)
+                            , Id(id)
+                        {
+                        }
+
+                        bool operator<(const Entry & other) const
+                        {
+                            return Key < other.Key;
+                        }
+
+                        TWeight Key;
+                        Vertex Id;
+                    };
+
+                    /// <summary>
+                    /// Heap of open vertices.
+                    /// </summary>
+                    typedef typename TEngine::template Heap<Entry> Heap;
+
+                    /// <summary>
+                    /// Open vertices.
+                    /// </summary>
+                    Heap _heap;
+
+                    /// <summary>
+                    /// Handles of open vertices, valid while the vertex is labeled and not settled.
+                    /// </summary>
+                    std::vector<typename Heap::Handle> _handles;
+                };
+            }
+        }
+    }
+}
+
+#endif
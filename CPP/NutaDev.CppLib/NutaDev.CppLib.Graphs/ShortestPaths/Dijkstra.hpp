@@ -0,0 +1,94 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_DIJKSTRA_HPP
+#define NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_DIJKSTRA_HPP
+
+#include "DecreaseKeySearch.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Graphs
+        {
+            namespace ShortestPaths
+            {
+                /// <summary>
+                /// Dijkstra's algorithm with decrease-key. With the default FibonacciHeapEngine it runs
+                /// in O(E + V log V). The search object keeps its buffers, so it should be reused between queries.
+                /// </summary>
+                template<typename TWeight, typename TEngine = Collections::Heaps::FibonacciHeapEngine>
+                class Dijkstra
+                    : public DecreaseKeySearch<TWeight, TEngine>
+                {
+                public:
+                    typedef typename DecreaseKeySearch<TWeight, TEngine>::Graph Graph;
+                    typedef typename DecreaseKeySearch<TWeight, TEngine>::Vertex Vertex;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="graph">Searched graph, has to outlive the search.</param>
+                    explicit Dijkstra(const Graph & graph)
+                        : DecreaseKeySearch<TWeight, TEngine>(graph)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Finds shortest paths from the source to all reachable vertices.
+                    /// </summary>
+                    /// <param name="source">The first vertex.</param>
+                    void Run(Vertex source)
+                    {
+                        this->Search(source, Graph::NoVertex, NoHeuristic());
+                    }
+
+                    /// <summary>
+                    /// Finds the shortest path from the source to the target, stops when the target is settled.
+                    /// </summary>
+                    /// <param name="source">The first vertex.</param>
+                    /// <param name="target">The last vertex.</param>
+                    /// <returns>True if the target is reachable.</returns>
+                    bool Run(Vertex source, Vertex target)
+                    {
+                        return this->Search(source, target, NoHeuristic());
+                    }
+
+                private:
+                    /// <summary>
+                    /// Heuristic that turns the search into plain Dijkstra.
+                    /// </summary>
+                    struct NoHeuristic
+                    {
+                        TWeight operator()(Vertex) const
+                        {
+                            return TWeight();
+                        }
+                    };
+                };
+            }
+        }
+    }
+}
+
+#endif
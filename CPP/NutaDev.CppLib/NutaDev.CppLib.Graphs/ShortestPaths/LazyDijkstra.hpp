@@ -0,0 +1,181 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_LAZYDIJKSTRA_HPP
+#define NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_LAZYDIJKSTRA_HPP
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+#include "SearchLabels.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Graphs
+        {
+            namespace ShortestPaths
+            {
+                /// <summary>
+                /// Dijkstra's algorithm on a binary heap without decrease-key. Improved distance pushes
+                /// another entry and stale entries are skipped when popped, so the heap holds up to E entries.
+                /// Runs in O(E log E), baseline for Dijkstra with decrease-key.
+                /// </summary>
+                template<typename TWeight>
+                class LazyDijkstra
+                    : public SearchLabels<TWeight>
+                {
+                public:
+                    typedef typename SearchLabels<TWeight>::Graph Graph;
+                    typedef typename SearchLabels<TWeight>::Vertex Vertex;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="graph">Searched graph, has to outlive the search.</param>
+                    explicit LazyDijkstra(const Graph & graph)
+                        : SearchLabels<TWeight>(graph)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Finds shortest paths from the source to all reachable vertices.
+                    /// </summary>
+                    /// <param name="source">The first vertex.</param>
+                    void Run(Vertex source)
+                    {
+                        Search(source, Graph::NoVertex);
+                    }
+
+                    /// <summary>
+                    /// Finds the shortest path from the source to the target, stops when the target is settled.
+                    /// </summary>
+                    /// <param name="source">The first vertex.</param>
+                    /// <param name="target">The last vertex.</param>
+                    /// <returns>True if the target is reachable.</returns>
+                    bool Run(Vertex source, Vertex target)
+                    {
+                        return Search(source, target);
+                    }
+
+                private:
+                    /// <summary>
+                    /// Entry of the heap, may be stale.
+                    /// </summary>
+                    struct Entry
+                    {
+                        Entry(const TWeight & key, Vertex id)
+                            : Key(key)
+                            , Id(id)
+                        {
+                        }
+
+                        TWeight Key;
+                        Vertex Id;
+                    };
+
+                    /// <summary>
+                    /// Orders the heap so that the smallest key is on top.
+                    /// </summary>
+                    struct Later
+                    {
+                        bool operator()(const Entry & left, const Entry & right) const
+                        {
+                            return right.Key < left.Key;
+                        }
+                    };
+
+                    /// <summary>
+                    /// Binary heap of entries, kept between queries.
+                    /// </summary>
+                    std::vector<Entry> _heap;
+
+                    /// <summary>
+                    /// Settles vertices in order of distance until the target is settled.
+                    /// </summary>
+                    /// <param name="source">The first vertex.</param>
+                    /// <param name="target">Vertex that ends the search, NoVertex to settle all reachable vertices.</param>
+                    /// <returns>True if the target has been reached.</returns>
+                    bool Search(Vertex source, Vertex target)
+                    {
+                        const Graph & graph = this->_graph;
+
+                        if (source >= graph.VertexCount() || (target != Graph::NoVertex && target >= graph.VertexCount()))
+                        {
+                            throw std::exception("Vertex is out of range.");
+                        }
+
+                        _heap.clear();
+
+                        this->BeginQuery();
+                        this->Label(source, TWeight(), Graph::NoVertex);
+
+                        _heap.push_back(Entry(TWeight(), source));
+
+                        while (!_heap.empty())
+                        {
+                            std::pop_heap(_heap.begin(), _heap.end(), Later());
+
+                            Vertex vertex = _heap.back().Id;
+
+                            _heap.pop_back();
+
+                            if (this->IsSettled(vertex))
+                            {
+                                continue;
+                            }
+
+                            this->Settle(vertex);
+
+                            if (vertex == target)
+                            {
+                                break;
+                            }
+
+                            TWeight distance = this->Tentative(vertex);
+
+                            for (typename Graph::EdgeIndex edge = graph.EdgesBegin(vertex), end = graph.EdgesEnd(vertex); edge < end; ++edge)
+                            {
+                                Vertex next = graph.Target(edge);
+                                TWeight candidate = distance + graph.Weight(edge);
+
+                                if (!this->IsSettled(next) && (!this->IsLabeled(next) || candidate < this->Tentative(next)))
+                                {
+                                    this->Label(next, candidate, vertex);
+
+                                    _heap.push_back(Entry(candidate, next));
+                                    std::push_heap(_heap.begin(), _heap.end(), Later());
+                                }
+                            }
+                        }
+
+                        return target == Graph::NoVertex || this->IsSettled(target);
+                    }
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,261 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_SEARCHLABELS_HPP
+#define NUTADEV_CPPLIB_GRAPHS_SHORTESTPATHS_SEARCHLABELS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <vector>
+
+#include "../Csr/CsrGraph.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Graphs
+        {
+            namespace ShortestPaths
+            {
+                /// <summary>
+                /// Distances and predecessors found by the last query of a shortest path search.
+                /// Labels are stamped with the query number, so starting a query costs O(1) instead of O(V).
+                /// The graph has to outlive the search.
+                /// </summary>
+                template<typename TWeight>
+                class SearchLabels
+                {
+                public:
+                    /// <summary>
+                    /// Type of searched graph.
+                    /// </summary>
+                    typedef Csr::CsrGraph<TWeight> Graph;
+
+                    /// <summary>
+                    /// Index of a vertex.
+                    /// </summary>
+                    typedef typename Graph::Vertex Vertex;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="graph">Searched graph.</param>
+                    explicit SearchLabels(const Graph & graph)
+                        : _graph(graph)
+                        , _distances(graph.VertexCount())
+                        , _predecessors(graph.VertexCount(), Graph::NoVertex)
+                        , _labeled(graph.VertexCount(), 0)
+                        , _settled(graph.VertexCount(), 0)
+                        , _query(0)
+                        , _settledCount(0)
+                    {
+                    }
+
+                    /// <summary>
+                    /// Indicates whether the last query has found the shortest path to the vertex.
+                    /// </summary>
+                    /// <param name="vertex">The vertex.</param>
+                    /// <returns>True if distance of the vertex is final.</returns>
+                    bool Reached(Vertex vertex) const
+                    {
+                        return IsSettled(vertex);
+                    }
+
+                    /// <summary>
+                    /// Gets length of the shortest path to the vertex.
+                    /// </summary>
+                    /// <param name="vertex">Reached vertex.</param>
+                    /// <returns>The length.</returns>
+                    const TWeight & Distance(Vertex vertex) const
+                    {
+                        if (!Reached(vertex))
+                        {
+                            throw std::exception("Vertex hasn't been reached.");
+                        }
+
+                        return _distances[vertex];
+                    }
+
+                    /// <summary>
+                    /// Gets previous vertex on the shortest path to the vertex.
+                    /// </summary>
+                    /// <param name="vertex">Reached vertex.</param>
+                    /// <returns>The previous vertex, NoVertex for the source.</returns>
+                    Vertex Predecessor(Vertex vertex) const
+                    {
+                        if (!Reached(vertex))
+                        {
+                            throw std::exception("Vertex hasn't been reached.");
+                        }
+
+                        return _predecessors[vertex];
+                    }
+
+                    /// <summary>
+                    /// Gets vertices of the shortest path from the source to the vertex.
+                    /// </summary>
+                    /// <param name="target">The last vertex of the path.</param>
+                    /// <returns>The vertices, empty if the vertex hasn't been reached.</returns>
+                    std::vector<Vertex> Path(Vertex target) const
+                    {
+                        std::vector<Vertex> path;
+
+                        if (!Reached(target))
+                        {
+                            return path;
+                        }
+
+                        for (Vertex vertex = target; vertex != Graph::NoVertex; vertex = _predecessors[vertex])
+                        {
+                            path.push_back(vertex);
+                        }
+
+                        std::reverse(path.begin(), path.end());
+
+                        return path;
+                    }
+
+                    /// <summary>
+                    /// Gets number of vertices settled by the last query.
+                    /// </summary>
+                    /// <returns>Number of vertices.</returns>
+                    std::size_t SettledCount() const noexcept
+                    {
+                        return _settledCount;
+                    }
+
+                protected:
+                    /// <summary>
+                    /// Searched graph.
+                    /// </summary>
+                    const Graph & _graph;
+
+                    /// <summary>
+                    /// Starts a new query, labels of the previous one become invalid.
+                    /// </summary>
+                    void BeginQuery()
+                    {
+                        if (_query == std::numeric_limits<std::uint32_t>::max())
+                        {
+                            std::fill(_labeled.begin(), _labeled.end(), 0);
+                            std::fill(_settled.begin(), _settled.end(), 0);
+                            _query = 0;
+                        }
+
+                        ++_query;
+                        _settledCount = 0;
+                    }
+
+                    /// <summary>
+                    /// Indicates whether the vertex has a tentative distance in the current query.
+                    /// </summary>
+                    /// <param name="vertex">The vertex.</param>
+                    /// <returns>True if vertex has been labeled.</returns>
+                    bool IsLabeled(Vertex vertex) const
+                    {
+                        return _labeled[vertex] == _query;
+                    }
+
+                    /// <summary>
+                    /// Indicates whether the vertex has a final distance in the current query.
+                    /// </summary>
+                    /// <param name="vertex">The vertex.</param>
+                    /// <returns>True if vertex has been settled.</returns>
+                    bool IsSettled(Vertex vertex) const
+                    {
+                        return _query != 0 && _settled[vertex] == _query;
+                    }
+
+                    /// <summary>
+                    /// Gets tentative distance of labeled vertex.
+                    /// </summary>
+                    /// <param name="vertex">The vertex.</param>
+                    /// <returns>The distance.</returns>
+                    const TWeight & Tentative(Vertex vertex) const
+                    {
+                        return _distances[vertex];
+                    }
+
+                    /// <summary>
+                    /// Sets tentative distance of the vertex.
+                    /// </summary>
+                    /// <param name="vertex">The vertex.</param>
+                    /// <param name="distance">The distance.</param>
+                    /// <param name="predecessor">Previous vertex on the path.</param>
+                    void Label(Vertex vertex, const TWeight & distance, Vertex predecessor)
+                    {
+                        _labeled[vertex] = _query;
+                        _distances[vertex] = distance;
+                        _predecessors[vertex] = predecessor;
+                    }
+
+                    /// <summary>
+                    /// Marks distance of the vertex as final.
+                    /// </summary>
+                    /// <param name="vertex">The vertex.</param>
+                    void Settle(Vertex vertex)
+                    {
+                        _settled[vertex] = _query;
+                        ++_settledCount;
+                    }
+
+                private:
+                    /// <summary>
+                    /// Tentative distances.
+                    /// </summary>
+                    std::vector<TWeight> _distances;
+
+                    /// <summary>
+                    /// Previous vertices on the paths.
+                    /// </summary>
+                    std::vector<Vertex> _predecessors;
+
+                    /// <summary>
+                    /// Query that has labeled each vertex.
+                    /// </summary>
+                    std::vector<std::uint32_t> _labeled;
+
+                    /// <summary>
+                    /// Query that has settled each vertex.
+                    /// </summary>
+                    std::vector<std::uint32_t> _settled;
+
+                    /// <summary>
+                    /// Number of the current query, 0 before the first one.
+                    /// </summary>
+                    std::uint32_t _query;
+
+                    /// <summary>
+                    /// Number of vertices settled by the current query.
+                    /// </summary>
+                    std::size_t _settledCount;
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -42,7 +42,7 @@ namespace NutaDev
                     /// <param name="point1">The first point.</param>
                     /// <param name="point2">The second point.</param>
                     /// <returns>Angle between two points.</returns>
-                    inline double angleBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2)
+                    double angleBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2)
                     {
                         double deltaY = point2.Y - point1.Y;
                         double deltaX = point2.X - point1.X;
@@ -58,9 +58,23 @@ namespace NutaDev
                     /// <param name="point1">The first point.</param>
                     /// <param name="point2">The second point.</param>
                     /// <returns>Distance between two points.</returns>
-                    inline double distanceBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2)
+                    double distanceBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2)
                     {
-                        return sqrt(pow(point1.X - point2.X, 2.0) + pow(point1.Y - point2.Y, 2.0));
+                        double deltaX = static_cast<double>(point1.X) - point2.X;
+                        double deltaY = static_cast<double>(point1.Y) - point2.Y;
+
+                        return sqrt(deltaX * deltaX + deltaY * deltaY);
+                    }
+
+                    /// <summary>
+                    /// Calculates the Manhattan distance between two points, the sum of distances along both axes.
+                    /// </summary>
+                    /// <param name="point1">The first point.</param>
+                    /// <param name="point2">The second point.</param>
+                    /// <returns>Manhattan distance between two points.</returns>
+                    double manhattanDistanceBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2)
+                    {
+                        return fabs(static_cast<double>(point1.X) - point2.X) + fabs(static_cast<double>(point1.Y) - point2.Y);
                     }
                 }
             }
@@ -79,7 +79,7 @@ namespace NutaDev
                     /// <param name="point1">The first point.</param>
                     /// <param name="point2">The second point.</param>
                     /// <returns>Angle between two points.</returns>
-                    inline double angleBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2);
+                    double angleBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2);
 
                     /// <summary>
                     /// Calculates the distance between two points.
@@ -87,7 +87,15 @@ namespace NutaDev
                     /// <param name="point1">The first point.</param>
                     /// <param name="point2">The second point.</param>
                     /// <returns>Distance between two points.</returns>
-                    inline double distanceBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2);
+                    double distanceBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2);
+
+                    /// <summary>
+                    /// Calculates the Manhattan distance between two points, the sum of distances along both axes.
+                    /// </summary>
+                    /// <param name="point1">The first point.</param>
+                    /// <param name="point2">The second point.</param>
+                    /// <returns>Manhattan distance between two points.</returns>
+                    double manhattanDistanceBetweenTwoPoints(const Point2dInt & point1, const Point2dInt & point2);
                 }
             }
         }
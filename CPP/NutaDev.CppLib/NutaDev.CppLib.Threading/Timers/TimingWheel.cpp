@@ -0,0 +1,444 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "TimingWheel.hpp"
+
+#include <exception>
+#include <utility>
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Threading
+        {
+            namespace Timers
+            {
+                /// <summary>
+                /// Initializes a new instance of this class.
+                /// </summary>
+                /// <param name="resolution">Duration of a tick.</param>
+                /// <param name="executor">Executes expired timers, timers are called in order on the advancing thread if empty.</param>
+                TimingWheel::TimingWheel(Clock::duration resolution, NutaDev::CppLib::Threading::Types::TimerBatchExecutor executor)
+                    : _freeNodes(NoNode)
+                    , _tick(0)
+                    , _start(Clock::now())
+                    , _resolution(resolution)
+                    , _executor(std::move(executor))
+                    , _size(0)
+                {
+                    if (resolution <= Clock::duration::zero())
+                    {
+                        throw std::exception("Resolution must be positive.");
+                    }
+
+                    for (unsigned i = 0; i < LevelCount * SlotCount; ++i)
+                    {
+                        _slots[i] = NoNode;
+                    }
+
+                    for (unsigned i = 0; i < LevelCount; ++i)
+                    {
+                        _counts[i] = 0;
+                    }
+                }
+
+                /// <summary>
+                /// Schedules a timer.
+                /// </summary>
+                /// <param name="delay">Time after which the timer expires.</param>
+                /// <param name="callback">Function called when the timer expires.</param>
+                /// <returns>Identifier of the timer.</returns>
+                TimingWheel::TimerId TimingWheel::Schedule(Clock::duration delay, NutaDev::CppLib::Threading::Types::TimerCallback callback)
+                {
+                    return ScheduleAt(Clock::now() + delay, std::move(callback));
+                }
+
+                /// <summary>
+                /// Schedules a timer.
+                /// </summary>
+                /// <param name="due">Point in time the timer expires at, rounded up to a tick.</param>
+                /// <param name="callback">Function called when the timer expires.</param>
+                /// <returns>Identifier of the timer.</returns>
+                TimingWheel::TimerId TimingWheel::ScheduleAt(Clock::time_point due, NutaDev::CppLib::Threading::Types::TimerCallback callback)
+                {
+                    NutaDev::CppLib::Threading::Types::LockGuardMutex lock(_mutex);
+
+                    unsigned long long expiry = due > _start ? Ticks(due - _start) : 0;
+
+                    return Add(expiry, 0, std::move(callback));
+                }
+
+                /// <summary>
+                /// Schedules a timer that expires repeatedly until cancelled.
+                /// A timer that falls behind fires once per advance, missed expirations are skipped.
+                /// </summary>
+                /// <param name="period">Time between expirations, rounded up to a tick.</param>
+                /// <param name="callback">Function called when the timer expires.</param>
+                /// <returns>Identifier of the timer.</returns>
+                TimingWheel::TimerId TimingWheel::SchedulePeriodic(Clock::duration period, NutaDev::CppLib::Threading::Types::TimerCallback callback)
+                {
+                    Clock::time_point now = Clock::now();
+
+                    NutaDev::CppLib::Threading::Types::LockGuardMutex lock(_mutex);
+
+                    unsigned long long ticks = period > Clock::duration::zero() ? Ticks(period) : 1;
+
+                    return Add(Ticks(now - _start) + ticks, ticks, std::move(callback));
+                }
+
+                /// <summary>
+                /// Cancels the timer.
+                /// </summary>
+                /// <param name="timer">Identifier of the timer.</param>
+                /// <returns>True if timer has been pending.</returns>
+                bool TimingWheel::Cancel(TimerId timer)
+                {
+                    NutaDev::CppLib::Threading::Types::LockGuardMutex lock(_mutex);
+
+                    std::uint32_t node = static_cast<std::uint32_t>(timer & 0xFFFFFFFFu);
+                    std::uint32_t generation = static_cast<std::uint32_t>(timer >> 32);
+
+                    if (node >= _nodes.size()
+                        || _nodes[node].Generation != generation
+                        || _nodes[node].Slot == NoNode)
+                    {
+                        return false;
+                    }
+
+                    Unlink(node);
+                    Release(node);
+
+                    return true;
+                }
+
+                /// <summary>
+                /// Advances the wheel to the current time and executes expired timers.
+                /// </summary>
+                /// <returns>Number of expired timers.</returns>
+                std::size_t TimingWheel::Advance()
+                {
+                    return AdvanceTo(Clock::now());
+                }
+
+                /// <summary>
+                /// Advances the wheel to the point in time and executes expired timers.
+                /// </summary>
+                /// <param name="now">Current time.</param>
+                /// <returns>Number of expired timers.</returns>
+                std::size_t TimingWheel::AdvanceTo(Clock::time_point now)
+                {
+                    std::vector<NutaDev::CppLib::Threading::Types::TimerCallback> expired;
+
+                    {
+                        NutaDev::CppLib::Threading::Types::LockGuardMutex lock(_mutex);
+
+                        unsigned long long target = now > _start
+                            ? static_cast<unsigned long long>((now - _start) / _resolution)
+                            : 0;
+
+                        while (_tick < target)
+                        {
+                            if (_size == 0)
+                            {
+                                _tick = target;
+                                break;
+                            }
+
+                            unsigned empty = 0;
+
+                            while (_counts[empty] == 0)
+                            {
+                                ++empty;
+                            }
+
+                            // Nothing expires or cascades before the next tick that cascades the first non-empty level.
+                            unsigned long long idle = _tick | ((1ull << (SlotBits * empty)) - 1);
+
+                            if (idle > _tick)
+                            {
+                                _tick = idle < target ? idle : target;
+                                continue;
+                            }
+
+                            Tick(expired, target);
+                        }
+                    }
+
+                    if (!expired.empty())
+                    {
+                        if (_executor)
+                        {
+                            _executor(expired);
+                        }
+                        else
+                        {
+                            for (NutaDev::CppLib::Threading::Types::TimerCallback & callback : expired)
+                            {
+                                callback();
+                            }
+                        }
+                    }
+
+                    return expired.size();
+                }
+
+                /// <summary>
+                /// Gets number of pending timers.
+                /// </summary>
+                /// <returns>Number of pending timers.</returns>
+                std::size_t TimingWheel::Size() const
+                {
+                    NutaDev::CppLib::Threading::Types::LockGuardMutex lock(_mutex);
+
+                    return _size;
+                }
+
+                /// <summary>
+                /// Gets duration of a tick.
+                /// </summary>
+                /// <returns>Duration of a tick.</returns>
+                TimingWheel::Clock::duration TimingWheel::Resolution() const noexcept
+                {
+                    return _resolution;
+                }
+
+                /// <summary>
+                /// Adds a timer.
+                /// </summary>
+                /// <param name="expiry">Tick the timer expires at.</param>
+                /// <param name="period">Ticks between expirations.</param>
+                /// <param name="callback">Function called when the timer expires.</param>
+                /// <returns>Identifier of the timer.</returns>
+                TimingWheel::TimerId TimingWheel::Add(unsigned long long expiry, unsigned long long period, NutaDev::CppLib::Threading::Types::TimerCallback && callback)
+                {
+                    std::uint32_t node = _freeNodes;
+
+                    if (node == NoNode)
+                    {
+                        if (_nodes.size() >= NoNode)
+                        {
+                            throw std::exception("Too many timers.");
+                        }
+
+                        node = static_cast<std::uint32_t>(_nodes.size());
+
+                        TimerNode created = TimerNode();
+                        created.Generation = 1;
+                        created.Slot = NoNode;
+
+                        _nodes.push_back(std::move(created));
+                    }
+                    else
+                    {
+                        _freeNodes = _nodes[node].Next;
+                    }
+
+                    TimerNode & timer = _nodes[node];
+                    timer.Expiry = expiry > _tick ? expiry : _tick + 1;
+                    timer.Period = period;
+                    timer.Callback = std::move(callback);
+
+                    Place(node);
+                    ++_size;
+
+                    return (static_cast<TimerId>(timer.Generation) << 32) | node;
+                }
+
+                /// <summary>
+                /// Links the node to the slot of its expiry.
+                /// </summary>
+                /// <param name="node">Index of the node.</param>
+                void TimingWheel::Place(std::uint32_t node)
+                {
+                    TimerNode & timer = _nodes[node];
+
+                    unsigned long long expiry = timer.Expiry;
+                    unsigned long long delta = expiry - _tick;
+                    unsigned level = 0;
+
+                    if (delta >= (1ull << (SlotBits * LevelCount)))
+                    {
+                        expiry = _tick + (1ull << (SlotBits * LevelCount)) - 1;
+                        delta = expiry - _tick;
+                    }
+
+                    while (level + 1 < LevelCount && delta >= (1ull << (SlotBits * (level + 1))))
+                    {
+                        ++level;
+                    }
+
+                    std::uint32_t slot = level * SlotCount + static_cast<std::uint32_t>((expiry >> (SlotBits * level)) & (SlotCount - 1));
+
+                    timer.Slot = slot;
+                    timer.Prev = NoNode;
+                    timer.Next = _slots[slot];
+
+                    if (timer.Next != NoNode)
+                    {
+                        _nodes[timer.Next].Prev = node;
+                    }
+
+                    _slots[slot] = node;
+                    ++_counts[level];
+                }
+
+                /// <summary>
+                /// Unlinks the node from its slot.
+                /// </summary>
+                /// <param name="node">Index of the node.</param>
+                void TimingWheel::Unlink(std::uint32_t node)
+                {
+                    TimerNode & timer = _nodes[node];
+
+                    if (timer.Prev != NoNode)
+                    {
+                        _nodes[timer.Prev].Next = timer.Next;
+                    }
+                    else
+                    {
+                        _slots[timer.Slot] = timer.Next;
+                    }
+
+                    if (timer.Next != NoNode)
+                    {
+                        _nodes[timer.Next].Prev = timer.Prev;
+                    }
+
+                    --_counts[timer.Slot / SlotCount];
+                }
+
+                /// <summary>
+                /// Returns the node to the free list.
+                /// </summary>
+                /// <param name="node">Index of the node.</param>
+                void TimingWheel::Release(std::uint32_t node)
+                {
+                    TimerNode & timer = _nodes[node];
+
+                    timer.Callback = nullptr;
+                    timer.Slot = NoNode;
+                    timer.Next = _freeNodes;
+
+                    if (++timer.Generation == 0)
+                    {
+                        timer.Generation = 1;
+                    }
+
+                    _freeNodes = node;
+                    --_size;
+                }
+
+                /// <summary>
+                /// Places again all nodes of the current slot of the level.
+                /// </summary>
+                /// <param name="level">The level.</param>
+                void TimingWheel::Cascade(unsigned level)
+                {
+                    std::uint32_t slot = level * SlotCount + static_cast<std::uint32_t>((_tick >> (SlotBits * level)) & (SlotCount - 1));
+                    std::uint32_t node = _slots[slot];
+
+                    _slots[slot] = NoNode;
+
+                    while (node != NoNode)
+                    {
+                        std::uint32_t next = _nodes[node].Next;
+
+                        --_counts[level];
+                        Place(node);
+
+                        node = next;
+                    }
+                }
+
+                /// <summary>
+                /// Advances the wheel by one tick.
+                /// </summary>
+                /// <param name="expired">Receives callbacks of expired timers.</param>
+                /// <param name="target">Tick the wheel is being advanced to.</param>
+                void TimingWheel::Tick(std::vector<NutaDev::CppLib::Threading::Types::TimerCallback> & expired, unsigned long long target)
+                {
+                    ++_tick;
+
+                    unsigned top = 0;
+
+                    while (top + 1 < LevelCount && (_tick & ((1ull << (SlotBits * (top + 1))) - 1)) == 0)
+                    {
+                        ++top;
+                    }
+
+                    // Higher levels first, their timers may land in the current slot of a lower level.
+                    for (unsigned level = top; level > 0; --level)
+                    {
+                        Cascade(level);
+                    }
+
+                    std::uint32_t slot = static_cast<std::uint32_t>(_tick & (SlotCount - 1));
+                    std::uint32_t node = _slots[slot];
+
+                    _slots[slot] = NoNode;
+
+                    while (node != NoNode)
+                    {
+                        TimerNode & timer = _nodes[node];
+                        std::uint32_t next = timer.Next;
+
+                        --_counts[0];
+
+                        if (timer.Period > 0)
+                        {
+                            expired.push_back(timer.Callback);
+
+                            timer.Expiry += timer.Period;
+
+                            // A timer that fell behind fires once and skips the periods it missed.
+                            if (timer.Expiry <= target)
+                            {
+                                timer.Expiry += (target - timer.Expiry) / timer.Period * timer.Period + timer.Period;
+                            }
+
+                            Place(node);
+                        }
+                        else
+                        {
+                            expired.push_back(std::move(timer.Callback));
+
+                            Release(node);
+                        }
+
+                        node = next;
+                    }
+                }
+
+                /// <summary>
+                /// Converts duration to number of ticks, rounded up.
+                /// </summary>
+                /// <param name="duration">The duration.</param>
+                /// <returns>Number of ticks.</returns>
+                unsigned long long TimingWheel::Ticks(Clock::duration duration) const
+                {
+                    return static_cast<unsigned long long>((duration + _resolution - Clock::duration(1)) / _resolution);
+                }
+            }
+        }
+    }
+}
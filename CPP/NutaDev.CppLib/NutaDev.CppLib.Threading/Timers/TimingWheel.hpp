@@ -0,0 +1,296 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2022 tariel36
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef NUTADEV_CPPLIB_THREADING_TIMERS_TIMINGWHEEL_HPP
+#define NUTADEV_CPPLIB_THREADING_TIMERS_TIMINGWHEEL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "../Types/Types.hpp"
+
+namespace NutaDev
+{
+    namespace CppLib
+    {
+        namespace Threading
+        {
+            namespace Timers
+            {
+                /// <summary>
+                /// Hierarchical timing wheel. Time is split into ticks of configurable resolution, every level has 64 slots
+                /// and every slot of a level spans 64 slots of the level below. Timers are kept in intrusive lists of slots,
+                /// so schedule and cancel are O(1) and advancing the wheel by a tick costs O(1) plus the timers that expire
+                /// or cascade to a lower level. Expired timers of one advance are handed to the executor as a single batch.
+                /// Timers further than 2^30 ticks wait in the last level and are placed again until they come within range.
+                /// </summary>
+                class TimingWheel
+                {
+                public:
+                    /// <summary>
+                    /// Clock of the wheel.
+                    /// </summary>
+                    typedef std::chrono::steady_clock Clock;
+
+                    /// <summary>
+                    /// Identifier of a timer.
+                    /// </summary>
+                    typedef unsigned long long TimerId;
+
+                    /// <summary>
+                    /// Identifier that never belongs to a timer.
+                    /// </summary>
+                    static const TimerId InvalidTimer = 0;
+
+                    /// <summary>
+                    /// Initializes a new instance of this class.
+                    /// </summary>
+                    /// <param name="resolution">Duration of a tick.</param>
+                    /// <param name="executor">Executes expired timers, timers are called in order on the advancing thread if empty.</param>
+                    explicit TimingWheel(Clock::duration resolution = std::chrono::milliseconds(1),
+                        NutaDev::CppLib::Threading::Types::TimerBatchExecutor executor = NutaDev::CppLib::Threading::Types::TimerBatchExecutor());
+
+                    /// <summary>
+                    /// Schedules a timer.
+                    /// </summary>
+                    /// <param name="delay">Time after which the timer expires.</param>
+                    /// <param name="callback">Function called when the timer expires.</param>
+                    /// <returns>Identifier of the timer.</returns>
+                    TimerId Schedule(Clock::duration delay, NutaDev::CppLib::Threading::Types::TimerCallback callback);
+
+                    /// <summary>
+                    /// Schedules a timer.
+                    /// </summary>
+                    /// <param name="due">Point in time the timer expires at, rounded up to a tick.</param>
+                    /// <param name="callback">Function called when the timer expires.</param>
+                    /// <returns>Identifier of the timer.</returns>
+                    TimerId ScheduleAt(Clock::time_point due, NutaDev::CppLib::Threading::Types::TimerCallback callback);
+
+                    /// <summary>
+                    /// Schedules a timer that expires repeatedly until cancelled.
+                    /// A timer that falls behind fires once per advance, missed expirations are skipped.
+                    /// </summary>
+                    /// <param name="period">Time between expirations, rounded up to a tick.</param>
+                    /// <param name="callback">Function called when the timer expires.</param>
+                    /// <returns>Identifier of the timer.</returns>
+                    TimerId SchedulePeriodic(Clock::duration period, NutaDev::CppLib::Threading::Types::TimerCallback callback);
+
+                    /// <summary>
+                    /// Cancels the timer.
+                    /// </summary>
+                    /// <param name="timer">Identifier of the timer.</param>
+                    /// <returns>True if timer has been pending.</returns>
+                    bool Cancel(TimerId timer);
+
+                    /// <summary>
+                    /// Advances the wheel to the current time and executes expired timers.
+                    /// </summary>
+                    /// <returns>Number of expired timers.</returns>
+                    std::size_t Advance();
+
+                    /// <summary>
+                    /// Advances the wheel to the point in time and executes expired timers.
+                    /// </summary>
+                    /// <param name="now">Current time.</param>
+                    /// <returns>Number of expired timers.</returns>
+                    std::size_t AdvanceTo(Clock::time_point now);
+
+                    /// <summary>
+                    /// Gets number of pending timers.
+                    /// </summary>
+                    /// <returns>Number of pending timers.</returns>
+                    std::size_t Size() const;
+
+                    /// <summary>
+                    /// Gets duration of a tick.
+                    /// </summary>
+                    /// <returns>Duration of a tick.</returns>
+                    Clock::duration Resolution() const noexcept;
+
+                private:
+                    /// <summary>
+                    /// Number of bits of slot index.
+                    /// </summary>
+                    static const unsigned SlotBits = 6;
+
+                    /// <summary>
+                    /// Number of slots of a level.
+                    /// </summary>
+                    static const unsigned SlotCount = 1u << SlotBits;
+
+                    /// <summary>
+                    /// Number of levels.
+                    /// </summary>
+                    static const unsigned LevelCount = 5;
+
+                    /// <summary>
+                    /// Index of missing node.
+                    /// </summary>
+                    static const std::uint32_t NoNode = 0xFFFFFFFFu;
+
+                    /// <summary>
+                    /// Pending timer.
+                    /// </summary>
+                    struct TimerNode
+                    {
+                        /// <summary>
+                        /// Tick the timer expires at.
+                        /// </summary>
+                        unsigned long long Expiry;
+
+                        /// <summary>
+                        /// Ticks between expirations, zero for one shot timers.
+                        /// </summary>
+                        unsigned long long Period;
+
+                        /// <summary>
+                        /// Function called when the timer expires.
+                        /// </summary>
+                        NutaDev::CppLib::Threading::Types::TimerCallback Callback;
+
+                        /// <summary>
+                        /// Previous node of the slot.
+                        /// </summary>
+                        std::uint32_t Prev;
+
+                        /// <summary>
+                        /// Next node of the slot or of the free list.
+                        /// </summary>
+                        std::uint32_t Next;
+
+                        /// <summary>
+                        /// Slot of the node, NoNode if the node is free.
+                        /// </summary>
+                        std::uint32_t Slot;
+
+                        /// <summary>
+                        /// Incremented on release, so identifiers of released timers don't match reused nodes.
+                        /// </summary>
+                        std::uint32_t Generation;
+                    };
+
+                    /// <summary>
+                    /// All nodes, pending and free.
+                    /// </summary>
+                    std::vector<TimerNode> _nodes;
+
+                    /// <summary>
+                    /// First free node.
+                    /// </summary>
+                    std::uint32_t _freeNodes;
+
+                    /// <summary>
+                    /// First node of every slot of every level.
+                    /// </summary>
+                    std::uint32_t _slots[LevelCount * SlotCount];
+
+                    /// <summary>
+                    /// Number of nodes of every level.
+                    /// </summary>
+                    std::size_t _counts[LevelCount];
+
+                    /// <summary>
+                    /// Current tick.
+                    /// </summary>
+                    unsigned long long _tick;
+
+                    /// <summary>
+                    /// Point in time of tick zero.
+                    /// </summary>
+                    Clock::time_point _start;
+
+                    /// <summary>
+                    /// Duration of a tick.
+                    /// </summary>
+                    Clock::duration _resolution;
+
+                    /// <summary>
+                    /// Executes expired timers.
+                    /// </summary>
+                    NutaDev::CppLib::Threading::Types::TimerBatchExecutor _executor;
+
+                    /// <summary>
+                    /// Number of pending timers.
+                    /// </summary>
+                    std::size_t _size;
+
+                    /// <summary>
+                    /// Synchronization context.
+                    /// </summary>
+                    mutable std::mutex _mutex;
+
+                    /// <summary>
+                    /// Adds a timer.
+                    /// </summary>
+                    /// <param name="expiry">Tick the timer expires at.</param>
+                    /// <param name="period">Ticks between expirations.</param>
+                    /// <param name="callback">Function called when the timer expires.</param>
+                    /// <returns>Identifier of the timer.</returns>
+                    TimerId Add(unsigned long long expiry, unsigned long long period, NutaDev::CppLib::Threading::Types::TimerCallback && callback);
+
+                    /// <summary>
+                    /// Links the node to the slot of its expiry.
+                    /// </summary>
+                    /// <param name="node">Index of the node.</param>
+                    void Place(std::uint32_t node);
+
+                    /// <summary>
+                    /// Unlinks the node from its slot.
+                    /// </summary>
+                    /// <param name="node">Index of the node.</param>
+                    void Unlink(std::uint32_t node);
+
+                    /// <summary>
+                    /// Returns the node to the free list.
+                    /// </summary>
+                    /// <param name="node">Index of the node.</param>
+                    void Release(std::uint32_t node);
+
+                    /// <summary>
+                    /// Places again all nodes of the current slot of the level.
+                    /// </summary>
+                    /// <param name="level">The level.</param>
+                    void Cascade(unsigned level);
+
+                    /// <summary>
+                    /// Advances the wheel by one tick.
+                    /// </summary>
+                    /// <param name="expired">Receives callbacks of expired timers.</param>
+                    /// <param name="target">Tick the wheel is being advanced to.</param>
+                    void Tick(std::vector<NutaDev::CppLib::Threading::Types::TimerCallback> & expired, unsigned long long target);
+
+                    /// <summary>
+                    /// Converts duration to number of ticks, rounded up.
+                    /// </summary>
+                    /// <param name="duration">The duration.</param>
+                    /// <returns>Number of ticks.</returns>
+                    unsigned long long Ticks(Clock::duration duration) const;
+                };
+            }
+        }
+    }
+}
+
+#endif
@@ -26,6 +26,7 @@
 #include <thread>
 #include <mutex>
 #include <functional>
+#include <vector>
 
 namespace NutaDev
 {
@@ -45,6 +46,16 @@ namespace NutaDev
                 /// </summary>
                 typedef std::function<void(std::thread::native_handle_type)> ThreadTerminator;
 
+                /// <summary>
+                /// Delegate for function that is called when timer expires.
+                /// </summary>
+                typedef std::function<void()> TimerCallback;
+
+                /// <summary>
+                /// Delegate for function that executes a batch of expired timers.
+                /// </summary>
+                typedef std::function<void(std::vector<TimerCallback> &)> TimerBatchExecutor;
+
             }
         }
     }